@@ -92,6 +92,49 @@ extern "C"{
 #define ADXL345_BASIC_DEFAULT_FREE_FALL_THRESHOLD         0.8f                                  /**< free fall threshold 0.8g */
 #define ADXL345_BASIC_DEFAULT_FREE_FALL_TIME              10                                    /**< free fall time 10 ms */
 
+/**
+ * @brief adxl345 basic context structure definition
+ */
+typedef struct adxl345_basic_context_s
+{
+    adxl345_handle_t handle;        /**< adxl345 handle, keep it the first member */
+    void *user;                     /**< user pointer */
+} adxl345_basic_context_t;
+
+/**
+ * @brief     basic example init with a context
+ * @param[in] *ctx points to a basic context structure
+ * @param[in] interface is the chip interface
+ * @param[in] addr_pin is the iic device address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the context must be zeroed before the first init, the default interface
+ *            functions are linked unless the caller linked ctx->handle before
+ */
+uint8_t adxl345_basic_context_init(adxl345_basic_context_t *ctx, adxl345_interface_t interface, adxl345_address_t addr_pin);
+
+/**
+ * @brief     basic example deinit with a context
+ * @param[in] *ctx points to a basic context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t adxl345_basic_context_deinit(adxl345_basic_context_t *ctx);
+
+/**
+ * @brief      basic example read with a context
+ * @param[in]  *ctx points to a basic context structure
+ * @param[out] *g points to a converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t adxl345_basic_context_read(adxl345_basic_context_t *ctx, float g[3]);
+
 /**
  * @brief     basic example init
  * @param[in] interface is the chip interface
@@ -37,21 +37,20 @@
 
 #include "driver_adxl345_fifo.h"
 
-static adxl345_handle_t gs_handle;                                   /**< adxl345 handle */
+static adxl345_fifo_context_t gs_context;                            /**< adxl345 fifo context */
 static void (*a_callback)(float (*g)[3], uint16_t len) = NULL;       /**< irq callback */
-static int16_t gs_raw[32][3];                                        /**< raw data buffer */
-static float gs_data[32][3];                                         /**< data buffer */
 
 /**
- * @brief  fifo irq
- * @return status code
- *         - 0 success
- *         - 1 run failed
- * @note   none
+ * @brief     fifo irq with a context
+ * @param[in] *ctx points to a fifo context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
  */
-uint8_t adxl345_fifo_irq_handler(void)
+uint8_t adxl345_fifo_context_irq_handler(adxl345_fifo_context_t *ctx)
 {
-    if (adxl345_irq_handler(&gs_handle) != 0)
+    if (adxl345_irq_handler(&ctx->handle) != 0)
     {
         return 1;
     }
@@ -62,71 +61,81 @@ uint8_t adxl345_fifo_irq_handler(void)
 }
 
 /**
- * @brief     fifo receive callback
- * @param[in] type is the irq type
- * @note      none
+ * @brief     fifo event callback
+ * @param[in] *event points to a event structure
+ * @note      the handle is the first member of the context
  */
-static void a_adxl345_fifo_receive_callback(uint8_t type)
+static void a_adxl345_fifo_event_callback(adxl345_event_t *event)
 {
-    switch (type)
+    adxl345_fifo_context_t *ctx = (adxl345_fifo_context_t *)event->handle;
+    uint16_t len;
+    
+    if ((event->source & ((1 << ADXL345_INTERRUPT_WATERMARK) | (1 << ADXL345_INTERRUPT_OVERRUN))) == 0)
     {
-        case ADXL345_INTERRUPT_WATERMARK :
+        return;
+    }
+    
+    /* the driver has drained the fifo into the ring */
+    do
+    {
+        len = 32;
+        if (adxl345_ring_read(&ctx->handle, (int16_t (*)[3])ctx->raw, (float (*)[3])ctx->data, (uint16_t *)&len) != 0)
         {
-            uint16_t len;
+            ctx->handle.debug_print("adxl345: ring read failed.\n");
             
-            len = 32;
-            if (adxl345_read(&gs_handle, (int16_t (*)[3])gs_raw, (float (*)[3])gs_data, (uint16_t *)&len) != 0)
-            {
-                adxl345_interface_debug_print("adxl345: read failed.\n");
-                
-                return;
-            }
-            if (a_callback != NULL)
-            {
-                a_callback(gs_data, len);
-            }
-            
-            break;
+            return;
         }
-        default :
+        if ((len != 0) && (ctx->callback != NULL))
         {
-            break;
+            ctx->callback(ctx, ctx->data, len);
         }
-    }
+    } while (len == 32);
 }
 
 /**
- * @brief     fifo example init
+ * @brief     fifo example init with a context
+ * @param[in] *ctx points to a fifo context structure
  * @param[in] interface is the chip interface
  * @param[in] addr_pin is the iic device address
  * @param[in] *callback points to a irq callback address
  * @return    status code
  *            - 0 success
  *            - 1 init failed
- * @note      none
+ * @note      the context must be zeroed before the first init, the default interface
+ *            functions are linked unless the caller linked ctx->handle before
  */
-uint8_t adxl345_fifo_init(adxl345_interface_t interface, adxl345_address_t addr_pin,
-                          void (*callback)(float (*g)[3], uint16_t len))
+uint8_t adxl345_fifo_context_init(adxl345_fifo_context_t *ctx, adxl345_interface_t interface, adxl345_address_t addr_pin,
+                                  void (*callback)(adxl345_fifo_context_t *ctx, float (*g)[3], uint16_t len))
 {
     uint8_t res;
     int8_t reg;
-    
-    /* link interface function */
-    DRIVER_ADXL345_LINK_INIT(&gs_handle, adxl345_handle_t);
-    DRIVER_ADXL345_LINK_IIC_INIT(&gs_handle, adxl345_interface_iic_init);
-    DRIVER_ADXL345_LINK_IIC_DEINIT(&gs_handle, adxl345_interface_iic_deinit);
-    DRIVER_ADXL345_LINK_IIC_READ(&gs_handle, adxl345_interface_iic_read);
-    DRIVER_ADXL345_LINK_IIC_WRITE(&gs_handle, adxl345_interface_iic_write);
-    DRIVER_ADXL345_LINK_SPI_INIT(&gs_handle, adxl345_interface_spi_init);
-    DRIVER_ADXL345_LINK_SPI_DEINIT(&gs_handle, adxl345_interface_spi_deinit);
-    DRIVER_ADXL345_LINK_SPI_READ(&gs_handle, adxl345_interface_spi_read);
-    DRIVER_ADXL345_LINK_SPI_WRITE(&gs_handle, adxl345_interface_spi_write);
-    DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, adxl345_interface_delay_ms);
-    DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, adxl345_interface_debug_print);
-    DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, a_adxl345_fifo_receive_callback);
+    adxl345_config_t config;
+    
+    /* link interface function if the handle is not linked by the caller */
+    if (ctx->handle.debug_print == NULL)
+    {
+        DRIVER_ADXL345_LINK_IIC_INIT(&ctx->handle, adxl345_interface_iic_init);
+        DRIVER_ADXL345_LINK_IIC_DEINIT(&ctx->handle, adxl345_interface_iic_deinit);
+        DRIVER_ADXL345_LINK_IIC_READ(&ctx->handle, adxl345_interface_iic_read);
+        DRIVER_ADXL345_LINK_IIC_WRITE(&ctx->handle, adxl345_interface_iic_write);
+        DRIVER_ADXL345_LINK_IIC_TRANSFER(&ctx->handle, adxl345_interface_iic_transfer);
+        DRIVER_ADXL345_LINK_SPI_INIT(&ctx->handle, adxl345_interface_spi_init);
+        DRIVER_ADXL345_LINK_SPI_DEINIT(&ctx->handle, adxl345_interface_spi_deinit);
+        DRIVER_ADXL345_LINK_SPI_READ(&ctx->handle, adxl345_interface_spi_read);
+        DRIVER_ADXL345_LINK_SPI_WRITE(&ctx->handle, adxl345_interface_spi_write);
+        DRIVER_ADXL345_LINK_SPI_TRANSFER(&ctx->handle, adxl345_interface_spi_transfer);
+        DRIVER_ADXL345_LINK_DELAY_MS(&ctx->handle, adxl345_interface_delay_ms);
+        DRIVER_ADXL345_LINK_DELAY_US(&ctx->handle, adxl345_interface_delay_us);
+        DRIVER_ADXL345_LINK_TIMESTAMP_US(&ctx->handle, adxl345_interface_timestamp_us);
+        DRIVER_ADXL345_LINK_DEBUG_PRINT(&ctx->handle, adxl345_interface_debug_print);
+    }
+    DRIVER_ADXL345_LINK_EVENT_CALLBACK(&ctx->handle, a_adxl345_fifo_event_callback);
+    
+    /* set the callback before any interrupt is enabled */
+    ctx->callback = callback;
     
     /* set the interface */
-    res = adxl345_set_interface(&gs_handle, interface);
+    res = adxl345_set_interface(&ctx->handle, interface);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: set interface failed.\n");
@@ -135,7 +144,7 @@ uint8_t adxl345_fifo_init(adxl345_interface_t interface, adxl345_address_t addr_
     }
     
     /* set addr pin */
-    res = adxl345_set_addr_pin(&gs_handle, addr_pin);
+    res = adxl345_set_addr_pin(&ctx->handle, addr_pin);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: set addr pin failed.\n");
@@ -143,597 +152,270 @@ uint8_t adxl345_fifo_init(adxl345_interface_t interface, adxl345_address_t addr_
         return 1;
     }
     
-    /* adxl345 initialization */
-    res = adxl345_init(&gs_handle);
+    /* enable register cache */
+    res = adxl345_set_register_cache(&ctx->handle, ADXL345_BOOL_TRUE);
     if (res != 0)
     {
-        adxl345_interface_debug_print("adxl345: init failed.\n");
+        adxl345_interface_debug_print("adxl345: set register cache failed.\n");
        
         return 1;
     }
     
-    /* set default rate */
-    res = adxl345_set_rate(&gs_handle, ADXL345_FIFO_DEFAULT_RATE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set rate failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default spi wire */
-    res = adxl345_set_spi_wire(&gs_handle, ADXL345_FIFO_DEFAULT_SPI_WIRE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set spi wire failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set interrupt pin */
-    res = adxl345_set_interrupt_active_level(&gs_handle, ADXL345_FIFO_DEFAULT_INTERRUPT_ACTIVE_LEVEL);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set adxl345 set interrupt active level failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set full resolution */
-    res = adxl345_set_full_resolution(&gs_handle, ADXL345_FIFO_DEFAULT_FULL_RESOLUTION);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set full resolution failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set auto sleep */
-    res = adxl345_set_auto_sleep(&gs_handle, ADXL345_FIFO_DEFAULT_AUTO_SLEEP);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set auto sleep failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set sleep */
-    res = adxl345_set_sleep(&gs_handle, ADXL345_FIFO_DEFAULT_SLEEP);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set sleep failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set sleep frequency */
-    res = adxl345_set_sleep_frequency(&gs_handle, ADXL345_FIFO_DEFAULT_SLEEP_FREQUENCY);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set sleep frequency failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set justify */
-    res = adxl345_set_justify(&gs_handle, ADXL345_FIFO_DEFAULT_JUSTIFY);
+    /* adxl345 initialization */
+    res = adxl345_init(&ctx->handle);
     if (res != 0)
     {
-        adxl345_interface_debug_print("adxl345: set justify failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
+        adxl345_interface_debug_print("adxl345: init failed.\n");
+       
         return 1;
     }
     
-    /* set range */
-    res = adxl345_set_range(&gs_handle, ADXL345_FIFO_DEFAULT_RANGE);
+    /* drain the fifo into the ring */
+    res = adxl345_set_ring(&ctx->handle, &ctx->ring, ctx->frame, 64);
     if (res != 0)
     {
-        adxl345_interface_debug_print("adxl345: set range failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        adxl345_interface_debug_print("adxl345: set ring failed.\n");
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* set mode */
-    res = adxl345_set_mode(&gs_handle, ADXL345_MODE_FIFO);
+    /* read the irq frame in one burst */
+    res = adxl345_set_irq_burst(&ctx->handle, ADXL345_BOOL_TRUE);
     if (res != 0)
     {
-        adxl345_interface_debug_print("adxl345: set mode failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        adxl345_interface_debug_print("adxl345: set irq burst failed.\n");
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* set trigger pin */
-    res = adxl345_set_trigger_pin(&gs_handle, ADXL345_FIFO_DEFAULT_TRIGGER_PIN);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set trigger pin failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
+    /* fill the default config */
+    config.rate = ADXL345_FIFO_DEFAULT_RATE;
+    config.spi_wire = ADXL345_FIFO_DEFAULT_SPI_WIRE;
+    config.interrupt_active_level = ADXL345_FIFO_DEFAULT_INTERRUPT_ACTIVE_LEVEL;
+    config.self_test = ADXL345_BOOL_FALSE;
+    config.full_resolution = ADXL345_FIFO_DEFAULT_FULL_RESOLUTION;
+    config.justify = ADXL345_FIFO_DEFAULT_JUSTIFY;
+    config.range = ADXL345_FIFO_DEFAULT_RANGE;
+    config.link_activity_inactivity = ADXL345_FIFO_DEFAULT_LINK_ACTIVITY_INACTIVITY;
+    config.auto_sleep = ADXL345_FIFO_DEFAULT_AUTO_SLEEP;
+    config.measure = ADXL345_BOOL_TRUE;
+    config.sleep = ADXL345_FIFO_DEFAULT_SLEEP;
+    config.sleep_frequency = ADXL345_FIFO_DEFAULT_SLEEP_FREQUENCY;
+    config.mode = ADXL345_MODE_FIFO;
+    config.trigger_pin = ADXL345_FIFO_DEFAULT_TRIGGER_PIN;
+    config.watermark = ADXL345_FIFO_DEFAULT_WATERMARK;
+    config.tap_axis_x = ADXL345_BOOL_FALSE;
+    config.tap_axis_y = ADXL345_BOOL_FALSE;
+    config.tap_axis_z = ADXL345_BOOL_FALSE;
+    config.tap_suppress = ADXL345_FIFO_DEFAULT_TAP_SUPPRESS;
+    config.action_x = ADXL345_BOOL_FALSE;
+    config.action_y = ADXL345_BOOL_FALSE;
+    config.action_z = ADXL345_BOOL_FALSE;
+    config.inaction_x = ADXL345_BOOL_FALSE;
+    config.inaction_y = ADXL345_BOOL_FALSE;
+    config.inaction_z = ADXL345_BOOL_FALSE;
+    config.action_coupled = ADXL345_FIFO_DEFAULT_ACTION_COUPLED;
+    config.inaction_coupled = ADXL345_FIFO_DEFAULT_INACTION_COUPLED;
+    config.interrupt[ADXL345_INTERRUPT_SINGLE_TAP] = ADXL345_BOOL_FALSE;
+    config.interrupt_map[ADXL345_INTERRUPT_SINGLE_TAP] = ADXL345_FIFO_DEFAULT_INTERRUPT_SINGLE_TAP_MAP;
+    config.interrupt[ADXL345_INTERRUPT_DOUBLE_TAP] = ADXL345_BOOL_FALSE;
+    config.interrupt_map[ADXL345_INTERRUPT_DOUBLE_TAP] = ADXL345_FIFO_DEFAULT_INTERRUPT_DOUBLE_TAP_MAP;
+    config.interrupt[ADXL345_INTERRUPT_ACTIVITY] = ADXL345_BOOL_FALSE;
+    config.interrupt_map[ADXL345_INTERRUPT_ACTIVITY] = ADXL345_FIFO_DEFAULT_INTERRUPT_ACTIVITY_MAP;
+    config.interrupt[ADXL345_INTERRUPT_INACTIVITY] = ADXL345_BOOL_FALSE;
+    config.interrupt_map[ADXL345_INTERRUPT_INACTIVITY] = ADXL345_FIFO_DEFAULT_INTERRUPT_INACTIVITY_MAP;
+    config.interrupt[ADXL345_INTERRUPT_FREE_FALL] = ADXL345_BOOL_FALSE;
+    config.interrupt_map[ADXL345_INTERRUPT_FREE_FALL] = ADXL345_FIFO_DEFAULT_INTERRUPT_FREE_FALL_MAP;
+    config.interrupt[ADXL345_INTERRUPT_DATA_READY] = ADXL345_FIFO_DEFAULT_INTERRUPT_DATA_READY;
+    config.interrupt_map[ADXL345_INTERRUPT_DATA_READY] = ADXL345_FIFO_DEFAULT_INTERRUPT_DATA_READY_MAP;
+    config.interrupt[ADXL345_INTERRUPT_WATERMARK] = ADXL345_BOOL_TRUE;
+    config.interrupt_map[ADXL345_INTERRUPT_WATERMARK] = ADXL345_FIFO_DEFAULT_INTERRUPT_WATERMARK_MAP;
+    config.interrupt[ADXL345_INTERRUPT_OVERRUN] = ADXL345_BOOL_TRUE;
+    config.interrupt_map[ADXL345_INTERRUPT_OVERRUN] = ADXL345_FIFO_DEFAULT_INTERRUPT_OVERRUN_MAP;
     
-    /* set set watermark level */
-    res = adxl345_set_watermark(&gs_handle, ADXL345_FIFO_DEFAULT_WATERMARK);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set watermark failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default offset */
-    res = adxl345_offset_convert_to_register(&gs_handle, ADXL345_FIFO_DEFAULT_OFFSET, (int8_t *)&reg);
+    /* convert default offset */
+    res = adxl345_offset_convert_to_register(&ctx->handle, ADXL345_FIFO_DEFAULT_OFFSET, (int8_t *)&reg);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: offset convert to register failed.\n");
-        (void)adxl345_deinit(&gs_handle); 
-        
-        return 1;
-    }
-    res = adxl345_set_offset(&gs_handle, reg, reg, reg);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set offset failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
+    config.offset_x = reg;
+    config.offset_y = reg;
+    config.offset_z = reg;
     
-    /* set default tap threshold */
-    res = adxl345_tap_threshold_convert_to_register(&gs_handle, ADXL345_FIFO_DEFAULT_TAP_THRESHOLD, (uint8_t *)&reg);
+    /* convert default tap threshold */
+    res = adxl345_tap_threshold_convert_to_register(&ctx->handle, ADXL345_FIFO_DEFAULT_TAP_THRESHOLD, (uint8_t *)&config.tap_threshold);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: tap threshold convert to register failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_tap_threshold(&gs_handle, reg);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set tap threshold failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* set default duration */
-    res = adxl345_duration_convert_to_register(&gs_handle, ADXL345_FIFO_DEFAULT_DURATION, (uint8_t *)&reg);
+    /* convert default duration */
+    res = adxl345_duration_convert_to_register(&ctx->handle, ADXL345_FIFO_DEFAULT_DURATION, (uint8_t *)&config.duration);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: duration convert to register failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_duration(&gs_handle, reg);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set duration failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* set latent time */
-    res = adxl345_latent_convert_to_register(&gs_handle, ADXL345_FIFO_DEFAULT_LATENT, (uint8_t *)&reg);
+    /* convert latent time */
+    res = adxl345_latent_convert_to_register(&ctx->handle, ADXL345_FIFO_DEFAULT_LATENT, (uint8_t *)&config.latent);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: latent convert to register failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_latent(&gs_handle, reg);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set latent failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* set window time */
-    res = adxl345_window_convert_to_register(&gs_handle, ADXL345_FIFO_DEFAULT_WINDOW, (uint8_t *)&reg);
+    /* convert window time */
+    res = adxl345_window_convert_to_register(&ctx->handle, ADXL345_FIFO_DEFAULT_WINDOW, (uint8_t *)&config.window);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: window convert to register failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_window(&gs_handle, reg);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set window failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable tap */
-    res = adxl345_set_tap_axis(&gs_handle, ADXL345_TAP_AXIS_X, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set tap axis failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_tap_axis(&gs_handle, ADXL345_TAP_AXIS_Y, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set tap axis failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_tap_axis(&gs_handle, ADXL345_TAP_AXIS_Z, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set tap axis failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default suppress */
-    res = adxl345_set_tap_suppress(&gs_handle, ADXL345_FIFO_DEFAULT_TAP_SUPPRESS);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set tap suppress failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* set default single tap map */
-    res = adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_SINGLE_TAP, ADXL345_FIFO_DEFAULT_INTERRUPT_SINGLE_TAP_MAP);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt map failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable single tap */
-    res = adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_SINGLE_TAP, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default double tap map */
-    res = adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_DOUBLE_TAP, ADXL345_FIFO_DEFAULT_INTERRUPT_DOUBLE_TAP_MAP);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt map failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable double tap */
-    res = adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_DOUBLE_TAP, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default linking activity and inactivity */
-    res = adxl345_set_link_activity_inactivity(&gs_handle, ADXL345_FIFO_DEFAULT_LINK_ACTIVITY_INACTIVITY);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set link activity inactivity failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default action threshold */
-    res = adxl345_action_threshold_convert_to_register(&gs_handle, ADXL345_FIFO_DEFAULT_ACTION_THRESHOLD, (uint8_t *)&reg);
+    /* convert default action threshold */
+    res = adxl345_action_threshold_convert_to_register(&ctx->handle, ADXL345_FIFO_DEFAULT_ACTION_THRESHOLD, (uint8_t *)&config.action_threshold);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: action threshold convert to register failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_action_threshold(&gs_handle, reg);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set action threshold failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* set default inaction threshold */
-    res = adxl345_inaction_threshold_convert_to_register(&gs_handle, ADXL345_FIFO_DEFAULT_INACTION_THRESHOLD, (uint8_t *)&reg);
+    /* convert default inaction threshold */
+    res = adxl345_inaction_threshold_convert_to_register(&ctx->handle, ADXL345_FIFO_DEFAULT_INACTION_THRESHOLD, (uint8_t *)&config.inaction_threshold);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: inaction threshold convert to register failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_inaction_threshold(&gs_handle, reg);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set inaction threshold failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* set default inaciton time */
-    res = adxl345_inaction_time_convert_to_register(&gs_handle, ADXL345_FIFO_DEFAULT_INACTION_TIME, (uint8_t *)&reg);
+    /* convert default inaction time */
+    res = adxl345_inaction_time_convert_to_register(&ctx->handle, ADXL345_FIFO_DEFAULT_INACTION_TIME, (uint8_t *)&config.inaction_time);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: inaction time convert to register failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_inaction_time(&gs_handle, reg);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set inaction time failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable action */
-    res = adxl345_set_action_inaction(&gs_handle, ADXL345_ACTION_X, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set action inaction failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_action_inaction(&gs_handle, ADXL345_ACTION_Y, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set action inaction failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_action_inaction(&gs_handle, ADXL345_ACTION_Z, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set action inaction failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_action_inaction(&gs_handle, ADXL345_INACTION_X, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set action inaction failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_action_inaction(&gs_handle, ADXL345_INACTION_Y, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set action inaction failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_action_inaction(&gs_handle, ADXL345_INACTION_Z, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set action inaction failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default action coupled */
-    res = adxl345_set_action_coupled(&gs_handle, ADXL345_FIFO_DEFAULT_ACTION_COUPLED);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set action coupled failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default inaction coupled */
-    res = adxl345_set_inaction_coupled(&gs_handle, ADXL345_FIFO_DEFAULT_INACTION_COUPLED);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set inaction coupled failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default activity map */
-    res = adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_ACTIVITY, ADXL345_FIFO_DEFAULT_INTERRUPT_ACTIVITY_MAP);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt map failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable activity interrupt */
-    res = adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_ACTIVITY, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default inactivity map */
-    res = adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_INACTIVITY, ADXL345_FIFO_DEFAULT_INTERRUPT_INACTIVITY_MAP);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt map failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* disable inactivity interrupt */
-    res = adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_INACTIVITY, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set free fall threshold */
-    res = adxl345_free_fall_threshold_convert_to_register(&gs_handle, ADXL345_FIFO_DEFAULT_FREE_FALL_THRESHOLD, (uint8_t *)&reg);
+    /* convert free fall threshold */
+    res = adxl345_free_fall_threshold_convert_to_register(&ctx->handle, ADXL345_FIFO_DEFAULT_FREE_FALL_THRESHOLD, (uint8_t *)&config.free_fall_threshold);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: free fall threshold convert to register failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_free_fall_threshold(&gs_handle, reg);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set free fall threshold failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* set free fall time */
-    res = adxl345_free_fall_time_convert_to_register(&gs_handle, ADXL345_FIFO_DEFAULT_FREE_FALL_TIME, (uint8_t *)&reg);
+    /* convert free fall time */
+    res = adxl345_free_fall_time_convert_to_register(&ctx->handle, ADXL345_FIFO_DEFAULT_FREE_FALL_TIME, (uint8_t *)&config.free_fall_time);
     if (res != 0)
     {
         adxl345_interface_debug_print("adxl345: free fall time convert to register failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_free_fall_time(&gs_handle, reg);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set free fall time failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default free fall map */
-    res = adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_FREE_FALL, ADXL345_FIFO_DEFAULT_INTERRUPT_FREE_FALL_MAP);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt map failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* disable free fall interrupt */
-    res = adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_FREE_FALL, ADXL345_BOOL_FALSE);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default data ready map */
-    res = adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_DATA_READY, ADXL345_FIFO_DEFAULT_INTERRUPT_DATA_READY_MAP);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt map failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_DATA_READY, ADXL345_FIFO_DEFAULT_INTERRUPT_DATA_READY);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default watermark map */
-    res = adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_WATERMARK, ADXL345_FIFO_DEFAULT_INTERRUPT_WATERMARK_MAP);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interrupt map failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
-    }
-    res = adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_WATERMARK, ADXL345_BOOL_TRUE);
+    /* apply the config and start measure */
+    res = adxl345_apply_config(&ctx->handle, &config);
     if (res != 0)
     {
-        adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
-        (void)adxl345_deinit(&gs_handle);
+        adxl345_interface_debug_print("adxl345: apply config failed.\n");
+        (void)adxl345_deinit(&ctx->handle);
         
         return 1;
     }
     
-    /* set default overrun map */
-    res = adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_OVERRUN, ADXL345_FIFO_DEFAULT_INTERRUPT_OVERRUN_MAP);
-    if (res != 0)
+    return 0;
+}
+
+/**
+ * @brief     fifo example deinit with a context
+ * @param[in] *ctx points to a fifo context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t adxl345_fifo_context_deinit(adxl345_fifo_context_t *ctx)
+{
+    if (adxl345_deinit(&ctx->handle) != 0)
     {
-        adxl345_interface_debug_print("adxl345: set interrupt map failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
         return 1;
     }
-    res = adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_OVERRUN, ADXL345_BOOL_TRUE);
-    if (res != 0)
+    else
     {
-        adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
+        return 0;
     }
+}
+
+/**
+ * @brief     fifo singleton callback
+ * @param[in] *ctx points to a fifo context structure
+ * @param[in] **g points to a converted data buffer
+ * @param[in] len is the data length
+ * @note      none
+ */
+static void a_adxl345_fifo_callback(adxl345_fifo_context_t *ctx, float (*g)[3], uint16_t len)
+{
+    (void)ctx;
     
-    /* start measure */
-    res = adxl345_set_measure(&gs_handle, ADXL345_BOOL_TRUE);
-    if (res != 0)
+    if (a_callback != NULL)
     {
-        adxl345_interface_debug_print("adxl345: set measure failed.\n");
-        (void)adxl345_deinit(&gs_handle);
-        
-        return 1;
+        a_callback(g, len);
     }
+}
+
+/**
+ * @brief  fifo irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+uint8_t adxl345_fifo_irq_handler(void)
+{
+    return adxl345_fifo_context_irq_handler(&gs_context);
+}
+
+/**
+ * @brief     fifo example init
+ * @param[in] interface is the chip interface
+ * @param[in] addr_pin is the iic device address
+ * @param[in] *callback points to a irq callback address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t adxl345_fifo_init(adxl345_interface_t interface, adxl345_address_t addr_pin,
+                          void (*callback)(float (*g)[3], uint16_t len))
+{
     a_callback = callback;
     
-    return 0;
+    return adxl345_fifo_context_init(&gs_context, interface, addr_pin, a_adxl345_fifo_callback);
 }
 
 /**
@@ -745,13 +427,5 @@ uint8_t adxl345_fifo_init(adxl345_interface_t interface, adxl345_address_t addr_
  */
 uint8_t adxl345_fifo_deinit(void)
 {
-    if (adxl345_deinit(&gs_handle) != 0)
-    {
-        return 1;
-    }
-    else
-    {
-        return 0;
-    }
+    return adxl345_fifo_context_deinit(&gs_context);
 }
-
@@ -87,6 +87,55 @@ extern "C"{
 #define ADXL345_FIFO_DEFAULT_FREE_FALL_THRESHOLD         0.8f                                  /**< free fall threshold 0.8g */
 #define ADXL345_FIFO_DEFAULT_FREE_FALL_TIME              10                                    /**< free fall time 10 ms */
 
+/**
+ * @brief adxl345 fifo context structure definition
+ */
+typedef struct adxl345_fifo_context_s
+{
+    adxl345_handle_t handle;                                                                 /**< adxl345 handle, keep it the first member */
+    int16_t raw[32][3];                                                                      /**< raw data buffer */
+    float data[32][3];                                                                       /**< data buffer */
+    uint8_t frame[64][6];                                                                    /**< drain ring storage */
+    adxl345_ring_t ring;                                                                     /**< drain ring */
+    void (*callback)(struct adxl345_fifo_context_s *ctx, float (*g)[3], uint16_t len);      /**< irq callback */
+    void *user;                                                                              /**< user pointer */
+} adxl345_fifo_context_t;
+
+/**
+ * @brief     fifo irq with a context
+ * @param[in] *ctx points to a fifo context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+uint8_t adxl345_fifo_context_irq_handler(adxl345_fifo_context_t *ctx);
+
+/**
+ * @brief     fifo example init with a context
+ * @param[in] *ctx points to a fifo context structure
+ * @param[in] interface is the chip interface
+ * @param[in] addr_pin is the iic device address
+ * @param[in] *callback points to a irq callback address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the context must be zeroed before the first init, the default interface
+ *            functions are linked unless the caller linked ctx->handle before
+ */
+uint8_t adxl345_fifo_context_init(adxl345_fifo_context_t *ctx, adxl345_interface_t interface, adxl345_address_t addr_pin,
+                                  void (*callback)(adxl345_fifo_context_t *ctx, float (*g)[3], uint16_t len));
+
+/**
+ * @brief     fifo example deinit with a context
+ * @param[in] *ctx points to a fifo context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t adxl345_fifo_context_deinit(adxl345_fifo_context_t *ctx);
+
 /**
  * @brief  fifo irq
  * @return status code
@@ -90,6 +90,67 @@ extern "C"{
 #define ADXL345_INTERRUPT_DEFAULT_FREE_FALL_THRESHOLD         0.8f                                  /**< free fall threshold 0.8g */
 #define ADXL345_INTERRUPT_DEFAULT_FREE_FALL_TIME              10                                    /**< free fall time 10 ms */
 
+/**
+ * @brief adxl345 interrupt context structure definition
+ */
+typedef struct adxl345_interrupt_context_s
+{
+    adxl345_handle_t handle;                                                      /**< adxl345 handle, keep it the first member */
+    void (*callback)(struct adxl345_interrupt_context_s *ctx, uint8_t type);      /**< irq callback */
+    void *user;                                                                   /**< user pointer */
+} adxl345_interrupt_context_t;
+
+/**
+ * @brief     interrupt irq with a context
+ * @param[in] *ctx points to a interrupt context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+uint8_t adxl345_interrupt_context_irq_handler(adxl345_interrupt_context_t *ctx);
+
+/**
+ * @brief     interrupt example init with a context
+ * @param[in] *ctx points to a interrupt context structure
+ * @param[in] interface is the chip interface
+ * @param[in] addr_pin is the iic device address
+ * @param[in] *callback points to a irq callback address
+ * @param[in] tap_enable is the tap enable bool value
+ * @param[in] action_enable is the action enable bool value
+ * @param[in] inaction_enable is the inaction enable bool value
+ * @param[in] fall_enable is the fall enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the context must be zeroed before the first init, the default interface
+ *            functions are linked unless the caller linked ctx->handle before
+ */
+uint8_t adxl345_interrupt_context_init(adxl345_interrupt_context_t *ctx, adxl345_interface_t interface, adxl345_address_t addr_pin,
+                                       void (*callback)(adxl345_interrupt_context_t *ctx, uint8_t type),
+                                       adxl345_bool_t tap_enable, adxl345_bool_t action_enable, 
+                                       adxl345_bool_t inaction_enable, adxl345_bool_t fall_enable);
+
+/**
+ * @brief     interrupt server with a context
+ * @param[in] *ctx points to a interrupt context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+uint8_t adxl345_interrupt_context_server(adxl345_interrupt_context_t *ctx);
+
+/**
+ * @brief     interrupt example deinit with a context
+ * @param[in] *ctx points to a interrupt context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t adxl345_interrupt_context_deinit(adxl345_interrupt_context_t *ctx);
+
 /**
  * @brief  interrupt irq
  * @return status code
@@ -0,0 +1,318 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_scheduler.c
+ * @brief     driver adxl345 scheduler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_scheduler.h"
+
+/**
+ * @brief scheduler request handshake definition
+ * @note  pending publishes the request fields written before it, on single core mcus without the gnu
+ *        builtins the volatile accesses are kept in order by the compiler and the core
+ */
+#if defined(__GNUC__) || defined(__clang__)
+    #define ADXL345_SCHEDULER_LOAD(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)                  /**< load acquire */
+    #define ADXL345_SCHEDULER_STORE(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)            /**< store release */
+    #define ADXL345_SCHEDULER_INC(p)         (void)__atomic_fetch_add((p), 1, __ATOMIC_RELAXED)      /**< count */
+#else
+    #define ADXL345_SCHEDULER_LOAD(p)        (*(p))                                                  /**< load */
+    #define ADXL345_SCHEDULER_STORE(p, v)    (*(p) = (v))                                            /**< store */
+    #define ADXL345_SCHEDULER_INC(p)         ((*(p))++)                                              /**< count */
+#endif
+
+/**
+ * @brief output data rate table, indexed by the rate bits
+ */
+static const float gs_rate_hz[16] =
+{
+    0.10f, 0.20f, 0.39f, 0.78f, 1.56f, 3.13f, 6.25f, 12.5f,
+    25.0f, 50.0f, 100.0f, 200.0f, 400.0f, 800.0f, 1600.0f, 3200.0f,
+};
+
+/**
+ * @brief     scheduler init
+ * @param[in] *sched points to a scheduler structure
+ * @param[in] *timestamp_us points to a monotonic clock function
+ * @param[in] *callback points to a drained data callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t adxl345_scheduler_init(adxl345_scheduler_t *sched, uint64_t (*timestamp_us)(void),
+                               void (*callback)(adxl345_scheduler_t *sched, uint8_t index,
+                                                int16_t (*raw)[3], float (*g)[3], uint16_t len))
+{
+    if ((sched == NULL) || (timestamp_us == NULL))
+    {
+        return 1;
+    }
+    
+    memset(sched, 0, sizeof(adxl345_scheduler_t));
+    sched->timestamp_us = timestamp_us;
+    sched->callback = callback;
+    
+    return 0;
+}
+
+/**
+ * @brief      scheduler add a sensor
+ * @param[in]  *sched points to a scheduler structure
+ * @param[in]  *handle points to an initialized adxl345 handle in fifo or stream mode
+ * @param[out] *index points to a sensor index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add failed
+ * @note       the rate and the watermark are read once, re-add the sensor after changing them
+ */
+uint8_t adxl345_scheduler_add(adxl345_scheduler_t *sched, adxl345_handle_t *handle, uint8_t *index)
+{
+    uint8_t res;
+    uint8_t level;
+    adxl345_rate_t rate;
+    adxl345_mode_t mode;
+    adxl345_scheduler_sensor_t *sensor;
+    
+    if (sched->num >= ADXL345_SCHEDULER_MAX_SENSOR)
+    {
+        adxl345_interface_debug_print("adxl345: scheduler is full.\n");
+        
+        return 1;
+    }
+    
+    /* get the rate */
+    res = adxl345_get_rate(handle, &rate);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get rate failed.\n");
+        
+        return 1;
+    }
+    
+    /* check the mode */
+    res = adxl345_get_mode(handle, &mode);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get mode failed.\n");
+        
+        return 1;
+    }
+    if (mode == ADXL345_MODE_BYPASS)
+    {
+        adxl345_interface_debug_print("adxl345: fifo is bypassed.\n");
+        
+        return 1;
+    }
+    
+    /* get the watermark */
+    res = adxl345_get_watermark(handle, &level);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get watermark failed.\n");
+        
+        return 1;
+    }
+    sensor = &sched->sensor[sched->num];
+    memset(sensor, 0, sizeof(adxl345_scheduler_sensor_t));
+    sensor->handle = handle;
+    sensor->watermark = level;
+    sensor->period_us = 1000000.0f / gs_rate_hz[rate & 0x0F];
+    *index = sched->num;
+    sched->num++;
+    
+    return 0;
+}
+
+/**
+ * @brief     scheduler request a drain
+ * @param[in] *sched points to a scheduler structure
+ * @param[in] index is the sensor index
+ * @param[in] level is the fifo level seen by the interrupt, 0xFF uses the watermark
+ * @return    status code
+ *            - 0 success
+ *            - 1 request failed
+ * @note      no bus access, it can be called from the watermark interrupt,
+ *            the level is the fifo_level of the event or the irq frame
+ */
+uint8_t adxl345_scheduler_request(adxl345_scheduler_t *sched, uint8_t index, uint8_t level)
+{
+    adxl345_scheduler_sensor_t *sensor;
+    
+    if (index >= sched->num)
+    {
+        return 1;
+    }
+    
+    sensor = &sched->sensor[index];
+    ADXL345_SCHEDULER_INC(&sensor->requests);
+    if (ADXL345_SCHEDULER_LOAD(&sensor->pending) != 0)
+    {
+        /* keep the first request, the fifo only got fuller */
+        ADXL345_SCHEDULER_INC(&sensor->coalesced);
+        
+        return 0;
+    }
+    
+    /* the fields are only written while pending is 0 and published by it */
+    sensor->request_us = sched->timestamp_us();
+    sensor->request_level = (level > 32) ? sensor->watermark : level;
+    ADXL345_SCHEDULER_STORE(&sensor->pending, 1);
+    
+    return 0;
+}
+
+/**
+ * @brief     get the time left before a sensor overruns
+ * @param[in] *sensor points to a scheduler sensor structure
+ * @param[in] now is the current time
+ * @return    time left in us, negative if it may have overrun
+ * @note      the fifo level seen with the request grows by one entry per sample period,
+ *            a request raised after now counts as raised at now
+ */
+static float a_adxl345_scheduler_slack(adxl345_scheduler_sensor_t *sensor, uint64_t now)
+{
+    float level;
+    uint64_t request_us;
+    
+    request_us = sensor->request_us;
+    request_us = (request_us > now) ? now : request_us;
+    level = (float)sensor->request_level + (float)(now - request_us) / sensor->period_us;
+    
+    return (32.0f - level) * sensor->period_us;
+}
+
+/**
+ * @brief      scheduler run the pending drains
+ * @param[in]  *sched points to a scheduler structure
+ * @param[out] *drained points to a drained sensor number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the sensor closest to overrun by its fifo level is drained first and the drains run back-to-back
+ *             until nothing is pending, call it from the thread owning the bus
+ */
+uint8_t adxl345_scheduler_run(adxl345_scheduler_t *sched, uint8_t *drained)
+{
+    uint8_t i;
+    uint8_t pick;
+    uint8_t failed;
+    uint16_t len;
+    uint32_t latency;
+    uint64_t now;
+    uint64_t request_us;
+    float slack;
+    float best;
+    adxl345_scheduler_sensor_t *sensor;
+    
+    *drained = 0;
+    failed = 0;
+    while (1)
+    {
+        /* pick the pending sensor with the least time before overrun */
+        now = sched->timestamp_us();
+        pick = 0xFF;
+        best = 0.0f;
+        for (i = 0; i < sched->num; i++)
+        {
+            if (ADXL345_SCHEDULER_LOAD(&sched->sensor[i].pending) == 0)
+            {
+                continue;
+            }
+            slack = a_adxl345_scheduler_slack(&sched->sensor[i], now);
+            if ((pick == 0xFF) || (slack < best))
+            {
+                pick = i;
+                best = slack;
+            }
+        }
+        if (pick == 0xFF)
+        {
+            break;
+        }
+        
+        /* copy the request time, then clear before the drain so that a new watermark raises a new request */
+        sensor = &sched->sensor[pick];
+        request_us = sensor->request_us;
+        ADXL345_SCHEDULER_STORE(&sensor->pending, 0);
+        len = 33;
+        if (adxl345_read(sensor->handle, sched->raw, sched->g, &len) != 0)
+        {
+            sensor->errors++;
+            failed = 1;
+            
+            continue;
+        }
+        now = sched->timestamp_us();
+        latency = (uint32_t)(now - request_us);
+        sensor->latency_last_us = latency;
+        sensor->latency_max_us = (latency > sensor->latency_max_us) ? latency : sensor->latency_max_us;
+        sensor->latency_sum_us += latency;
+        sensor->drains++;
+        sensor->samples += len;
+        /* the read pops every fifo entry up to 33, so a full fifo returns at least 32 samples */
+        if (len >= 32)
+        {
+            sensor->full_drains++;
+        }
+        (*drained)++;
+        if (sched->callback != NULL)
+        {
+            sched->callback(sched, pick, sched->raw, sched->g, len);
+        }
+    }
+    
+    return failed;
+}
+
+/**
+ * @brief     scheduler print the per-sensor report
+ * @param[in] *sched points to a scheduler structure
+ * @note      none
+ */
+void adxl345_scheduler_report(adxl345_scheduler_t *sched)
+{
+    uint8_t i;
+    adxl345_scheduler_sensor_t *sensor;
+    
+    for (i = 0; i < sched->num; i++)
+    {
+        sensor = &sched->sensor[i];
+        adxl345_interface_debug_print("adxl345: sensor %d drains %d samples %d full drains %d coalesced %d errors %d.\n",
+                                      i, (int)sensor->drains, (int)sensor->samples, (int)sensor->full_drains,
+                                      (int)sensor->coalesced, (int)sensor->errors);
+        adxl345_interface_debug_print("adxl345: sensor %d latency last %dus max %dus avg %dus.\n",
+                                      i, (int)sensor->latency_last_us, (int)sensor->latency_max_us,
+                                      (sensor->drains != 0) ? (int)(sensor->latency_sum_us / sensor->drains) : 0);
+    }
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reservedd
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_scheduler.h
+ * @brief     driver adxl345 scheduler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ADXL345_SCHEDULER_H
+#define DRIVER_ADXL345_SCHEDULER_H
+
+#include "driver_adxl345_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup adxl345_example_driver
+ * @{
+ */
+
+/**
+ * @brief adxl345 scheduler example definition
+ */
+#define ADXL345_SCHEDULER_MAX_SENSOR        16        /**< max sensor number */
+
+/**
+ * @brief adxl345 scheduler sensor structure definition
+ */
+typedef struct adxl345_scheduler_sensor_s
+{
+    adxl345_handle_t *handle;                 /**< sensor handle */
+    volatile uint8_t pending;                 /**< drain requested, publishes request_us and request_level */
+    uint64_t request_us;                      /**< time of the first pending request, only written while pending is 0 */
+    uint8_t request_level;                    /**< fifo level of the first pending request, only written while pending is 0 */
+    uint8_t watermark;                        /**< fifo watermark */
+    float period_us;                          /**< sample period */
+    volatile uint32_t requests;               /**< drain requests */
+    volatile uint32_t coalesced;              /**< requests raised while one was pending */
+    uint32_t drains;                          /**< finished drains */
+    uint32_t samples;                         /**< drained samples */
+    uint32_t full_drains;                     /**< drains that found a full fifo, samples may be lost */
+    uint32_t errors;                          /**< failed drains */
+    uint32_t latency_last_us;                 /**< last request to drain completion latency */
+    uint32_t latency_max_us;                  /**< max latency */
+    uint64_t latency_sum_us;                  /**< latency sum */
+} adxl345_scheduler_sensor_t;
+
+/**
+ * @brief adxl345 scheduler structure definition
+ */
+typedef struct adxl345_scheduler_s
+{
+    adxl345_scheduler_sensor_t sensor[ADXL345_SCHEDULER_MAX_SENSOR];         /**< sensors */
+    uint8_t num;                                                             /**< sensor number */
+    uint64_t (*timestamp_us)(void);                                          /**< monotonic clock */
+    void (*callback)(struct adxl345_scheduler_s *sched, uint8_t index,
+                     int16_t (*raw)[3], float (*g)[3], uint16_t len);        /**< drained data callback */
+    int16_t raw[33][3];                                                      /**< raw data buffer */
+    float g[33][3];                                                          /**< data buffer */
+    void *user;                                                              /**< user pointer */
+} adxl345_scheduler_t;
+
+/**
+ * @brief     scheduler init
+ * @param[in] *sched points to a scheduler structure
+ * @param[in] *timestamp_us points to a monotonic clock function
+ * @param[in] *callback points to a drained data callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t adxl345_scheduler_init(adxl345_scheduler_t *sched, uint64_t (*timestamp_us)(void),
+                               void (*callback)(adxl345_scheduler_t *sched, uint8_t index,
+                                                int16_t (*raw)[3], float (*g)[3], uint16_t len));
+
+/**
+ * @brief      scheduler add a sensor
+ * @param[in]  *sched points to a scheduler structure
+ * @param[in]  *handle points to an initialized adxl345 handle in fifo or stream mode
+ * @param[out] *index points to a sensor index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add failed
+ * @note       the rate and the watermark are read once, re-add the sensor after changing them
+ */
+uint8_t adxl345_scheduler_add(adxl345_scheduler_t *sched, adxl345_handle_t *handle, uint8_t *index);
+
+/**
+ * @brief     scheduler request a drain
+ * @param[in] *sched points to a scheduler structure
+ * @param[in] index is the sensor index
+ * @param[in] level is the fifo level seen by the interrupt, 0xFF uses the watermark
+ * @return    status code
+ *            - 0 success
+ *            - 1 request failed
+ * @note      no bus access, it can be called from the watermark interrupt,
+ *            the level is the fifo_level of the event or the irq frame
+ */
+uint8_t adxl345_scheduler_request(adxl345_scheduler_t *sched, uint8_t index, uint8_t level);
+
+/**
+ * @brief      scheduler run the pending drains
+ * @param[in]  *sched points to a scheduler structure
+ * @param[out] *drained points to a drained sensor number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the sensor closest to overrun by its fifo level is drained first and the drains run back-to-back
+ *             until nothing is pending, call it from the thread owning the bus
+ */
+uint8_t adxl345_scheduler_run(adxl345_scheduler_t *sched, uint8_t *drained);
+
+/**
+ * @brief     scheduler print the per-sensor report
+ * @param[in] *sched points to a scheduler structure
+ * @note      none
+ */
+void adxl345_scheduler_report(adxl345_scheduler_t *sched);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -95,6 +95,32 @@ uint8_t adxl345_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint
  */
 uint8_t adxl345_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr is the iic device write address
+ * @param[in] *xfer points to a transfer segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the segments run in order
+ */
+uint8_t adxl345_interface_iic_transfer(uint8_t addr, adxl345_transfer_t *xfer, uint16_t num);
+
+/**
+ * @brief      interface iic bus async read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @param[in]  *handle points to the handle passed to adxl345_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       it returns once the read is started
+ */
+uint8_t adxl345_interface_iic_read_async(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, adxl345_handle_t *handle);
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -137,6 +163,30 @@ uint8_t adxl345_interface_spi_read(uint8_t reg, uint8_t *buf, uint16_t len);
  */
 uint8_t adxl345_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     interface spi bus transfer
+ * @param[in] *xfer points to a transfer segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      chip select must be released between the segments
+ */
+uint8_t adxl345_interface_spi_transfer(adxl345_transfer_t *xfer, uint16_t num);
+
+/**
+ * @brief      interface spi bus async read
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of data buffer
+ * @param[in]  *handle points to the handle passed to adxl345_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       it returns once the read is started
+ */
+uint8_t adxl345_interface_spi_read_async(uint8_t reg, uint8_t *buf, uint16_t len, adxl345_handle_t *handle);
+
 /**
  * @brief     interface delay ms
  * @param[in] ms
@@ -144,6 +194,20 @@ uint8_t adxl345_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len);
  */
 void adxl345_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief     interface delay us
+ * @param[in] us
+ * @note      none
+ */
+void adxl345_interface_delay_us(uint32_t us);
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t adxl345_interface_timestamp_us(void);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt is the format data
@@ -93,6 +93,38 @@ uint8_t adxl345_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uin
     return 0;
 }
 
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr is the iic device write address
+ * @param[in] *xfer points to a transfer segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the segments run in order
+ */
+uint8_t adxl345_interface_iic_transfer(uint8_t addr, adxl345_transfer_t *xfer, uint16_t num)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface iic bus async read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @param[in]  *handle points to the handle passed to adxl345_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       it returns once the read is started
+ */
+uint8_t adxl345_interface_iic_read_async(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, adxl345_handle_t *handle)
+{
+    return 0;
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -147,6 +179,36 @@ uint8_t adxl345_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
     return 0;
 }
 
+/**
+ * @brief     interface spi bus transfer
+ * @param[in] *xfer points to a transfer segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      chip select must be released between the segments
+ */
+uint8_t adxl345_interface_spi_transfer(adxl345_transfer_t *xfer, uint16_t num)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface spi bus async read
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of data buffer
+ * @param[in]  *handle points to the handle passed to adxl345_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       it returns once the read is started
+ */
+uint8_t adxl345_interface_spi_read_async(uint8_t reg, uint8_t *buf, uint16_t len, adxl345_handle_t *handle)
+{
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms
@@ -157,6 +219,26 @@ void adxl345_interface_delay_ms(uint32_t ms)
 
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us
+ * @note      none
+ */
+void adxl345_interface_delay_us(uint32_t us)
+{
+
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t adxl345_interface_timestamp_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt is the format data
@@ -38,7 +38,9 @@
 #include "driver_adxl345_interface.h"
 #include "iic.h"
 #include "spi.h"
+#include "async_worker.h"
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -60,6 +62,59 @@ static int gs_iic_fd;                       /**< iic handle */
  */
 static int gs_spi_fd;                       /**< spi handle */
 
+/**
+ * @brief async worker definition
+ */
+static async_worker_t gs_iic_worker;        /**< iic async worker */
+static uint8_t gs_iic_worker_inited;        /**< iic async worker inited flag */
+static async_worker_t gs_spi_worker;        /**< spi async worker */
+static uint8_t gs_spi_worker_inited;        /**< spi async worker inited flag */
+
+/**
+ * @brief     async worker completion
+ * @param[in] *arg points to a adxl345 handle structure
+ * @param[in] res is the read result
+ * @note      none
+ */
+static void a_async_complete(void *arg, uint8_t res)
+{
+    (void)adxl345_async_complete((adxl345_handle_t *)arg, res);
+}
+
+/**
+ * @brief      iic async worker read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_async_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return iic_read(gs_iic_fd, addr, reg, buf, len);
+}
+
+/**
+ * @brief      spi async worker read
+ * @param[in]  addr is ignored
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_async_spi_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return spi_read(gs_spi_fd, reg, buf, len);
+}
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -81,6 +136,12 @@ uint8_t adxl345_interface_iic_init(void)
  */
 uint8_t adxl345_interface_iic_deinit(void)
 {
+    if (gs_iic_worker_inited != 0)
+    {
+        (void)async_worker_deinit(&gs_iic_worker);
+        gs_iic_worker_inited = 0;
+    }
+    
     return iic_deinit(gs_iic_fd);
 }
 
@@ -116,6 +177,63 @@ uint8_t adxl345_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uin
     return iic_write(gs_iic_fd, addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr is the iic device write address
+ * @param[in] *xfer points to a transfer segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the fifo entry reads are packed into as few I2C_RDWR ioctls as the kernel allows,
+ *            the bus framing between the entries already exceeds the 5us fifo spacing at 400kHz
+ */
+uint8_t adxl345_interface_iic_transfer(uint8_t addr, adxl345_transfer_t *xfer, uint16_t num)
+{
+    iic_segment_t seg[33];
+    uint16_t i;
+    
+    if (num > 33)
+    {
+        return 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        seg[i].reg = xfer[i].reg;
+        seg[i].read = (xfer[i].rw == ADXL345_TRANSFER_READ) ? 1 : 0;
+        seg[i].len = xfer[i].len;
+        seg[i].buf = xfer[i].buf;
+    }
+    
+    return iic_transfer_batch(gs_iic_fd, addr, seg, num);
+}
+
+/**
+ * @brief      interface iic bus async read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @param[in]  *handle points to the handle passed to adxl345_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the read runs in a worker thread started on the first call
+ */
+uint8_t adxl345_interface_iic_read_async(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, adxl345_handle_t *handle)
+{
+    if (gs_iic_worker_inited == 0)
+    {
+        if (async_worker_init(&gs_iic_worker, a_async_iic_read, a_async_complete) != 0)
+        {
+            return 1;
+        }
+        gs_iic_worker_inited = 1;
+    }
+    
+    return async_worker_submit(&gs_iic_worker, addr, reg, buf, len, handle);
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -137,6 +255,12 @@ uint8_t adxl345_interface_spi_init(void)
  */
 uint8_t adxl345_interface_spi_deinit(void)
 {   
+    if (gs_spi_worker_inited != 0)
+    {
+        (void)async_worker_deinit(&gs_spi_worker);
+        gs_spi_worker_inited = 0;
+    }
+    
     return spi_deinit(gs_spi_fd);
 }
 
@@ -170,6 +294,61 @@ uint8_t adxl345_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
     return spi_write(gs_spi_fd, reg, buf, len);
 }
 
+/**
+ * @brief     interface spi bus transfer
+ * @param[in] *xfer points to a transfer segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      all segments go out in one spidev message, the entries are read straight into the driver buffers
+ */
+uint8_t adxl345_interface_spi_transfer(adxl345_transfer_t *xfer, uint16_t num)
+{
+    spi_segment_t seg[SPI_SEGMENT_MAX];
+    uint16_t i;
+    
+    if (num > SPI_SEGMENT_MAX)
+    {
+        return 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        seg[i].cmd = xfer[i].reg;
+        seg[i].read = (xfer[i].rw == ADXL345_TRANSFER_READ) ? 1 : 0;
+        seg[i].len = xfer[i].len;
+        seg[i].buf = xfer[i].buf;
+        seg[i].delay_us = xfer[i].delay_us;
+    }
+    
+    return spi_transfer(gs_spi_fd, seg, num);
+}
+
+/**
+ * @brief      interface spi bus async read
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of data buffer
+ * @param[in]  *handle points to the handle passed to adxl345_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the read runs in a worker thread started on the first call
+ */
+uint8_t adxl345_interface_spi_read_async(uint8_t reg, uint8_t *buf, uint16_t len, adxl345_handle_t *handle)
+{
+    if (gs_spi_worker_inited == 0)
+    {
+        if (async_worker_init(&gs_spi_worker, a_async_spi_read, a_async_complete) != 0)
+        {
+            return 1;
+        }
+        gs_spi_worker_inited = 1;
+    }
+    
+    return async_worker_submit(&gs_spi_worker, 0, reg, buf, len, handle);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms
@@ -180,6 +359,30 @@ void adxl345_interface_delay_ms(uint32_t ms)
     usleep(1000 * ms);
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us
+ * @note      none
+ */
+void adxl345_interface_delay_us(uint32_t us)
+{
+    usleep(us);
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t adxl345_interface_timestamp_us(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt is the format data
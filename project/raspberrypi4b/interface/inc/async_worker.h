@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      async_worker.h
+ * @brief     async worker header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef ASYNC_WORKER_H
+#define ASYNC_WORKER_H
+
+#include <stdint.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup async_worker async worker function
+ * @brief    worker thread running blocking reads as split-phase async reads
+ * @{
+ */
+
+/**
+ * @brief async worker structure definition
+ * @note  one read is held at a time, a read submitted from the completion runs next
+ */
+typedef struct async_worker_s
+{
+    pthread_t pid;                                                            /**< worker pthread pid */
+    pthread_mutex_t mutex;                                                    /**< job mutex */
+    pthread_cond_t cond;                                                      /**< job condition */
+    uint8_t pending;                                                          /**< job pending flag */
+    uint8_t quit;                                                             /**< quit flag */
+    uint8_t (*read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);   /**< blocking read */
+    void (*complete)(void *arg, uint8_t res);                                 /**< completion */
+    uint8_t addr;                                                             /**< job iic address */
+    uint8_t reg;                                                              /**< job register */
+    uint8_t *buf;                                                             /**< job buffer */
+    uint16_t len;                                                             /**< job length */
+    void *arg;                                                                /**< job completion argument */
+} async_worker_t;
+
+/**
+ * @brief     async worker init
+ * @param[in] *worker points to an async worker structure
+ * @param[in] *read points to a blocking read function
+ * @param[in] *complete points to a completion function
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the completion runs in the worker thread
+ */
+uint8_t async_worker_init(async_worker_t *worker, uint8_t (*read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len),
+                          void (*complete)(void *arg, uint8_t res));
+
+/**
+ * @brief     async worker submit a read
+ * @param[in] *worker points to an async worker structure
+ * @param[in] addr is the iic address
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @param[in] *arg points to the completion argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 worker is busy or stopped
+ * @note      it returns at once, the completion is called with arg when the read is done
+ */
+uint8_t async_worker_submit(async_worker_t *worker, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, void *arg);
+
+/**
+ * @brief     async worker deinit
+ * @param[in] *worker points to an async worker structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      a read in flight is finished and completed before the worker stops
+ */
+uint8_t async_worker_deinit(async_worker_t *worker);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
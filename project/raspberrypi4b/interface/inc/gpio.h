@@ -39,8 +39,17 @@
 
 #include <gpiod.h>
 #include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <time.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #ifdef __cplusplus
  extern "C" {
@@ -52,24 +61,134 @@
  * @{
  */
 
+/**
+ * @brief gpio interrupt max lines definition
+ */
+#define GPIO_INTERRUPT_MAX_LINES 8
+
+/**
+ * @brief gpio interrupt event batch definition
+ */
+#define GPIO_INTERRUPT_EVENT_BATCH 16
+
+/**
+ * @brief gpio interrupt line structure definition
+ */
+typedef struct gpio_interrupt_line_s
+{
+    const char *chip;        /**< gpio chip device name */
+    uint32_t line;           /**< gpio line offset */
+} gpio_interrupt_line_t;
+
+/**
+ * @brief gpio interrupt handler definition
+ * @note  id is the index in the line array, timestamp_ns is the kernel event time
+ */
+typedef void (*gpio_interrupt_handler_t)(uint8_t id, uint64_t timestamp_ns);
+
+/**
+ * @brief gpio latency bucket number definition
+ */
+#define GPIO_LATENCY_BUCKETS 16
+
+/**
+ * @brief gpio rt stack prefault size definition
+ */
+#define GPIO_RT_STACK_PREFAULT (64 * 1024)
+
+/**
+ * @brief gpio rt last cpu definition
+ */
+#define GPIO_RT_CPU_LAST (-2)
+
+/**
+ * @brief gpio rt flag enumeration definition
+ */
+typedef enum
+{
+    GPIO_RT_FLAG_SCHED    = (1 << 0),        /**< SCHED_FIFO priority */
+    GPIO_RT_FLAG_AFFINITY = (1 << 1),        /**< cpu affinity */
+    GPIO_RT_FLAG_MLOCK    = (1 << 2),        /**< mlockall */
+    GPIO_RT_FLAG_PREFAULT = (1 << 3),        /**< prefaulted stack */
+} gpio_rt_flag_t;
+
+/**
+ * @brief gpio rt config structure definition
+ */
+typedef struct gpio_rt_config_s
+{
+    uint8_t enable;          /**< 1 to run the reactor thread in rt mode */
+    int priority;            /**< SCHED_FIFO priority */
+    int cpu;                 /**< cpu to pin the thread to, -1 for no affinity, GPIO_RT_CPU_LAST for the last allowed cpu */
+} gpio_rt_config_t;
+
+/**
+ * @brief gpio latency structure definition
+ * @note  bucket 0 counts < 2us, bucket i counts [2^i, 2^(i+1)) us, the last bucket is open ended
+ */
+typedef struct gpio_latency_s
+{
+    uint32_t bucket[GPIO_LATENCY_BUCKETS];        /**< edge to drain complete histogram */
+    uint32_t count;                               /**< measured edges */
+    uint32_t skipped;                             /**< edges with a timestamp ahead of the monotonic clock */
+    uint64_t sum_ns;                              /**< latency sum */
+    uint64_t max_ns;                              /**< latency max */
+    uint32_t rt_requested;                        /**< requested gpio_rt_flag_t mask */
+    uint32_t rt_applied;                          /**< applied gpio_rt_flag_t mask */
+} gpio_latency_t;
+
 /**
  * @brief  gpio interrupt init
  * @return status code
  *         - 0 success
  *         - 1 init failed
- * @note   none
+ * @note   it watches the falling edge of line 17 on /dev/gpiochip0 and calls g_gpio_irq
  */
 uint8_t gpio_interrupt_init(void);
 
+/**
+ * @brief     gpio interrupt lines init
+ * @param[in] *line points to a line array
+ * @param[in] num is the line number
+ * @param[in] handler is the falling edge handler
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 param is invalid
+ * @note      one reactor thread watches all lines, the handler runs on that thread
+ */
+uint8_t gpio_interrupt_init_lines(const gpio_interrupt_line_t *line, uint8_t num, gpio_interrupt_handler_t handler);
+
 /**
  * @brief  gpio interrupt deinit
  * @return status code
  *         - 0 success
  *         - 1 deinit failed
- * @note   none
+ * @note   it wakes the reactor thread and joins it before releasing the lines
  */
 uint8_t gpio_interrupt_deinit(void);
 
+/**
+ * @brief     gpio interrupt set the rt config
+ * @param[in] *config points to an rt config structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 param is invalid
+ * @note      it takes effect on the next init, an rt feature that can't be applied is reported
+ *            by gpio_interrupt_get_latency instead of failing the init
+ */
+uint8_t gpio_interrupt_set_rt(const gpio_rt_config_t *config);
+
+/**
+ * @brief      gpio interrupt get the latency histogram
+ * @param[out] *latency points to a latency structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 param is invalid
+ * @note       the histogram is always on and cleared on every init
+ */
+uint8_t gpio_interrupt_get_latency(gpio_latency_t *latency);
+
 /**
  * @}
  */
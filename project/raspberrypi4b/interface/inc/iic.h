@@ -51,6 +51,22 @@
 extern "C" {
 #endif
 
+/**
+ * @brief iic batch max message number definition
+ */
+#define IIC_BATCH_MAX_MSGS 42        /**< kernel I2C_RDWR_IOCTL_MAX_MSGS */
+
+/**
+ * @brief iic segment structure definition
+ */
+typedef struct iic_segment_s
+{
+    uint8_t reg;             /**< register address */
+    uint8_t read;            /**< 1 read the data, 0 write the data */
+    uint16_t len;            /**< data length */
+    uint8_t *buf;            /**< data buffer */
+} iic_segment_t;
+
 /**
  * @defgroup iic iic function
  * @brief    iic function modules
@@ -160,6 +176,21 @@ uint8_t iic_read(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
  */
 uint8_t iic_read_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     iic bus transfer batch
+ * @param[in] fd is the iic handle
+ * @param[in] addr is iic device write address
+ * @param[in] *seg points to a segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the read segments are packed as write register and read data message pairs
+ *            into I2C_RDWR ioctls of at most IIC_BATCH_MAX_MSGS messages,
+ *            a write segment flushes the pending pairs and runs on its own
+ */
+uint8_t iic_transfer_batch(int fd, uint8_t addr, iic_segment_t *seg, uint16_t num);
+
 /**
  * @}
  */
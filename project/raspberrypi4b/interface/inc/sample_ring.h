@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sample_ring.h
+ * @brief     sample ring header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup sample_ring sample ring function
+ * @brief    lock free single producer single consumer sample ring modules
+ * @{
+ */
+
+/**
+ * @brief sample ring cache line size definition
+ */
+#define SAMPLE_RING_CACHE_LINE 64        /**< cache line size in bytes */
+
+/**
+ * @brief sample ring overflow policy enumeration definition
+ */
+typedef enum
+{
+    SAMPLE_RING_DROP_NEWEST = 0x00,        /**< drop the frames that do not fit */
+    SAMPLE_RING_DROP_OLDEST = 0x01,        /**< overwrite the oldest frames */
+} sample_ring_policy_t;
+
+/**
+ * @brief sample ring structure definition
+ * @note  head is written by the producer only, tail is written by the consumer
+ *        and by the producer only when it drops the oldest frames
+ */
+typedef struct sample_ring_s
+{
+    uint32_t head __attribute__((aligned(SAMPLE_RING_CACHE_LINE)));        /**< write index, free running */
+    uint64_t pushed;                                                       /**< pushed frames */
+    uint64_t dropped;                                                      /**< dropped frames */
+    uint32_t tail __attribute__((aligned(SAMPLE_RING_CACHE_LINE)));        /**< read index, free running */
+    uint64_t popped;                                                       /**< popped frames */
+    float (*frame)[3] __attribute__((aligned(SAMPLE_RING_CACHE_LINE)));    /**< frame storage */
+    uint32_t mask;                                                         /**< capacity - 1 */
+    sample_ring_policy_t policy;                                           /**< overflow policy */
+} sample_ring_t;
+
+/**
+ * @brief     sample ring init
+ * @param[in] *ring points to a sample ring structure
+ * @param[in] **frame points to a frame storage
+ * @param[in] capacity is the frame number of the storage
+ * @param[in] policy is the overflow policy
+ * @return    status code
+ *            - 0 success
+ *            - 1 capacity is not a power of two
+ * @note      none
+ */
+uint8_t sample_ring_init(sample_ring_t *ring, float (*frame)[3], uint32_t capacity, sample_ring_policy_t policy);
+
+/**
+ * @brief     sample ring push frames
+ * @param[in] *ring points to a sample ring structure
+ * @param[in] **g points to a frame buffer
+ * @param[in] len is the frame number
+ * @return    stored frame number
+ * @note      producer side only, it never waits for the consumer
+ */
+uint32_t sample_ring_push(sample_ring_t *ring, const float (*g)[3], uint32_t len);
+
+/**
+ * @brief      sample ring pop frames
+ * @param[in]  *ring points to a sample ring structure
+ * @param[out] **g points to a frame buffer
+ * @param[in]  len is the max frame number
+ * @return     popped frame number
+ * @note       consumer side only
+ */
+uint32_t sample_ring_pop(sample_ring_t *ring, float (*g)[3], uint32_t len);
+
+/**
+ * @brief      sample ring get the counters
+ * @param[in]  *ring points to a sample ring structure
+ * @param[out] *pushed points to a pushed frame number buffer
+ * @param[out] *popped points to a popped frame number buffer
+ * @param[out] *dropped points to a dropped frame number buffer
+ * @note       it can be called from any thread
+ */
+void sample_ring_get_counter(sample_ring_t *ring, uint64_t *pushed, uint64_t *popped, uint64_t *dropped);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -61,6 +61,23 @@ typedef enum
     SPI_MODE_TYPE_3 = SPI_MODE_3,        /**< mode 3 */
 }spi_mode_type_t;
 
+/**
+ * @brief spi max segment number definition
+ */
+#define SPI_SEGMENT_MAX 33        /**< max segment number of one transfer */
+
+/**
+ * @brief spi segment structure definition
+ */
+typedef struct spi_segment_s
+{
+    uint8_t cmd;             /**< command byte */
+    uint8_t read;            /**< 1 read the data, 0 write the data */
+    uint16_t len;            /**< data length */
+    uint8_t *buf;            /**< data buffer */
+    uint16_t delay_us;       /**< delay after the segment in us */
+} spi_segment_t;
+
 /**
  * @brief      spi bus init
  * @param[in]  *name points to a spi device name buffer
@@ -134,6 +151,19 @@ uint8_t spi_write_cmd(int fd, uint8_t *buf, uint16_t len);
  */
 uint8_t spi_write(int fd, uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     spi bus transfer
+ * @param[in] fd is the spi handle
+ * @param[in] *seg points to a segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      all segments go out in one SPI_IOC_MESSAGE, chip select is released between the segments,
+ *            num <= SPI_SEGMENT_MAX, the data is transferred straight from and into the segment buffers
+ */
+uint8_t spi_transfer(int fd, spi_segment_t *seg, uint16_t num);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      async_worker.c
+ * @brief     async worker source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "async_worker.h"
+#include <stdio.h>
+
+/**
+ * @brief     async worker pthread
+ * @param[in] *p points to an async worker structure
+ * @return    NULL
+ * @note      none
+ */
+static void *a_async_worker_pthread(void *p)
+{
+    async_worker_t *worker = (async_worker_t *)p;
+    uint8_t res;
+    uint8_t addr;
+    uint8_t reg;
+    uint8_t *buf;
+    uint16_t len;
+    void *arg;
+
+    pthread_mutex_lock(&worker->mutex);
+    while (1)
+    {
+        while ((worker->pending == 0) && (worker->quit == 0))
+        {
+            pthread_cond_wait(&worker->cond, &worker->mutex);
+        }
+        if (worker->pending == 0)
+        {
+            break;
+        }
+        addr = worker->addr;
+        reg = worker->reg;
+        buf = worker->buf;
+        len = worker->len;
+        arg = worker->arg;
+        pthread_mutex_unlock(&worker->mutex);
+
+        /* the slot is freed before the completion, so the completion can chain the next read */
+        res = worker->read(addr, reg, buf, len);
+        pthread_mutex_lock(&worker->mutex);
+        worker->pending = 0;
+        pthread_mutex_unlock(&worker->mutex);
+        worker->complete(arg, res);
+        pthread_mutex_lock(&worker->mutex);
+    }
+    pthread_mutex_unlock(&worker->mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief     async worker init
+ * @param[in] *worker points to an async worker structure
+ * @param[in] *read points to a blocking read function
+ * @param[in] *complete points to a completion function
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the completion runs in the worker thread
+ */
+uint8_t async_worker_init(async_worker_t *worker, uint8_t (*read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len),
+                          void (*complete)(void *arg, uint8_t res))
+{
+    worker->pending = 0;
+    worker->quit = 0;
+    worker->read = read;
+    worker->complete = complete;
+    if (pthread_mutex_init(&worker->mutex, NULL) != 0)
+    {
+        perror("async: init mutex failed.\n");
+
+        return 1;
+    }
+    if (pthread_cond_init(&worker->cond, NULL) != 0)
+    {
+        perror("async: init cond failed.\n");
+        pthread_mutex_destroy(&worker->mutex);
+
+        return 1;
+    }
+    if (pthread_create(&worker->pid, NULL, a_async_worker_pthread, worker) != 0)
+    {
+        perror("async: create pthread failed.\n");
+        pthread_cond_destroy(&worker->cond);
+        pthread_mutex_destroy(&worker->mutex);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     async worker submit a read
+ * @param[in] *worker points to an async worker structure
+ * @param[in] addr is the iic address
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @param[in] *arg points to the completion argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 worker is busy or stopped
+ * @note      it returns at once, the completion is called with arg when the read is done
+ */
+uint8_t async_worker_submit(async_worker_t *worker, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, void *arg)
+{
+    pthread_mutex_lock(&worker->mutex);
+    if ((worker->pending != 0) || (worker->quit != 0))
+    {
+        pthread_mutex_unlock(&worker->mutex);
+
+        return 1;
+    }
+    worker->addr = addr;
+    worker->reg = reg;
+    worker->buf = buf;
+    worker->len = len;
+    worker->arg = arg;
+    worker->pending = 1;
+    pthread_cond_signal(&worker->cond);
+    pthread_mutex_unlock(&worker->mutex);
+
+    return 0;
+}
+
+/**
+ * @brief     async worker deinit
+ * @param[in] *worker points to an async worker structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      a read in flight is finished and completed before the worker stops
+ */
+uint8_t async_worker_deinit(async_worker_t *worker)
+{
+    pthread_mutex_lock(&worker->mutex);
+    worker->quit = 1;
+    pthread_cond_signal(&worker->cond);
+    pthread_mutex_unlock(&worker->mutex);
+    if (pthread_join(worker->pid, NULL) != 0)
+    {
+        perror("async: join pthread failed.\n");
+
+        return 1;
+    }
+    pthread_cond_destroy(&worker->cond);
+    pthread_mutex_destroy(&worker->mutex);
+
+    return 0;
+}
@@ -34,6 +34,7 @@
  * </table>
  */
 
+#define _GNU_SOURCE
 #include "gpio.h"
 
 /**
@@ -46,111 +47,513 @@
  */
 #define GPIO_DEVICE_LINE 17                      /**< gpio device line */
 
+/**
+ * @brief gpio shutdown event id definition
+ */
+#define GPIO_SHUTDOWN_ID 0xFFFFFFFFU             /**< epoll id of the shutdown eventfd */
+
 /**
  * @brief global var definition
  */
-static struct gpiod_chip *gs_chip;               /**< gpio chip handle */
-static struct gpiod_line *gs_line;               /**< gpio line handle */
-static pthread_t gs_pid;                         /**< gpio pthread pid */
-extern uint8_t (*g_gpio_irq)(void);              /**< gpio irq function address */
+static struct gpiod_chip *gs_chip[GPIO_INTERRUPT_MAX_LINES];        /**< gpio chip handle */
+static struct gpiod_line *gs_line[GPIO_INTERRUPT_MAX_LINES];        /**< gpio line handle */
+static uint8_t gs_line_num;                                         /**< gpio line number */
+static gpio_interrupt_handler_t gs_handler;                         /**< gpio event handler */
+static int gs_epoll_fd = -1;                                        /**< epoll fd */
+static int gs_event_fd = -1;                                        /**< shutdown eventfd */
+static uint8_t gs_running;                                          /**< reactor thread running flag */
+static pthread_t gs_pid;                                            /**< gpio pthread pid */
+static gpio_rt_config_t gs_rt = {0, 80, -1};                        /**< rt config */
+static gpio_latency_t gs_latency;                                   /**< edge to drain complete latency */
+extern uint8_t (*g_gpio_irq)(void);                                 /**< gpio irq function address */
+
+/**
+ * @brief     gpio default handler
+ * @param[in] id is the line index
+ * @param[in] timestamp_ns is the kernel event time
+ * @note      it keeps the g_gpio_irq interface of gpio_interrupt_init
+ */
+static void a_gpio_default_handler(uint8_t id, uint64_t timestamp_ns)
+{
+    (void)id;
+    (void)timestamp_ns;
+    if (g_gpio_irq)
+    {
+        g_gpio_irq();
+    }
+}
+
+/**
+ * @brief     gpio record the latency of one edge
+ * @param[in] timestamp_ns is the kernel event time
+ * @note      line event timestamps are CLOCK_MONOTONIC since linux 5.7, older kernels are skipped
+ */
+static void a_gpio_record(uint64_t timestamp_ns)
+{
+    struct timespec now;
+    uint64_t now_ns;
+    uint64_t ns;
+    uint64_t us;
+    uint32_t i;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    now_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    if (now_ns < timestamp_ns)
+    {
+        __atomic_fetch_add(&gs_latency.skipped, 1, __ATOMIC_RELAXED);
+
+        return;
+    }
+    ns = now_ns - timestamp_ns;
+    us = ns / 1000;
+    for (i = 0; (i < GPIO_LATENCY_BUCKETS - 1) && (us >= 2); i++)
+    {
+        us >>= 1;
+    }
+    __atomic_fetch_add(&gs_latency.bucket[i], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&gs_latency.sum_ns, ns, __ATOMIC_RELAXED);
+    if (ns > __atomic_load_n(&gs_latency.max_ns, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&gs_latency.max_ns, ns, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&gs_latency.count, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief gpio prefault the reactor thread stack
+ * @note  the pages stay resident once mlockall is in place
+ */
+static void __attribute__((noinline)) a_gpio_prefault(void)
+{
+    volatile uint8_t stack[GPIO_RT_STACK_PREFAULT];
+    size_t i;
+
+    for (i = 0; i < sizeof(stack); i += 4096)
+    {
+        stack[i] = 0;
+    }
+}
+
+/**
+ * @brief     gpio drain all pending events of one line
+ * @param[in] id is the line index
+ * @note      the line fd is non-blocking, a short read means it is empty
+ */
+static void a_gpio_drain(uint8_t id)
+{
+    struct gpiod_line_event event[GPIO_INTERRUPT_EVENT_BATCH];
+    int n;
+    int i;
+
+    do
+    {
+        n = gpiod_line_event_read_multiple(gs_line[id], event, GPIO_INTERRUPT_EVENT_BATCH);
+        for (i = 0; i < n; i++)
+        {
+            if (event[i].event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
+            {
+                uint64_t timestamp_ns = (uint64_t)event[i].ts.tv_sec * 1000000000ULL + (uint64_t)event[i].ts.tv_nsec;
+
+                gs_handler(id, timestamp_ns);
+                a_gpio_record(timestamp_ns);
+            }
+        }
+    } while (n == GPIO_INTERRUPT_EVENT_BATCH);
+}
 
 /**
  * @brief  gpio interrupt pthread
  * @param  *p ponts to a args
  * @return NULL
- * @note   none
+ * @note   it returns once the shutdown eventfd is signalled
  */
 static void *gpio_interrupt_pthread(void *p)
 {
-    int res;
-    struct gpiod_line_event event;
+    struct epoll_event event[GPIO_INTERRUPT_MAX_LINES + 1];
+    int n;
+    int i;
 
-    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
-    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
+    (void)p;
+    if (gs_rt.enable != 0)
+    {
+        a_gpio_prefault();
+        __atomic_fetch_or(&gs_latency.rt_applied, GPIO_RT_FLAG_PREFAULT, __ATOMIC_RELAXED);
+    }
     while (1)
     {
-        res = gpiod_line_event_wait(gs_line, NULL);
-        if (res == 1)
+        n = epoll_wait(gs_epoll_fd, event, GPIO_INTERRUPT_MAX_LINES + 1, -1);
+        if (n < 0)
         {
-             if (gpiod_line_event_read(gs_line, &event) != 0)
-             {
-                 continue;
-             }
-             if (event.event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
-             {
-                 if (g_gpio_irq)
-                 {
-                     g_gpio_irq();
-                 }
-             }
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("gpio: epoll wait failed.\n");
+
+            return NULL;
+        }
+        for (i = 0; i < n; i++)
+        {
+            if (event[i].data.u32 == GPIO_SHUTDOWN_ID)
+            {
+                return NULL;
+            }
+        }
+        for (i = 0; i < n; i++)
+        {
+            a_gpio_drain((uint8_t)event[i].data.u32);
         }
     }
 }
 
 /**
- * @brief  gpio interrupt init
+ * @brief gpio release all lines, chips and fds
+ * @note  none
+ */
+static void a_gpio_release(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < gs_line_num; i++)
+    {
+        if (gs_line[i] != NULL)
+        {
+            gpiod_line_release(gs_line[i]);
+            gs_line[i] = NULL;
+        }
+        if (gs_chip[i] != NULL)
+        {
+            gpiod_chip_close(gs_chip[i]);
+            gs_chip[i] = NULL;
+        }
+    }
+    gs_line_num = 0;
+    if (gs_epoll_fd >= 0)
+    {
+        (void)close(gs_epoll_fd);
+        gs_epoll_fd = -1;
+    }
+    if (gs_event_fd >= 0)
+    {
+        (void)close(gs_event_fd);
+        gs_event_fd = -1;
+    }
+}
+
+/**
+ * @brief      gpio build the rt attributes of the reactor thread
+ * @param[out] *attr points to a thread attribute structure
+ * @return     rt flags set in the attributes
+ * @note       the memory is locked here so the thread starts with every rt feature in effect,
+ *             GPIO_RT_CPU_LAST picks the highest cpu in the process affinity mask
+ */
+static uint32_t a_gpio_rt_attr(pthread_attr_t *attr)
+{
+    struct sched_param param;
+    cpu_set_t set;
+    uint32_t flag;
+    int cpu;
+    int i;
+
+    flag = 0;
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+    {
+        flag |= GPIO_RT_FLAG_MLOCK;
+    }
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = gs_rt.priority;
+    if ((pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED) == 0) &&
+        (pthread_attr_setschedpolicy(attr, SCHED_FIFO) == 0) &&
+        (pthread_attr_setschedparam(attr, &param) == 0))
+    {
+        flag |= GPIO_RT_FLAG_SCHED;
+    }
+    else
+    {
+        (void)pthread_attr_setinheritsched(attr, PTHREAD_INHERIT_SCHED);
+    }
+    cpu = gs_rt.cpu;
+    if ((cpu == GPIO_RT_CPU_LAST) && (sched_getaffinity(0, sizeof(set), &set) == 0))
+    {
+        for (i = 0; i < CPU_SETSIZE; i++)
+        {
+            if (CPU_ISSET(i, &set))
+            {
+                cpu = i;
+            }
+        }
+    }
+    if (cpu >= 0)
+    {
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (pthread_attr_setaffinity_np(attr, sizeof(set), &set) == 0)
+        {
+            flag |= GPIO_RT_FLAG_AFFINITY;
+        }
+    }
+
+    return flag;
+}
+
+/**
+ * @brief  gpio create the reactor thread
  * @return status code
  *         - 0 success
- *         - 1 init failed
- * @note   none
+ *         - 1 create failed
+ * @note   in rt mode the thread is created with its policy, priority and cpu already set,
+ *         a feature the process lacks the privilege for is dropped and left out of rt_applied
  */
-uint8_t gpio_interrupt_init(void)
+static uint8_t a_gpio_thread_create(void)
 {
-    uint8_t res;
+    pthread_attr_t attr;
+    cpu_set_t set;
+    uint32_t flag;
+    int res;
 
-    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
-    if (!gs_chip)
+    if (gs_rt.enable == 0)
+    {
+        return (pthread_create(&gs_pid, NULL, gpio_interrupt_pthread, NULL) == 0) ? 0 : 1;
+    }
+    if (pthread_attr_init(&attr) != 0)
+    {
+        return 1;
+    }
+    flag = a_gpio_rt_attr(&attr);
+    res = pthread_create(&gs_pid, &attr, gpio_interrupt_pthread, NULL);
+    if ((res == EPERM) && ((flag & GPIO_RT_FLAG_SCHED) != 0))
+    {
+        /* no privilege for SCHED_FIFO, keep the cpu */
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        flag &= ~GPIO_RT_FLAG_SCHED;
+        res = pthread_create(&gs_pid, &attr, gpio_interrupt_pthread, NULL);
+    }
+    if ((res != 0) && ((flag & GPIO_RT_FLAG_AFFINITY) != 0))
+    {
+        /* the cpu is not in the allowed set, run anywhere */
+        (void)sched_getaffinity(0, sizeof(set), &set);
+        (void)pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+        flag &= ~GPIO_RT_FLAG_AFFINITY;
+        res = pthread_create(&gs_pid, &attr, gpio_interrupt_pthread, NULL);
+    }
+    (void)pthread_attr_destroy(&attr);
+    if (res != 0)
     {
-        perror("gpio: open failed.\n");
+        if ((flag & GPIO_RT_FLAG_MLOCK) != 0)
+        {
+            (void)munlockall();
+        }
 
         return 1;
     }
-    gs_line = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE);
-    if (!gs_line) 
+    __atomic_fetch_or(&gs_latency.rt_applied, flag, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+/**
+ * @brief     gpio interrupt lines init
+ * @param[in] *line points to a line array
+ * @param[in] num is the line number
+ * @param[in] handler is the falling edge handler
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 param is invalid
+ * @note      one reactor thread watches all lines, the handler runs on that thread
+ */
+uint8_t gpio_interrupt_init_lines(const gpio_interrupt_line_t *line, uint8_t num, gpio_interrupt_handler_t handler)
+{
+    struct epoll_event event;
+    uint8_t i;
+    int fd;
+
+    if ((line == NULL) || (num == 0) || (num > GPIO_INTERRUPT_MAX_LINES) || (handler == NULL) || (gs_running != 0))
+    {
+        return 2;
+    }
+    gs_handler = handler;
+    memset(&gs_latency, 0, sizeof(gs_latency));
+    if (gs_rt.enable != 0)
     {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_chip);
+        gs_latency.rt_requested = GPIO_RT_FLAG_SCHED | GPIO_RT_FLAG_MLOCK | GPIO_RT_FLAG_PREFAULT |
+                                  ((gs_rt.cpu != -1) ? GPIO_RT_FLAG_AFFINITY : 0);
+    }
+    gs_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    gs_event_fd = eventfd(0, EFD_CLOEXEC);
+    if ((gs_epoll_fd < 0) || (gs_event_fd < 0))
+    {
+        perror("gpio: create epoll failed.\n");
+        a_gpio_release();
 
         return 1;
     }
-    if (gpiod_line_request_falling_edge_events(gs_line, "gpiointerrupt") < 0)
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = GPIO_SHUTDOWN_ID;
+    if (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, gs_event_fd, &event) != 0)
     {
-        perror("gpio: set falling edge events failed.\n");
-        gpiod_chip_close(gs_chip);
+        perror("gpio: add eventfd failed.\n");
+        a_gpio_release();
 
         return 1;
     }
-    res = pthread_create(&gs_pid, NULL, gpio_interrupt_pthread, NULL);
-    if (res != 0)
+    for (i = 0; i < num; i++)
+    {
+        gs_line_num = i + 1;
+        gs_chip[i] = gpiod_chip_open(line[i].chip);
+        if (!gs_chip[i])
+        {
+            perror("gpio: open failed.\n");
+            a_gpio_release();
+
+            return 1;
+        }
+        gs_line[i] = gpiod_chip_get_line(gs_chip[i], line[i].line);
+        if (!gs_line[i])
+        {
+            perror("gpio: get line failed.\n");
+            a_gpio_release();
+
+            return 1;
+        }
+        if (gpiod_line_request_falling_edge_events(gs_line[i], "gpiointerrupt") < 0)
+        {
+            perror("gpio: set falling edge events failed.\n");
+            gs_line[i] = NULL;
+            a_gpio_release();
+
+            return 1;
+        }
+        fd = gpiod_line_event_get_fd(gs_line[i]);
+        if ((fd < 0) || (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0))
+        {
+            perror("gpio: get line fd failed.\n");
+            a_gpio_release();
+
+            return 1;
+        }
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        if (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            perror("gpio: add line fd failed.\n");
+            a_gpio_release();
+
+            return 1;
+        }
+    }
+    if (a_gpio_thread_create() != 0)
     {
         perror("gpio: creat pthread failed.\n");
-        gpiod_chip_close(gs_chip);
+        a_gpio_release();
 
         return 1;
     }
+    gs_running = 1;
 
     return 0;
 }
 
+/**
+ * @brief  gpio interrupt init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   it watches the falling edge of line 17 on /dev/gpiochip0 and calls g_gpio_irq
+ */
+uint8_t gpio_interrupt_init(void)
+{
+    const gpio_interrupt_line_t line = {GPIO_DEVICE_NAME, GPIO_DEVICE_LINE};
+
+    return gpio_interrupt_init_lines(&line, 1, a_gpio_default_handler);
+}
+
 /**
  * @brief  gpio interrupt deinit
  * @return status code
  *         - 0 success
  *         - 1 deinit failed
- * @note   none
+ * @note   it wakes the reactor thread and joins it before releasing the lines
  */
 uint8_t gpio_interrupt_deinit(void)
 {
-    uint8_t res;
+    uint64_t value = 1;
 
-    res = pthread_cancel(gs_pid);
-    if (res)
+    if (gs_running == 0)
+    {
+        return 1;
+    }
+    if (write(gs_event_fd, &value, sizeof(value)) != (ssize_t)sizeof(value))
     {
-        perror("gpio: delete pthread failed.\n");
+        perror("gpio: signal eventfd failed.\n");
 
         return 1;
     }
-    gpiod_chip_close(gs_chip);
-    
+    if (pthread_join(gs_pid, NULL) != 0)
+    {
+        perror("gpio: join pthread failed.\n");
+
+        return 1;
+    }
+    gs_running = 0;
+    a_gpio_release();
+    if ((__atomic_load_n(&gs_latency.rt_applied, __ATOMIC_RELAXED) & GPIO_RT_FLAG_MLOCK) != 0)
+    {
+        (void)munlockall();
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     gpio interrupt set the rt config
+ * @param[in] *config points to an rt config structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 param is invalid
+ * @note      it takes effect on the next init, an rt feature that can't be applied is reported
+ *            by gpio_interrupt_get_latency instead of failing the init
+ */
+uint8_t gpio_interrupt_set_rt(const gpio_rt_config_t *config)
+{
+    if ((config == NULL) || (config->cpu < GPIO_RT_CPU_LAST) || (config->cpu >= CPU_SETSIZE) ||
+        ((config->enable != 0) && ((config->priority < sched_get_priority_min(SCHED_FIFO)) ||
+                                   (config->priority > sched_get_priority_max(SCHED_FIFO)))))
+    {
+        return 2;
+    }
+    gs_rt = *config;
+
+    return 0;
+}
+
+/**
+ * @brief      gpio interrupt get the latency histogram
+ * @param[out] *latency points to a latency structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 param is invalid
+ * @note       the histogram is always on and cleared on every init
+ */
+uint8_t gpio_interrupt_get_latency(gpio_latency_t *latency)
+{
+    uint32_t i;
+
+    if (latency == NULL)
+    {
+        return 2;
+    }
+    latency->count = __atomic_load_n(&gs_latency.count, __ATOMIC_ACQUIRE);
+    for (i = 0; i < GPIO_LATENCY_BUCKETS; i++)
+    {
+        latency->bucket[i] = __atomic_load_n(&gs_latency.bucket[i], __ATOMIC_RELAXED);
+    }
+    latency->skipped = __atomic_load_n(&gs_latency.skipped, __ATOMIC_RELAXED);
+    latency->sum_ns = __atomic_load_n(&gs_latency.sum_ns, __ATOMIC_RELAXED);
+    latency->max_ns = __atomic_load_n(&gs_latency.max_ns, __ATOMIC_RELAXED);
+    latency->rt_requested = gs_latency.rt_requested;
+    latency->rt_applied = __atomic_load_n(&gs_latency.rt_applied, __ATOMIC_RELAXED);
+
     return 0;
 }
@@ -172,9 +172,6 @@ uint8_t iic_read(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     struct i2c_rdwr_ioctl_data i2c_rdwr_data;
     struct i2c_msg msgs[2];
     
-    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));        /* clear ioctl data */
-    memset(msgs, 0, sizeof(struct i2c_msg) * 2);                          /* clear msgs data */
-
     msgs[0].addr = addr >> 1;                                             /* set iic addr */
     msgs[0].flags = 0;                                                    /* set write command */
     msgs[0].buf = &reg;                                                   /* set reg address */
@@ -322,3 +319,66 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
      
     return 0;                                                             /* success return 0 */
 }
+
+/**
+ * @brief     iic bus transfer batch
+ * @param[in] fd is the iic handle
+ * @param[in] addr is iic device write address
+ * @param[in] *seg points to a segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the read segments are packed as write register and read data message pairs
+ *            into I2C_RDWR ioctls of at most IIC_BATCH_MAX_MSGS messages,
+ *            a write segment flushes the pending pairs and runs on its own
+ */
+uint8_t iic_transfer_batch(int fd, uint8_t addr, iic_segment_t *seg, uint16_t num)
+{
+    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
+    struct i2c_msg msgs[IIC_BATCH_MAX_MSGS];
+    uint8_t reg[IIC_BATCH_MAX_MSGS / 2];
+    uint16_t i;
+    uint16_t n;
+    
+    n = 0;                                                                    /* no pending pair */
+    for (i = 0; i <= num; i++)                                                /* walk the segments and a final flush */
+    {
+        if ((n != 0) && ((i == num) || (seg[i].read == 0) || ((n + 2) > IIC_BATCH_MAX_MSGS)))    /* if flush */
+        {
+            i2c_rdwr_data.msgs = msgs;                                        /* set msgs */
+            i2c_rdwr_data.nmsgs = n;                                          /* set msgs number */
+            if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)                      /* read write command */
+            {
+                perror("iic: transfer batch failed.\n");                      /* transfer batch failed */
+                
+                return 1;                                                     /* return error */
+            }
+            n = 0;                                                            /* no pending pair */
+        }
+        if (i == num)                                                         /* if the end */
+        {
+            break;                                                            /* break */
+        }
+        if (seg[i].read == 0)                                                 /* write segment */
+        {
+            if (iic_write(fd, addr, seg[i].reg, seg[i].buf, seg[i].len) != 0) /* write data */
+            {
+                return 1;                                                     /* return error */
+            }
+            continue;                                                         /* next segment */
+        }
+        reg[n / 2] = seg[i].reg;                                              /* set reg address */
+        msgs[n].addr = addr >> 1;                                             /* set iic addr */
+        msgs[n].flags = 0;                                                    /* set write command */
+        msgs[n].buf = &reg[n / 2];                                            /* set reg address */
+        msgs[n].len = 1;                                                      /* set len 1 */
+        msgs[n + 1].addr = addr >> 1;                                         /* set iic addr */
+        msgs[n + 1].flags = I2C_M_RD;                                         /* set read command */
+        msgs[n + 1].buf = seg[i].buf;                                         /* read straight into the buffer */
+        msgs[n + 1].len = seg[i].len;                                         /* set read length */
+        n += 2;                                                               /* one more pair */
+    }
+    
+    return 0;                                                                 /* success return 0 */
+}
@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sample_ring.c
+ * @brief     sample ring source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sample_ring.h"
+#include <string.h>
+
+/**
+ * @brief     copy frames into the ring
+ * @param[in] *ring points to a sample ring structure
+ * @param[in] index is the free running start index
+ * @param[in] **g points to a frame buffer
+ * @param[in] len is the frame number
+ * @note      the copy is split at the end of the storage
+ */
+static void a_sample_ring_write(sample_ring_t *ring, uint32_t index, const float (*g)[3], uint32_t len)
+{
+    uint32_t pos;
+    uint32_t part;
+
+    pos = index & ring->mask;
+    part = ring->mask + 1 - pos;
+    part = (len < part) ? len : part;
+    memcpy(ring->frame[pos], g, sizeof(float[3]) * part);
+    memcpy(ring->frame[0], g[part], sizeof(float[3]) * (len - part));
+}
+
+/**
+ * @brief      copy frames out of the ring
+ * @param[in]  *ring points to a sample ring structure
+ * @param[in]  index is the free running start index
+ * @param[out] **g points to a frame buffer
+ * @param[in]  len is the frame number
+ * @note       the copy is split at the end of the storage
+ */
+static void a_sample_ring_read(sample_ring_t *ring, uint32_t index, float (*g)[3], uint32_t len)
+{
+    uint32_t pos;
+    uint32_t part;
+
+    pos = index & ring->mask;
+    part = ring->mask + 1 - pos;
+    part = (len < part) ? len : part;
+    memcpy(g, ring->frame[pos], sizeof(float[3]) * part);
+    memcpy(g[part], ring->frame[0], sizeof(float[3]) * (len - part));
+}
+
+/**
+ * @brief     sample ring init
+ * @param[in] *ring points to a sample ring structure
+ * @param[in] **frame points to a frame storage
+ * @param[in] capacity is the frame number of the storage
+ * @param[in] policy is the overflow policy
+ * @return    status code
+ *            - 0 success
+ *            - 1 capacity is not a power of two
+ * @note      none
+ */
+uint8_t sample_ring_init(sample_ring_t *ring, float (*frame)[3], uint32_t capacity, sample_ring_policy_t policy)
+{
+    if ((capacity == 0) || ((capacity & (capacity - 1)) != 0))
+    {
+        return 1;
+    }
+
+    memset(ring, 0, sizeof(sample_ring_t));
+    ring->frame = frame;
+    ring->mask = capacity - 1;
+    ring->policy = policy;
+
+    return 0;
+}
+
+/**
+ * @brief     sample ring push frames
+ * @param[in] *ring points to a sample ring structure
+ * @param[in] **g points to a frame buffer
+ * @param[in] len is the frame number
+ * @return    stored frame number
+ * @note      producer side only, it never waits for the consumer
+ */
+uint32_t sample_ring_push(sample_ring_t *ring, const float (*g)[3], uint32_t len)
+{
+    uint32_t head;
+    uint32_t tail;
+    uint32_t space;
+    uint32_t capacity;
+    uint32_t drop;
+
+    capacity = ring->mask + 1;
+    head = ring->head;
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (len > capacity)
+    {
+        __atomic_fetch_add(&ring->dropped, len - capacity, __ATOMIC_RELAXED);
+        if (ring->policy == SAMPLE_RING_DROP_OLDEST)
+        {
+            g = &g[len - capacity];
+        }
+        len = capacity;
+    }
+    space = capacity - (head - tail);
+    if (len > space)
+    {
+        if (ring->policy == SAMPLE_RING_DROP_NEWEST)
+        {
+            __atomic_fetch_add(&ring->dropped, len - space, __ATOMIC_RELAXED);
+            len = space;
+        }
+        else
+        {
+            /* claim the oldest frames, a racing pop either wins first or retries */
+            do
+            {
+                drop = len - (capacity - (head - tail));
+                if ((int32_t)drop <= 0)
+                {
+                    break;
+                }
+            } while (!__atomic_compare_exchange_n(&ring->tail, &tail, tail + drop, 0,
+                                                  __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+            if ((int32_t)drop > 0)
+            {
+                __atomic_fetch_add(&ring->dropped, drop, __ATOMIC_RELAXED);
+            }
+        }
+    }
+    if (len == 0)
+    {
+        return 0;
+    }
+    a_sample_ring_write(ring, head, g, len);
+    __atomic_store_n(&ring->head, head + len, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&ring->pushed, len, __ATOMIC_RELAXED);
+
+    return len;
+}
+
+/**
+ * @brief      sample ring pop frames
+ * @param[in]  *ring points to a sample ring structure
+ * @param[out] **g points to a frame buffer
+ * @param[in]  len is the max frame number
+ * @return     popped frame number
+ * @note       consumer side only
+ */
+uint32_t sample_ring_pop(sample_ring_t *ring, float (*g)[3], uint32_t len)
+{
+    uint32_t head;
+    uint32_t tail;
+    uint32_t cnt;
+
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    while (1)
+    {
+        head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        cnt = head - tail;
+        cnt = (len < cnt) ? len : cnt;
+        if (cnt == 0)
+        {
+            return 0;
+        }
+        a_sample_ring_read(ring, tail, g, cnt);
+
+        /* the producer may have overwritten the frames while they were copied */
+        if (__atomic_compare_exchange_n(&ring->tail, &tail, tail + cnt, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            break;
+        }
+    }
+    __atomic_fetch_add(&ring->popped, cnt, __ATOMIC_RELAXED);
+
+    return cnt;
+}
+
+/**
+ * @brief      sample ring get the counters
+ * @param[in]  *ring points to a sample ring structure
+ * @param[out] *pushed points to a pushed frame number buffer
+ * @param[out] *popped points to a popped frame number buffer
+ * @param[out] *dropped points to a dropped frame number buffer
+ * @note       it can be called from any thread
+ */
+void sample_ring_get_counter(sample_ring_t *ring, uint64_t *pushed, uint64_t *popped, uint64_t *dropped)
+{
+    *pushed = __atomic_load_n(&ring->pushed, __ATOMIC_RELAXED);
+    *popped = __atomic_load_n(&ring->popped, __ATOMIC_RELAXED);
+    *dropped = __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+}
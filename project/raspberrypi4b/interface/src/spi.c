@@ -36,6 +36,37 @@
 
 #include "spi.h"
 
+/**
+ * @brief spi persistent transfer definition
+ * @note  per thread, so the irq and the async worker threads never share the descriptors
+ */
+static __thread struct spi_ioc_transfer gs_xfer[SPI_SEGMENT_MAX * 2];        /**< command and data descriptor pairs */
+static __thread uint8_t gs_cmd[SPI_SEGMENT_MAX];                             /**< command bytes */
+static __thread uint8_t gs_xfer_inited;                                      /**< descriptors inited flag */
+
+/**
+ * @brief  spi get the persistent descriptors
+ * @return pointer to the descriptors
+ * @note   the command descriptors are pre-initialised once, a call only sets the command bytes and data pointers
+ */
+static struct spi_ioc_transfer *a_spi_xfer(void)
+{
+    uint16_t i;
+
+    if (gs_xfer_inited == 0)                                                 /* if not inited */
+    {
+        memset(gs_xfer, 0, sizeof(gs_xfer));                                 /* clear ioc transfer */
+        for (i = 0; i < SPI_SEGMENT_MAX; i++)                                /* set all command descriptors */
+        {
+            gs_xfer[i * 2].tx_buf = (unsigned long) &gs_cmd[i];              /* set command buffer */
+            gs_xfer[i * 2].len = 1;                                          /* one command byte */
+        }
+        gs_xfer_inited = 1;                                                  /* flag inited */
+    }
+
+    return gs_xfer;                                                          /* return descriptors */
+}
+
 /**
  * @brief      spi bus init
  * @param[in]  *name points to a spi device name buffer
@@ -182,26 +213,23 @@ uint8_t spi_read_cmd(int fd, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_read(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 1];
-    uint8_t recv[len + 1];
+    struct spi_ioc_transfer *k;
     int l;
 
-    command[0] = reg;                                      /* set reg */
-    memset(&command[1], 0x00, len);                        /* clear the rest */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));        /* clear ioc transfer */
-    k.tx_buf = (unsigned long) command;                    /* set command buffer */
-    k.rx_buf = (unsigned long) recv;                       /* set recv buffer */
-    k.len = len + 1;                                       /* set written length */
-    k.cs_change = 0;                                       /* enable cs change */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);                 /* send data */
-    if (l != k.len)                                        /* check length */
+    k = a_spi_xfer();                                      /* get descriptors */
+    gs_cmd[0] = reg;                                       /* set reg */
+    k[1].tx_buf = 0;                                       /* clock out zeros */
+    k[1].rx_buf = (unsigned long) buf;                     /* read straight into the buffer */
+    k[1].len = len;                                        /* set read length */
+    k[1].delay_usecs = 0;                                  /* no delay */
+    k[1].cs_change = 0;                                    /* release cs at the end */
+    l = ioctl(fd, SPI_IOC_MESSAGE(2), k);                  /* send data */
+    if (l != len + 1)                                      /* check length */
     {
         perror("spi: length check error.\n");              /* length check error */
 
         return 1;                                          /* return error */
     }
-    memcpy(buf, recv + 1, len);                            /* copy data */
 
     return 0;                                              /* success return 0 */
 }
@@ -269,3 +297,58 @@ uint8_t spi_write(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
 
     return 0;                                              /* success return 0 */
 }
+
+/**
+ * @brief     spi bus transfer
+ * @param[in] fd is the spi handle
+ * @param[in] *seg points to a segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      all segments go out in one SPI_IOC_MESSAGE, chip select is released between the segments,
+ *            num <= SPI_SEGMENT_MAX, the data is transferred straight from and into the segment buffers
+ */
+uint8_t spi_transfer(int fd, spi_segment_t *seg, uint16_t num)
+{
+    struct spi_ioc_transfer *k;
+    uint16_t i;
+    int total;
+    int l;
+
+    if ((num == 0) || (num > SPI_SEGMENT_MAX))                               /* check num */
+    {
+        perror("spi: segment number is invalid.\n");                         /* segment number is invalid */
+
+        return 1;                                                            /* return error */
+    }
+    k = a_spi_xfer();                                                        /* get descriptors */
+    total = 0;                                                               /* init 0 */
+    for (i = 0; i < num; i++)                                                /* set all segments */
+    {
+        gs_cmd[i] = seg[i].cmd;                                              /* set command */
+        if (seg[i].read != 0)                                                /* read segment */
+        {
+            k[i * 2 + 1].tx_buf = 0;                                         /* clock out zeros */
+            k[i * 2 + 1].rx_buf = (unsigned long) seg[i].buf;                /* read straight into the buffer */
+        }
+        else                                                                 /* write segment */
+        {
+            k[i * 2 + 1].tx_buf = (unsigned long) seg[i].buf;                /* write straight from the buffer */
+            k[i * 2 + 1].rx_buf = 0;                                         /* discard the rx bytes */
+        }
+        k[i * 2 + 1].len = seg[i].len;                                       /* set data length */
+        k[i * 2 + 1].delay_usecs = seg[i].delay_us;                          /* delay after the segment */
+        k[i * 2 + 1].cs_change = (i != (num - 1)) ? 1 : 0;                   /* release cs between the segments */
+        total += seg[i].len + 1;                                             /* count bytes */
+    }
+    l = ioctl(fd, SPI_IOC_MESSAGE(num * 2), k);                              /* send data */
+    if (l != total)                                                          /* check length */
+    {
+        perror("spi: length check error.\n");                                /* length check error */
+
+        return 1;                                                            /* return error */
+    }
+
+    return 0;                                                                /* success return 0 */
+}
@@ -38,14 +38,18 @@
 #include "driver_adxl345_fifo_test.h"
 #include "driver_adxl345_read_test.h"
 #include "driver_adxl345_register_test.h"
+#include "driver_adxl345_decode_test.h"
 #include "driver_adxl345_interrupt.h"
 #include "driver_adxl345_fifo.h"
 #include "driver_adxl345_basic.h"
 #include "gpio.h"
+#include "sample_ring.h"
 #include <stdlib.h>
 
-uint8_t g_flag;                            /**< interrupt flag */
 uint8_t (*g_gpio_irq)(void) = NULL;        /**< gpio irq function address */
+static float gs_ring_frame[256][3];        /**< sample ring storage */
+static sample_ring_t gs_ring;              /**< sample ring between the irq thread and the main thread */
+static float gs_g[32][3];                  /**< consumer buffer */
 
 /**
  * @brief     fifo callback
@@ -55,7 +59,56 @@ uint8_t (*g_gpio_irq)(void) = NULL;        /**< gpio irq function address */
  */
 static void a_fifo_callback(float (*g)[3], uint16_t len)
 {
-    g_flag = 1;
+    /* runs on the irq thread, hand the frames over without waiting */
+    (void)sample_ring_push(&gs_ring, (const float (*)[3])g, len);
+}
+
+/**
+ * @brief print the gpio edge to drain complete latency
+ * @note  none
+ */
+static void a_latency_print(void)
+{
+    gpio_latency_t latency;
+    uint32_t i;
+
+    if (gpio_interrupt_get_latency(&latency) != 0)
+    {
+        return;
+    }
+    if (latency.rt_requested == 0)
+    {
+        adxl345_interface_debug_print("adxl345: rt mode is off.\n");
+    }
+    else if (latency.rt_applied != latency.rt_requested)
+    {
+        adxl345_interface_debug_print("adxl345: rt mode is unavailable, sched %s, affinity %s, mlock %s, prefault %s.\n",
+                                      (latency.rt_applied & GPIO_RT_FLAG_SCHED) ? "on" : "off",
+                                      (latency.rt_applied & GPIO_RT_FLAG_AFFINITY) ? "on" : "off",
+                                      (latency.rt_applied & GPIO_RT_FLAG_MLOCK) ? "on" : "off",
+                                      (latency.rt_applied & GPIO_RT_FLAG_PREFAULT) ? "on" : "off");
+    }
+    else
+    {
+        adxl345_interface_debug_print("adxl345: rt mode is on.\n");
+    }
+    if (latency.count == 0)
+    {
+        adxl345_interface_debug_print("adxl345: no edge latency.\n");
+        
+        return;
+    }
+    adxl345_interface_debug_print("adxl345: edge to drain latency %d edges, avg %0.1fus, max %0.1fus, skipped %d.\n",
+                                  latency.count, (double)latency.sum_ns / latency.count / 1000.0,
+                                  (double)latency.max_ns / 1000.0, latency.skipped);
+    for (i = 0; i < GPIO_LATENCY_BUCKETS; i++)
+    {
+        if (latency.bucket[i] != 0)
+        {
+            adxl345_interface_debug_print("adxl345: %s%dus %d.\n", (i == GPIO_LATENCY_BUCKETS - 1) ? ">= " : "< ",
+                                          (i == GPIO_LATENCY_BUCKETS - 1) ? (1 << i) : (2 << i), latency.bucket[i]);
+        }
+    }
 }
 
 /**
@@ -176,8 +229,10 @@ uint8_t adxl345(uint8_t argc, char **argv)
             adxl345_interface_debug_print("adxl345 -t read <times> (-iic (0 | 1) | -spi)\n\trun adxl345 read test.times means the test times.\n");
             adxl345_interface_debug_print("adxl345 -t fifo (-iic (0 | 1) | -spi)\n\trun adxl345 fifo test.\n");
             adxl345_interface_debug_print("adxl345 -t int (-iic (0 | 1) | -spi)\n\trun adxl345 interrupt test.\n");
+            adxl345_interface_debug_print("adxl345 -t decode <times>\n\trun adxl345 decode test.times means the benchmark times.\n");
             adxl345_interface_debug_print("adxl345 -c basic <times> (-iic (0 | 1) | -spi)\n\trun adxl345 basic function.times is the read times.\n");
-            adxl345_interface_debug_print("adxl345 -c fifo <times> (-iic (0 | 1) | -spi)\n\trun adxl345 fifo function.times is the read times.\n");
+            adxl345_interface_debug_print("adxl345 -c fifo <times> (-iic (0 | 1) | -spi) [-rt]\n\trun adxl345 fifo function.times is the read times."
+                                          "-rt runs the gpio thread in real-time mode.\n");
             adxl345_interface_debug_print("adxl345 -c int (-iic (0 | 1) | -spi) <mask>\n\trun adxl345 interrupt function.mask is the interrupt mask."
                                           "bit 0 is the tap enable mask.bit 1 is the action enable mask.");
             adxl345_interface_debug_print("bit 2 is the inaction enable mask.bit 3 is the free fall enable mask.\n");
@@ -277,6 +332,19 @@ uint8_t adxl345(uint8_t argc, char **argv)
                     return 5;
                 }
             }
+            else if (strcmp("decode", argv[2]) == 0)
+            {
+                uint8_t res;
+                
+                /* run decode test */
+                res = adxl345_decode_test(atoi(argv[3]));
+                if (res != 0)
+                {
+                    return 1;
+                }
+                
+                return 0;
+            }
             else
             {
                 return 5;
@@ -506,7 +574,7 @@ uint8_t adxl345(uint8_t argc, char **argv)
                         return 1;
                     }
                     g_gpio_irq = adxl345_fifo_irq_handler;
-                    g_flag = 0;
+                    (void)sample_ring_init(&gs_ring, gs_ring_frame, 256, SAMPLE_RING_DROP_OLDEST);
                     res = adxl345_fifo_init(ADXL345_INTERFACE_SPI, ADXL345_ADDRESS_ALT_0, a_fifo_callback);
                     if (res != 0)
                     {
@@ -518,12 +586,12 @@ uint8_t adxl345(uint8_t argc, char **argv)
                     timeout = 500;
                     while (times != 0)
                     {
-                        if (g_flag != 0)
+                        if (sample_ring_pop(&gs_ring, gs_g, 32) != 0)
                         {
                             adxl345_interface_debug_print("adxl345: fifo read %d.\n", times);
-                            g_flag = 0;
                             timeout = 500;
                             times--;
+                            continue;
                         }
                         timeout--;
                         if (timeout == 0)
@@ -537,6 +605,7 @@ uint8_t adxl345(uint8_t argc, char **argv)
                         }
                         adxl345_interface_delay_ms(10);
                     }
+                    a_latency_print();
                     
                     (void)gpio_interrupt_deinit();
                     (void)adxl345_fifo_deinit();
@@ -743,7 +812,7 @@ uint8_t adxl345(uint8_t argc, char **argv)
                         return 1;
                     }
                     g_gpio_irq = adxl345_fifo_irq_handler;
-                    g_flag = 0;
+                    (void)sample_ring_init(&gs_ring, gs_ring_frame, 256, SAMPLE_RING_DROP_OLDEST);
                     res = adxl345_fifo_init(ADXL345_INTERFACE_IIC, addr_pin, a_fifo_callback);
                     if (res != 0)
                     {
@@ -755,12 +824,12 @@ uint8_t adxl345(uint8_t argc, char **argv)
                     timeout = 500;
                     while (times != 0)
                     {
-                        if (g_flag != 0)
+                        if (sample_ring_pop(&gs_ring, gs_g, 32) != 0)
                         {
                             adxl345_interface_debug_print("adxl345: fifo read %d.\n", times);
-                            g_flag = 0;
                             timeout = 500;
                             times--;
+                            continue;
                         }
                         timeout--;
                         if (timeout == 0)
@@ -774,6 +843,7 @@ uint8_t adxl345(uint8_t argc, char **argv)
                         }
                         adxl345_interface_delay_ms(10);
                     }
+                    a_latency_print();
                     
                     (void)gpio_interrupt_deinit();
                     (void)adxl345_fifo_deinit();
@@ -879,6 +949,15 @@ int main(uint8_t argc, char **argv)
 {
     uint8_t res;
 
+    /* a trailing -rt of the fifo function enables the gpio real-time mode */
+    if ((argc > 3) && (strcmp("-c", argv[1]) == 0) && (strcmp("fifo", argv[2]) == 0) &&
+        (strcmp("-rt", argv[argc - 1]) == 0))
+    {
+        gpio_rt_config_t rt = {1, 80, GPIO_RT_CPU_LAST};
+        
+        (void)gpio_interrupt_set_rt(&rt);
+        argc--;
+    }
     res = adxl345(argc, argv);
     if (res == 0)
     {
@@ -0,0 +1,366 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      adxl345_trace.c
+ * @brief     adxl345 bus trace analyzer source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define ADXL345_TRACE
+#include "driver_adxl345.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/**
+ * @brief api statistics structure definition
+ */
+typedef struct trace_api_s
+{
+    uint32_t tag;                 /**< api tag */
+    char name[64];                /**< resolved api name */
+    uint32_t reads;               /**< read transactions */
+    uint32_t writes;              /**< write transactions */
+    uint32_t bytes;               /**< payload bytes */
+    uint32_t redundant;           /**< redundant config re-reads */
+    uint64_t busy_us;             /**< bus time */
+} trace_api_t;
+
+static trace_api_t gs_api[256];          /**< api table */
+static uint32_t gs_api_num;              /**< api number */
+
+/**
+ * @brief     hash an api name
+ * @param[in] *name points to an api name
+ * @param[in] len is the name length
+ * @return    32 bits fnv-1a hash, the same as the driver tag
+ * @note      none
+ */
+static uint32_t a_trace_hash(const char *name, size_t len)
+{
+    uint32_t hash = 2166136261U;
+    size_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619U;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief     find or add an api entry
+ * @param[in] tag is the api tag
+ * @return    pointer to the entry, NULL if the table is full
+ * @note      none
+ */
+static trace_api_t *a_trace_api(uint32_t tag)
+{
+    uint32_t i;
+
+    for (i = 0; i < gs_api_num; i++)
+    {
+        if (gs_api[i].tag == tag)
+        {
+            return &gs_api[i];
+        }
+    }
+    if (gs_api_num >= sizeof(gs_api) / sizeof(gs_api[0]))
+    {
+        return NULL;
+    }
+    memset(&gs_api[gs_api_num], 0, sizeof(trace_api_t));
+    gs_api[gs_api_num].tag = tag;
+    (void)snprintf(gs_api[gs_api_num].name, sizeof(gs_api[gs_api_num].name), "0x%08X", (unsigned int)tag);
+
+    return &gs_api[gs_api_num++];
+}
+
+/**
+ * @brief     resolve the api names from the driver header
+ * @param[in] *path points to the header path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      every adxl345_* identifier followed by '(' is hashed
+ */
+static uint8_t a_trace_resolve(const char *path)
+{
+    FILE *fp;
+    char line[512];
+
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        char *p = line;
+
+        while ((p = strstr(p, "adxl345_")) != NULL)
+        {
+            size_t len = 0;
+            uint32_t i;
+            uint32_t tag;
+
+            if ((p != line) && (isalnum((unsigned char)p[-1]) || (p[-1] == '_')))
+            {
+                p++;
+                continue;
+            }
+            while (isalnum((unsigned char)p[len]) || (p[len] == '_'))
+            {
+                len++;
+            }
+            if ((p[len] == '(') && (len < sizeof(gs_api[0].name)))
+            {
+                tag = a_trace_hash(p, len);
+                for (i = 0; i < gs_api_num; i++)
+                {
+                    if (gs_api[i].tag == tag)
+                    {
+                        memcpy(gs_api[i].name, p, len);
+                        gs_api[i].name[len] = '\0';
+                    }
+                }
+            }
+            p += len;
+        }
+    }
+    (void)fclose(fp);
+
+    return 0;
+}
+
+/**
+ * @brief     check whether a register is a cacheable config register
+ * @param[in] reg is the register address
+ * @return    check result
+ *            - 0 not config
+ *            - 1 config
+ * @note      none
+ */
+static uint8_t a_trace_is_config(uint16_t reg)
+{
+    return (uint8_t)(((reg >= 0x1D) && (reg <= 0x2A)) || ((reg >= 0x2C) && (reg <= 0x2F)) ||
+                     (reg == 0x31) || (reg == 0x38));
+}
+
+/**
+ * @brief     analyzer main
+ * @param[in] argc is arg numbers
+ * @param[in] **argv is the arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      usage: adxl345_trace <trace file> [driver_adxl345.h]
+ *            the trace file is the record array read by adxl345_trace_read, oldest first
+ */
+int main(int argc, char **argv)
+{
+    FILE *fp;
+    adxl345_trace_record_t *record;
+    long size;
+    uint32_t num;
+    uint32_t i;
+    uint32_t calls;
+    uint32_t failed;
+    uint32_t redundant;
+    uint64_t busy_us;
+    uint64_t span_us;
+    uint64_t gap_sum;
+    uint32_t gap_min;
+    uint32_t gap_max;
+    uint32_t gap_hist[5];
+    uint8_t read_valid[64];
+    static const char *const gap_name[5] = {"< 10us", "< 100us", "< 1ms", "< 10ms", ">= 10ms"};
+
+    if (argc < 2)
+    {
+        printf("usage: %s <trace file> [driver_adxl345.h]\n", argv[0]);
+
+        return 1;
+    }
+
+    /* load the records */
+    fp = fopen(argv[1], "rb");
+    if (fp == NULL)
+    {
+        printf("adxl345_trace: open %s failed.\n", argv[1]);
+
+        return 1;
+    }
+    (void)fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    (void)fseek(fp, 0, SEEK_SET);
+    num = (uint32_t)(size / (long)sizeof(adxl345_trace_record_t));
+    if (num == 0)
+    {
+        printf("adxl345_trace: no record.\n");
+        (void)fclose(fp);
+
+        return 1;
+    }
+    record = (adxl345_trace_record_t *)malloc(sizeof(adxl345_trace_record_t) * num);
+    if ((record == NULL) || (fread(record, sizeof(adxl345_trace_record_t), num, fp) != num))
+    {
+        printf("adxl345_trace: read %s failed.\n", argv[1]);
+        free(record);
+        (void)fclose(fp);
+
+        return 1;
+    }
+    (void)fclose(fp);
+
+    /* walk the records */
+    calls = 0;
+    failed = 0;
+    redundant = 0;
+    busy_us = 0;
+    gap_sum = 0;
+    gap_min = 0xFFFFFFFFU;
+    gap_max = 0;
+    memset(gap_hist, 0, sizeof(gap_hist));
+    memset(read_valid, 0, sizeof(read_valid));
+    for (i = 0; i < num; i++)
+    {
+        adxl345_trace_record_t *r = &record[i];
+        trace_api_t *api = a_trace_api(r->api);
+        uint8_t same_call;
+        uint16_t reg;
+        uint16_t n;
+
+        /* segments of one transfer call share the start and end time */
+        same_call = (uint8_t)((i != 0) && ((r->flag & ADXL345_TRACE_FLAG_BATCH) != 0) &&
+                              ((record[i - 1].flag & ADXL345_TRACE_FLAG_BATCH) != 0) &&
+                              (record[i - 1].start_us == r->start_us) && (record[i - 1].end_us == r->end_us));
+        if (same_call == 0)
+        {
+            uint32_t t = r->end_us - r->start_us;
+
+            calls++;
+            busy_us += t;
+            if (api != NULL)
+            {
+                api->busy_us += t;
+            }
+            if (i != 0)
+            {
+                uint32_t gap = r->start_us - record[i - 1].end_us;
+
+                gap = (gap > 0x80000000U) ? 0 : gap;
+                gap_sum += gap;
+                gap_min = (gap < gap_min) ? gap : gap_min;
+                gap_max = (gap > gap_max) ? gap : gap_max;
+                gap_hist[(gap < 10) ? 0 : (gap < 100) ? 1 : (gap < 1000) ? 2 : (gap < 10000) ? 3 : 4]++;
+            }
+        }
+        if ((r->flag & ADXL345_TRACE_FLAG_FAILED) != 0)
+        {
+            failed++;
+        }
+        if (api != NULL)
+        {
+            if ((r->flag & ADXL345_TRACE_FLAG_READ) != 0)
+            {
+                api->reads++;
+            }
+            else
+            {
+                api->writes++;
+            }
+            api->bytes += r->len;
+        }
+
+        /* a config read is redundant if no write touched the register since the last read */
+        for (n = 0; n < r->len; n++)
+        {
+            reg = (uint16_t)(r->reg + n);
+            if ((reg >= 64) || (a_trace_is_config(reg) == 0))
+            {
+                continue;
+            }
+            if ((r->flag & ADXL345_TRACE_FLAG_READ) == 0)
+            {
+                read_valid[reg] = 0;
+            }
+            else if (read_valid[reg] != 0)
+            {
+                redundant++;
+                if (api != NULL)
+                {
+                    api->redundant++;
+                }
+            }
+            else
+            {
+                read_valid[reg] = 1;
+            }
+        }
+    }
+    span_us = (uint32_t)(record[num - 1].end_us - record[0].start_us);
+    if (argc > 2)
+    {
+        if (a_trace_resolve(argv[2]) != 0)
+        {
+            printf("adxl345_trace: open %s failed.\n", argv[2]);
+        }
+    }
+
+    /* report */
+    printf("records: %u, bus calls: %u, failed: %u.\n", (unsigned int)num, (unsigned int)calls, (unsigned int)failed);
+    printf("span: %llu us, bus busy: %llu us, utilisation: %.1f%%.\n",
+           (unsigned long long)span_us, (unsigned long long)busy_us,
+           (span_us != 0) ? (100.0 * (double)busy_us / (double)span_us) : 0.0);
+    if (calls > 1)
+    {
+        printf("gap: min %u us, avg %.1f us, max %u us.\n", (unsigned int)gap_min,
+               (double)gap_sum / (double)(calls - 1), (unsigned int)gap_max);
+        for (i = 0; i < 5; i++)
+        {
+            printf("  %-8s %u\n", gap_name[i], (unsigned int)gap_hist[i]);
+        }
+    }
+    printf("redundant config register reads: %u.\n", (unsigned int)redundant);
+    printf("%-40s %8s %8s %8s %10s %10s\n", "api", "reads", "writes", "bytes", "redundant", "busy(us)");
+    for (i = 0; i < gs_api_num; i++)
+    {
+        printf("%-40s %8u %8u %8u %10u %10llu\n", gs_api[i].name, (unsigned int)gs_api[i].reads,
+               (unsigned int)gs_api[i].writes, (unsigned int)gs_api[i].bytes,
+               (unsigned int)gs_api[i].redundant, (unsigned long long)gs_api[i].busy_us);
+    }
+    free(record);
+
+    return 0;
+}
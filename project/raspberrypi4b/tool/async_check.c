@@ -0,0 +1,471 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      async_check.c
+ * @brief     async read state machine check against a mock register file source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345.h"
+#include "async_worker.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static uint8_t gs_reg[64];                  /**< mock register file */
+static int16_t gs_fifo[33][3];              /**< mock fifo entries */
+static uint32_t gs_fifo_num;                /**< mock fifo entry number */
+static uint32_t gs_reads;                   /**< mock read number */
+static uint32_t gs_fail_at;                 /**< failing read number, 0 for none */
+static uint8_t gs_probe;                    /**< probe the driver from the first read in flight */
+static uint8_t gs_probe_read;               /**< adxl345_read result while in flight */
+static uint8_t gs_probe_irq;                /**< adxl345_irq_handler result while in flight */
+static uint8_t gs_probe_reg;                /**< adxl345_get_reg result while in flight */
+static uint8_t gs_probe_deinit;             /**< adxl345_deinit result while in flight */
+static uint32_t gs_probe_reads;             /**< bus reads made by the probe calls */
+static uint32_t gs_irqs;                    /**< receive callback number */
+static uint32_t gs_irqs_at_done;            /**< receive callback number when the async callback ran */
+static volatile uint8_t gs_called;          /**< async callback flag */
+static volatile uint8_t gs_done;            /**< completion returned after the callback */
+static uint8_t gs_res;                      /**< async callback result */
+static uint16_t gs_len;                     /**< async callback length */
+static uint8_t gs_frame[33 * 6];            /**< async frame buffer */
+static adxl345_handle_t gs_handle;          /**< adxl345 handle */
+static async_worker_t gs_worker;            /**< async worker */
+
+/**
+ * @brief     mock fill the fifo
+ * @param[in] num is the entry number
+ * @note      num <= 32
+ */
+static void a_mock_fill(uint32_t num)
+{
+    uint32_t i;
+
+    for (i = 0; i < 33; i++)
+    {
+        gs_fifo[i][0] = (int16_t)(i * 3);
+        gs_fifo[i][1] = (int16_t)(-(int32_t)i);
+        gs_fifo[i][2] = (int16_t)(100 + i);
+    }
+    gs_fifo_num = num;
+    gs_reg[0x39] = (uint8_t)num;
+}
+
+/**
+ * @brief      mock blocking iic read
+ * @param[in]  addr is the iic address
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a read through 0x37 pops one fifo entry, in bypass mode the output registers stay
+ */
+static uint8_t a_mock_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+
+    (void)addr;
+    gs_reads++;
+    if ((gs_fail_at != 0) && (gs_reads == gs_fail_at))
+    {
+        return 1;
+    }
+    for (i = 0; i < len; i++)
+    {
+        uint8_t r = (uint8_t)((reg + i) & 0x3F);
+
+        if ((r >= 0x32) && (r <= 0x37))
+        {
+            int16_t v = (gs_fifo_num != 0) ? gs_fifo[0][(r - 0x32) / 2] : 0;
+
+            buf[i] = ((r & 0x01) != 0) ? (uint8_t)((uint16_t)v >> 8) : (uint8_t)v;
+        }
+        else
+        {
+            buf[i] = gs_reg[r];
+        }
+    }
+    if ((reg <= 0x37) && ((reg + len) > 0x37) && ((gs_reg[0x38] >> 6) != 0) && (gs_fifo_num != 0))
+    {
+        memmove(gs_fifo[0], gs_fifo[1], sizeof(gs_fifo[0]) * 32);
+        gs_fifo_num--;
+        gs_reg[0x39] = (uint8_t)gs_fifo_num;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      mock async iic read
+ * @param[in]  addr is the iic address
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @param[in]  *handle points to an adxl345 handle
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_mock_read_async(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, adxl345_handle_t *handle)
+{
+    return async_worker_submit(&gs_worker, addr, reg, buf, len, handle);
+}
+
+/**
+ * @brief     worker read
+ * @param[in] addr is the iic address
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      the first probed read calls the driver while the chain is in flight
+ */
+static uint8_t a_worker_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (gs_probe != 0)
+    {
+        int16_t raw[1][3];
+        uint16_t n = 1;
+        uint8_t id;
+        uint32_t reads = gs_reads;
+
+        gs_probe = 0;
+        gs_probe_read = adxl345_read(&gs_handle, raw, NULL, &n);
+        gs_probe_irq = adxl345_irq_handler(&gs_handle);
+        gs_probe_reg = adxl345_get_reg(&gs_handle, 0x00, &id, 1);
+        gs_probe_deinit = adxl345_deinit(&gs_handle);
+        gs_probe_reads = gs_reads - reads;
+    }
+
+    return a_mock_read(addr, reg, buf, len);
+}
+
+/**
+ * @brief     worker completion
+ * @param[in] *arg points to an adxl345 handle
+ * @param[in] res is the read result
+ * @note      the run is done once the callback and a deferred irq have returned
+ */
+static void a_worker_complete(void *arg, uint8_t res)
+{
+    (void)adxl345_async_complete((adxl345_handle_t *)arg, res);
+    gs_done = gs_called;
+}
+
+/**
+ * @brief     async callback
+ * @param[in] *handle points to an adxl345 handle
+ * @param[in] res is the read result
+ * @param[in] **raw points to the raw data buffer
+ * @param[in] **g points to the converted data buffer
+ * @param[in] len is the read sample number
+ * @note      none
+ */
+static void a_async_callback(adxl345_handle_t *handle, uint8_t res, int16_t (*raw)[3], float (*g)[3], uint16_t len)
+{
+    (void)handle;
+    (void)raw;
+    (void)g;
+    gs_res = res;
+    gs_len = len;
+    gs_irqs_at_done = gs_irqs;
+    gs_called = 1;
+}
+
+/**
+ * @brief     mock iic write
+ * @param[in] addr is the iic address
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_mock_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    memcpy(&gs_reg[reg & 0x3F], buf, len);
+
+    return 0;
+}
+
+/**
+ * @brief      mock spi read
+ * @param[in]  reg is the register address with the spi flags
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       only linked for the init checks
+ */
+static uint8_t a_mock_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return a_mock_read(0, reg & 0x3F, buf, len);
+}
+
+/**
+ * @brief     mock spi write
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ * @note      only linked for the init checks
+ */
+static uint8_t a_mock_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return a_mock_write(0, reg, buf, len);
+}
+
+/**
+ * @brief  mock bus init and deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_mock_bus(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     mock delay ms
+ * @param[in] ms is the time
+ * @note      none
+ */
+static void a_mock_delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+/**
+ * @brief     mock debug print
+ * @param[in] fmt is the format data
+ * @note      driver messages are hidden
+ */
+static void a_mock_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     mock receive callback
+ * @param[in] type is the irq type
+ * @note      none
+ */
+static void a_mock_receive_callback(uint8_t type)
+{
+    (void)type;
+    gs_irqs++;
+}
+
+/**
+ * @brief         run one async read and the reference sync read on the same fifo
+ * @param[in]     fill is the fifo entry number
+ * @param[in]     len is the requested sample number
+ * @param[in]     irq is 1 to run the irq handler before the read
+ * @param[out]    **raw points to the async raw buffer
+ * @param[out]    **ref points to the sync raw buffer
+ * @param[out]    *ref_len points to the sync length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 run failed
+ * @note          none
+ */
+static uint8_t a_check_run(uint32_t fill, uint16_t len, uint8_t irq, int16_t (*raw)[3], int16_t (*ref)[3], uint16_t *ref_len)
+{
+    uint32_t timeout;
+
+    a_mock_fill(fill);
+    if (irq != 0)
+    {
+        gs_reg[0x30] = 0x82;
+        if (adxl345_irq_handler(&gs_handle) != 0)
+        {
+            return 1;
+        }
+    }
+    gs_called = 0;
+    gs_done = 0;
+    if (adxl345_read_async(&gs_handle, gs_frame, raw, NULL, len, a_async_callback) != 0)
+    {
+        return 1;
+    }
+    for (timeout = 0; (gs_done == 0) && (timeout < 100000); timeout++)
+    {
+        usleep(10);
+    }
+    if (gs_done == 0)
+    {
+        return 1;
+    }
+
+    /* reference read on the same fifo content */
+    gs_fail_at = 0;
+    a_mock_fill(fill);
+    if (irq != 0)
+    {
+        gs_reg[0x30] = 0x82;
+        (void)adxl345_irq_handler(&gs_handle);
+    }
+    *ref_len = len;
+    if (adxl345_read(&gs_handle, ref, NULL, ref_len) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  check main
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   covers bypass, fifo with and without a pending irq sample, a failed read in the chain
+ *         and the apis refused while the chain is in flight
+ */
+int main(void)
+{
+    int16_t raw[33][3];
+    int16_t ref[33][3];
+    uint16_t ref_len;
+    uint32_t fail;
+
+    DRIVER_ADXL345_LINK_INIT(&gs_handle, adxl345_handle_t);
+    DRIVER_ADXL345_LINK_IIC_INIT(&gs_handle, a_mock_bus);
+    DRIVER_ADXL345_LINK_IIC_DEINIT(&gs_handle, a_mock_bus);
+    DRIVER_ADXL345_LINK_IIC_READ(&gs_handle, a_mock_read);
+    DRIVER_ADXL345_LINK_IIC_WRITE(&gs_handle, a_mock_write);
+    DRIVER_ADXL345_LINK_IIC_READ_ASYNC(&gs_handle, a_mock_read_async);
+    DRIVER_ADXL345_LINK_SPI_INIT(&gs_handle, a_mock_bus);
+    DRIVER_ADXL345_LINK_SPI_DEINIT(&gs_handle, a_mock_bus);
+    DRIVER_ADXL345_LINK_SPI_READ(&gs_handle, a_mock_spi_read);
+    DRIVER_ADXL345_LINK_SPI_WRITE(&gs_handle, a_mock_spi_write);
+    DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, a_mock_delay_ms);
+    DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, a_mock_debug_print);
+    DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, a_mock_receive_callback);
+    gs_reg[0x00] = 0xE5;
+    if ((adxl345_set_interface(&gs_handle, ADXL345_INTERFACE_IIC) != 0) ||
+        (adxl345_set_addr_pin(&gs_handle, ADXL345_ADDRESS_ALT_0) != 0) ||
+        (adxl345_init(&gs_handle) != 0) ||
+        (async_worker_init(&gs_worker, a_worker_read, a_worker_complete) != 0))
+    {
+        printf("async_check: init failed.\n");
+
+        return 1;
+    }
+    fail = 0;
+
+    /* bypass */
+    (void)adxl345_set_mode(&gs_handle, ADXL345_MODE_BYPASS);
+    if ((a_check_run(1, 16, 0, raw, ref, &ref_len) != 0) || (gs_res != 0) || (gs_len != 1) ||
+        (ref_len != 1) || (memcmp(raw, ref, sizeof(raw[0])) != 0))
+    {
+        printf("bypass: FAIL.\n");
+        fail++;
+    }
+    else
+    {
+        printf("bypass: 1 sample.\n");
+    }
+
+    /* fifo, probing the driver from inside the chain */
+    (void)adxl345_set_mode(&gs_handle, ADXL345_MODE_STREAM);
+    gs_irqs = 0;
+    gs_reg[0x30] = 0x80;
+    gs_probe = 1;
+    if ((a_check_run(21, 16, 0, raw, ref, &ref_len) != 0) || (gs_res != 0) || (gs_len != 16) ||
+        (ref_len != 16) || (memcmp(raw, ref, sizeof(raw[0]) * 16) != 0) ||
+        (gs_probe_read != 4) || (gs_probe_irq != 0) || (gs_irqs_at_done != 0) || (gs_irqs != 1) ||
+        (gs_probe_reg != 1) || (gs_probe_deinit != 5) || (gs_probe_reads != 0))
+    {
+        printf("fifo: FAIL.\n");
+        fail++;
+    }
+    else
+    {
+        printf("fifo: 16 samples, read busy in flight, irq deferred to after the callback.\n");
+        printf("fifo: register access and deinit refused in flight without touching the bus.\n");
+    }
+
+    /* fifo with a pending irq sample */
+    (void)adxl345_set_irq_burst(&gs_handle, ADXL345_BOOL_TRUE);
+    if ((a_check_run(21, 33, 1, raw, ref, &ref_len) != 0) || (gs_res != 0) || (gs_len != 21) ||
+        (ref_len != 21) || (memcmp(raw, ref, sizeof(raw[0]) * 21) != 0) || (raw[20][2] != 120))
+    {
+        printf("fifo with irq sample: FAIL.\n");
+        fail++;
+    }
+    else
+    {
+        printf("fifo with irq sample: 21 samples.\n");
+    }
+    (void)adxl345_set_irq_burst(&gs_handle, ADXL345_BOOL_FALSE);
+
+    /* a failed read in the chain, reads are the fifo status then one per entry */
+    gs_reads = 0;
+    gs_fail_at = 6;
+    if ((a_check_run(21, 16, 0, raw, ref, &ref_len) != 0) || (gs_res != 1) || (gs_len != 4) ||
+        (memcmp(raw, ref, sizeof(raw[0]) * 4) != 0))
+    {
+        printf("failed read: FAIL.\n");
+        fail++;
+    }
+    else
+    {
+        printf("failed read: 4 samples returned with the error.\n");
+    }
+    if ((adxl345_async_complete(&gs_handle, 0) != 4) || (async_worker_deinit(&gs_worker) != 0))
+    {
+        printf("idle: FAIL.\n");
+        fail++;
+    }
+    (void)adxl345_deinit(&gs_handle);
+    if (fail != 0)
+    {
+        printf("async_check: FAIL.\n");
+
+        return 1;
+    }
+    printf("async_check: PASS.\n");
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      iic_batch_check.c
+ * @brief     iic batch transfer check against a mock ioctl source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "iic.h"
+#include <stdarg.h>
+
+static uint8_t gs_reg[64];            /**< mock register file */
+static uint8_t gs_fifo[64][6];        /**< mock fifo entries */
+static uint32_t gs_fifo_head;         /**< mock fifo pop index */
+static uint32_t gs_ioctls;            /**< I2C_RDWR calls */
+static uint32_t gs_max_msgs;          /**< largest message number */
+
+/**
+ * @brief     mock ioctl
+ * @param[in] fd is the device handle
+ * @param[in] request is the ioctl request
+ * @return    0 on success, -1 on error
+ * @note      it emulates the adxl345 register pointer and the fifo pop on a read of 0x32 - 0x37
+ */
+int ioctl(int fd, unsigned long request, ...)
+{
+    va_list args;
+    struct i2c_rdwr_ioctl_data *data;
+    uint8_t ptr;
+    uint32_t i;
+    uint32_t j;
+
+    (void)fd;
+    if (request != I2C_RDWR)
+    {
+        return -1;
+    }
+    va_start(args, request);
+    data = va_arg(args, struct i2c_rdwr_ioctl_data *);
+    va_end(args);
+    if ((data->nmsgs == 0) || (data->nmsgs > IIC_BATCH_MAX_MSGS))
+    {
+        return -1;
+    }
+    gs_ioctls++;
+    gs_max_msgs = (data->nmsgs > gs_max_msgs) ? data->nmsgs : gs_max_msgs;
+    ptr = 0;
+    for (i = 0; i < data->nmsgs; i++)
+    {
+        struct i2c_msg *m = &data->msgs[i];
+
+        if ((m->flags & I2C_M_RD) == 0)
+        {
+            ptr = m->buf[0];
+            for (j = 1; j < m->len; j++)
+            {
+                gs_reg[(ptr + j - 1) & 0x3F] = m->buf[j];
+            }
+            continue;
+        }
+        for (j = 0; j < m->len; j++)
+        {
+            uint8_t r = (uint8_t)((ptr + j) & 0x3F);
+
+            m->buf[j] = ((r >= 0x32) && (r <= 0x37)) ? gs_fifo[gs_fifo_head & 0x3F][r - 0x32] : gs_reg[r];
+        }
+        if ((ptr <= 0x37) && ((ptr + m->len) > 0x37))
+        {
+            gs_fifo_head++;
+        }
+    }
+
+    return (int)data->nmsgs;
+}
+
+/**
+ * @brief  check main
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   drains 33 entries with a write segment in the middle and checks the data and the ioctl count
+ */
+int main(void)
+{
+    iic_segment_t seg[34];
+    uint8_t frame[34][6];
+    uint8_t value;
+    uint32_t i;
+    uint32_t k;
+    uint32_t bad;
+
+    for (i = 0; i < 64; i++)
+    {
+        for (k = 0; k < 6; k++)
+        {
+            gs_fifo[i][k] = (uint8_t)(i * 6 + k);
+        }
+    }
+    memset(frame, 0, sizeof(frame));
+
+    /* 33 fifo entry reads */
+    for (i = 0; i < 33; i++)
+    {
+        seg[i].reg = 0x32;
+        seg[i].read = 1;
+        seg[i].len = 6;
+        seg[i].buf = frame[i];
+    }
+    if (iic_transfer_batch(3, 0xA6, seg, 33) != 0)
+    {
+        printf("iic_batch_check: transfer failed.\n");
+
+        return 1;
+    }
+    bad = 0;
+    for (i = 0; i < 33; i++)
+    {
+        bad += (memcmp(frame[i], gs_fifo[i], 6) != 0) ? 1 : 0;
+    }
+    printf("33 entries: %u ioctls, max %u msgs, %u bad entries.\n", (unsigned int)gs_ioctls,
+           (unsigned int)gs_max_msgs, (unsigned int)bad);
+    if ((bad != 0) || (gs_ioctls != 2) || (gs_max_msgs > IIC_BATCH_MAX_MSGS))
+    {
+        printf("iic_batch_check: FAIL.\n");
+
+        return 1;
+    }
+
+    /* a write segment keeps the order */
+    gs_ioctls = 0;
+    value = 0x8A;
+    seg[0].reg = 0x32;
+    seg[0].read = 1;
+    seg[0].len = 6;
+    seg[0].buf = frame[0];
+    seg[1].reg = 0x38;
+    seg[1].read = 0;
+    seg[1].len = 1;
+    seg[1].buf = &value;
+    seg[2].reg = 0x38;
+    seg[2].read = 1;
+    seg[2].len = 1;
+    seg[2].buf = frame[2];
+    if ((iic_transfer_batch(3, 0xA6, seg, 3) != 0) || (frame[2][0] != 0x8A) || (gs_ioctls != 3))
+    {
+        printf("iic_batch_check: write order FAIL.\n");
+
+        return 1;
+    }
+    printf("iic_batch_check: PASS.\n");
+
+    return 0;
+}
@@ -0,0 +1,525 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *
+ * @file      scheduler_check.c
+ * @brief     multi-sensor drain scheduler check against a simulated bus source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_scheduler.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief check definition
+ */
+#define CHECK_SENSOR            2             /**< simulated sensor number */
+#define CHECK_RUN_US            2000000       /**< simulated load run time */
+#define CHECK_IDLE_US           100           /**< simulated time step while the bus is idle */
+
+/**
+ * @brief simulated sensor structure definition
+ */
+typedef struct check_sensor_s
+{
+    uint8_t addr;                 /**< iic address */
+    uint8_t reg[64];              /**< register file */
+    float period_us;              /**< sample period */
+    uint64_t start_us;            /**< sampling start time */
+    uint32_t popped;              /**< popped entry number */
+    uint32_t lost;                /**< entries lost to a full fifo */
+    uint32_t next;                /**< next expected sample sequence */
+    uint32_t broken;              /**< samples out of sequence */
+} check_sensor_t;
+
+static check_sensor_t gs_sensor[CHECK_SENSOR];            /**< simulated sensors */
+static adxl345_handle_t gs_handle[CHECK_SENSOR];          /**< adxl345 handles */
+static adxl345_scheduler_t gs_sched;                      /**< scheduler */
+static uint64_t gs_now_us;                                /**< simulated clock */
+static uint8_t gs_sampling;                               /**< fifo filling flag */
+static uint8_t gs_order[8];                               /**< drained sensor order */
+static uint8_t gs_order_num;                              /**< drained sensor number */
+static uint8_t gs_locked[CHECK_SENSOR];                   /**< per handle lock flags */
+static uint32_t gs_lock_error;                            /**< wrong handle or recursive lock number */
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt is the format data
+ * @note      scheduler messages are hidden
+ */
+void adxl345_interface_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief  simulated clock
+ * @return simulated time in us
+ * @note   none
+ */
+static uint64_t a_check_timestamp_us(void)
+{
+    return gs_now_us;
+}
+
+/**
+ * @brief     get the simulated sensor of an address
+ * @param[in] addr is the iic address
+ * @return    pointer to the sensor
+ * @note      none
+ */
+static check_sensor_t *a_check_sensor(uint8_t addr)
+{
+    return (gs_sensor[0].addr == addr) ? &gs_sensor[0] : &gs_sensor[1];
+}
+
+/**
+ * @brief     get the fifo level at the simulated time
+ * @param[in] *sensor points to a simulated sensor
+ * @return    fifo level
+ * @note      entries beyond 32 overwrite nothing and are counted as lost
+ */
+static uint32_t a_check_level(check_sensor_t *sensor)
+{
+    uint32_t made;
+
+    if (gs_sampling == 0)
+    {
+        return 0;
+    }
+    made = (uint32_t)((float)(gs_now_us - sensor->start_us) / sensor->period_us);
+    if ((made - sensor->popped) > 32)
+    {
+        sensor->lost += made - sensor->popped - 32;
+        sensor->popped = made - 32;
+    }
+
+    return made - sensor->popped;
+}
+
+/**
+ * @brief      simulated iic read
+ * @param[in]  addr is the iic address
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ * @note       every read takes 20us plus 25us per byte, a read through 0x37 pops one fifo entry,
+ *             x holds the sample sequence and y the sensor address
+ */
+static uint8_t a_check_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    check_sensor_t *sensor = a_check_sensor(addr);
+    uint32_t level;
+    uint16_t i;
+    int16_t v[3];
+
+    gs_now_us += 20 + 25 * len;
+    level = a_check_level(sensor);
+    sensor->reg[0x39] = (uint8_t)level;
+    v[0] = (int16_t)(sensor->popped & 0x7FFF);
+    v[1] = (int16_t)addr;
+    v[2] = 0;
+    for (i = 0; i < len; i++)
+    {
+        uint8_t r = (uint8_t)((reg + i) & 0x3F);
+
+        if ((r >= 0x32) && (r <= 0x37))
+        {
+            buf[i] = ((r & 0x01) != 0) ? (uint8_t)((uint16_t)v[(r - 0x32) / 2] >> 8) : (uint8_t)v[(r - 0x32) / 2];
+        }
+        else
+        {
+            buf[i] = sensor->reg[r];
+        }
+    }
+    if ((reg <= 0x37) && ((reg + len) > 0x37) && (level != 0))
+    {
+        sensor->popped++;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     simulated iic write
+ * @param[in] addr is the iic address
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_check_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_now_us += 20 + 25 * len;
+    memcpy(&a_check_sensor(addr)->reg[reg & 0x3F], buf, len);
+
+    return 0;
+}
+
+/**
+ * @brief  simulated bus init and deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_check_bus(void)
+{
+    return 0;
+}
+
+/**
+ * @brief      simulated spi read
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 1 read failed
+ * @note       only iic is simulated
+ */
+static uint8_t a_check_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)reg;
+    (void)buf;
+    (void)len;
+
+    return 1;
+}
+
+/**
+ * @brief     simulated spi write
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 1 write failed
+ * @note      only iic is simulated
+ */
+static uint8_t a_check_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)reg;
+    (void)buf;
+    (void)len;
+
+    return 1;
+}
+
+/**
+ * @brief     simulated delay ms
+ * @param[in] ms is the time
+ * @note      none
+ */
+static void a_check_delay_ms(uint32_t ms)
+{
+    gs_now_us += (uint64_t)ms * 1000;
+}
+
+/**
+ * @brief     per handle lock
+ * @param[in] *handle points to the locked handle
+ * @note      the handle selects its own lock, a recursive or foreign lock is counted
+ */
+static void a_check_lock(adxl345_handle_t *handle)
+{
+    size_t i = (size_t)(handle - gs_handle);
+
+    if ((i >= CHECK_SENSOR) || (gs_locked[i] != 0))
+    {
+        gs_lock_error++;
+
+        return;
+    }
+    gs_locked[i] = 1;
+}
+
+/**
+ * @brief     per handle unlock
+ * @param[in] *handle points to the unlocked handle
+ * @note      unlocking a lock that is not held is counted
+ */
+static void a_check_unlock(adxl345_handle_t *handle)
+{
+    size_t i = (size_t)(handle - gs_handle);
+
+    if ((i >= CHECK_SENSOR) || (gs_locked[i] == 0))
+    {
+        gs_lock_error++;
+
+        return;
+    }
+    gs_locked[i] = 0;
+}
+
+/**
+ * @brief     simulated receive callback
+ * @param[in] type is the irq type
+ * @note      none
+ */
+static void a_check_receive_callback(uint8_t type)
+{
+    (void)type;
+}
+
+/**
+ * @brief     drained data callback
+ * @param[in] *sched points to a scheduler structure
+ * @param[in] index is the sensor index
+ * @param[in] **raw points to the raw data buffer
+ * @param[in] **g points to the converted data buffer
+ * @param[in] len is the sample number
+ * @note      the drain order is kept and every sample sequence is checked
+ */
+static void a_check_callback(adxl345_scheduler_t *sched, uint8_t index, int16_t (*raw)[3], float (*g)[3], uint16_t len)
+{
+    check_sensor_t *sensor = &gs_sensor[index];
+    uint16_t i;
+
+    (void)sched;
+    (void)g;
+    if (gs_order_num < sizeof(gs_order))
+    {
+        gs_order[gs_order_num++] = index;
+    }
+    for (i = 0; i < len; i++)
+    {
+        if ((raw[i][0] != (int16_t)(sensor->next & 0x7FFF)) || (raw[i][1] != (int16_t)sensor->addr))
+        {
+            sensor->broken++;
+        }
+        sensor->next = (uint32_t)(uint16_t)raw[i][0] + 1;
+    }
+}
+
+/**
+ * @brief     init one simulated sensor
+ * @param[in] i is the sensor index
+ * @param[in] addr is the address pin
+ * @param[in] rate is the output data rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      stream mode with the watermark at 16
+ */
+static uint8_t a_check_init(uint8_t i, adxl345_address_t addr, adxl345_rate_t rate)
+{
+    uint8_t index;
+    adxl345_handle_t *handle = &gs_handle[i];
+
+    gs_sensor[i].addr = (uint8_t)addr;
+    gs_sensor[i].reg[0x00] = 0xE5;
+    DRIVER_ADXL345_LINK_INIT(handle, adxl345_handle_t);
+    DRIVER_ADXL345_LINK_IIC_INIT(handle, a_check_bus);
+    DRIVER_ADXL345_LINK_IIC_DEINIT(handle, a_check_bus);
+    DRIVER_ADXL345_LINK_IIC_READ(handle, a_check_read);
+    DRIVER_ADXL345_LINK_IIC_WRITE(handle, a_check_write);
+    DRIVER_ADXL345_LINK_SPI_INIT(handle, a_check_bus);
+    DRIVER_ADXL345_LINK_SPI_DEINIT(handle, a_check_bus);
+    DRIVER_ADXL345_LINK_SPI_READ(handle, a_check_spi_read);
+    DRIVER_ADXL345_LINK_SPI_WRITE(handle, a_check_spi_write);
+    DRIVER_ADXL345_LINK_DELAY_MS(handle, a_check_delay_ms);
+    DRIVER_ADXL345_LINK_DEBUG_PRINT(handle, adxl345_interface_debug_print);
+    DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(handle, a_check_receive_callback);
+    DRIVER_ADXL345_LINK_LOCK(handle, a_check_lock);
+    DRIVER_ADXL345_LINK_UNLOCK(handle, a_check_unlock);
+    if ((adxl345_set_interface(handle, ADXL345_INTERFACE_IIC) != 0) ||
+        (adxl345_set_addr_pin(handle, addr) != 0) ||
+        (adxl345_init(handle) != 0) ||
+        (adxl345_set_rate(handle, rate) != 0) ||
+        (adxl345_set_mode(handle, ADXL345_MODE_STREAM) != 0) ||
+        (adxl345_set_watermark(handle, 16) != 0) ||
+        (adxl345_scheduler_add(&gs_sched, handle, &index) != 0) ||
+        (index != i))
+    {
+        return 1;
+    }
+    gs_sensor[i].period_us = gs_sched.sensor[i].period_us;
+
+    return 0;
+}
+
+/**
+ * @brief     start the fifo filling of all sensors
+ * @note      the sequence check restarts
+ */
+static void a_check_start(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < CHECK_SENSOR; i++)
+    {
+        gs_sensor[i].start_us = gs_now_us;
+        gs_sensor[i].popped = 0;
+        gs_sensor[i].lost = 0;
+        gs_sensor[i].next = 0;
+        gs_sensor[i].broken = 0;
+        gs_sched.sensor[i].samples = 0;
+        gs_sched.sensor[i].full_drains = 0;
+    }
+    gs_sampling = 1;
+}
+
+/**
+ * @brief  check main
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   covers the drain order by the fifo level and a loaded run of two sensors on one bus
+ */
+int main(void)
+{
+    uint8_t i;
+    uint8_t drained;
+    uint32_t fail;
+    uint32_t level;
+    uint32_t samples;
+
+    if ((adxl345_scheduler_init(&gs_sched, a_check_timestamp_us, a_check_callback) != 0) ||
+        (a_check_init(0, ADXL345_ADDRESS_ALT_0, ADXL345_RATE_800) != 0) ||
+        (a_check_init(1, ADXL345_ADDRESS_ALT_1, ADXL345_RATE_800) != 0))
+    {
+        printf("scheduler_check: init failed.\n");
+
+        return 1;
+    }
+    fail = 0;
+
+    /* the fuller fifo is drained first at the same rate and watermark */
+    a_check_start();
+    gs_now_us += 16 * 1250;
+    gs_order_num = 0;
+    if ((adxl345_scheduler_request(&gs_sched, 0, 16) != 0) ||
+        (adxl345_scheduler_request(&gs_sched, 1, 28) != 0) ||
+        (adxl345_scheduler_run(&gs_sched, &drained) != 0) ||
+        (drained != 2) || (gs_order[0] != 1) || (gs_order[1] != 0))
+    {
+        printf("order by level: FAIL.\n");
+        fail++;
+    }
+    else
+    {
+        printf("order by level: the request seen at 28 entries is drained before the one at 16.\n");
+    }
+
+    /* an unknown level falls back to the watermark, the coalesced request keeps the first level */
+    gs_order_num = 0;
+    if ((adxl345_scheduler_request(&gs_sched, 0, 0xFF) != 0) ||
+        (adxl345_scheduler_request(&gs_sched, 1, 20) != 0) ||
+        (adxl345_scheduler_request(&gs_sched, 0, 31) != 0) ||
+        (gs_sched.sensor[0].request_level != 16) || (gs_sched.sensor[0].coalesced != 1) ||
+        (adxl345_scheduler_run(&gs_sched, &drained) != 0) ||
+        (drained != 2) || (gs_order[0] != 1) || (gs_order[1] != 0))
+    {
+        printf("unknown level: FAIL.\n");
+        fail++;
+    }
+    else
+    {
+        printf("unknown level: the watermark is used and a coalesced request keeps its first level.\n");
+    }
+
+    /* a loaded run, every watermark raises a request with the level seen by the interrupt */
+    (void)adxl345_set_rate(&gs_handle[1], ADXL345_RATE_1600);
+    gs_sched.num = 1;
+    if (adxl345_scheduler_add(&gs_sched, &gs_handle[1], &i) != 0)
+    {
+        printf("scheduler_check: add failed.\n");
+
+        return 1;
+    }
+    gs_sensor[1].period_us = gs_sched.sensor[1].period_us;
+    a_check_start();
+    while (gs_now_us < (gs_sensor[0].start_us + CHECK_RUN_US))
+    {
+        for (i = 0; i < CHECK_SENSOR; i++)
+        {
+            level = a_check_level(&gs_sensor[i]);
+            if ((level >= 16) && (gs_sched.sensor[i].pending == 0))
+            {
+                (void)adxl345_scheduler_request(&gs_sched, i, (uint8_t)level);
+            }
+        }
+        if (adxl345_scheduler_run(&gs_sched, &drained) != 0)
+        {
+            fail++;
+
+            break;
+        }
+        if (drained == 0)
+        {
+            gs_now_us += CHECK_IDLE_US;
+        }
+    }
+    samples = 0;
+    for (i = 0; i < CHECK_SENSOR; i++)
+    {
+        samples += gs_sched.sensor[i].samples;
+        if ((gs_sensor[i].lost != 0) || (gs_sensor[i].broken != 0) || (gs_sched.sensor[i].full_drains != 0) ||
+            (gs_sched.sensor[i].samples != gs_sensor[i].popped))
+        {
+            printf("loaded run: sensor %d lost %d broken %d full drains %d FAIL.\n", i, (int)gs_sensor[i].lost,
+                   (int)gs_sensor[i].broken, (int)gs_sched.sensor[i].full_drains);
+            fail++;
+        }
+    }
+    if (fail == 0)
+    {
+        printf("loaded run: 800Hz and 1600Hz on one bus, %d samples in order, no overrun.\n", (int)samples);
+    }
+    for (i = 0; i < CHECK_SENSOR; i++)
+    {
+        (void)adxl345_deinit(&gs_handle[i]);
+        if (gs_locked[i] != 0)
+        {
+            gs_lock_error++;
+        }
+    }
+    if (gs_lock_error != 0)
+    {
+        printf("handle lock: %d wrong handle or recursive locks FAIL.\n", (int)gs_lock_error);
+        fail++;
+    }
+    else
+    {
+        printf("handle lock: every lock and unlock got its own handle.\n");
+    }
+    if (fail != 0)
+    {
+        printf("scheduler_check: FAIL.\n");
+
+        return 1;
+    }
+    printf("scheduler_check: PASS.\n");
+
+    return 0;
+}
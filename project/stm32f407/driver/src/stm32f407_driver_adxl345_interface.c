@@ -98,6 +98,62 @@ uint8_t adxl345_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uin
     return iic_write(addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr is the iic device write address
+ * @param[in] *xfer points to a transfer segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the segments run one by one
+ */
+uint8_t adxl345_interface_iic_transfer(uint8_t addr, adxl345_transfer_t *xfer, uint16_t num)
+{
+    uint16_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        if (xfer[i].rw == ADXL345_TRANSFER_READ)
+        {
+            if (iic_read(addr, xfer[i].reg, xfer[i].buf, xfer[i].len) != 0)
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            if (iic_write(addr, xfer[i].reg, xfer[i].buf, xfer[i].len) != 0)
+            {
+                return 1;
+            }
+        }
+        if (xfer[i].delay_us != 0)
+        {
+            delay_us(xfer[i].delay_us);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      interface iic bus async read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @param[in]  *handle points to the handle passed to adxl345_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       not supported, the blocking hooks are used
+ */
+uint8_t adxl345_interface_iic_read_async(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, adxl345_handle_t *handle)
+{
+    return 1;
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -152,6 +208,60 @@ uint8_t adxl345_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
     return spi_write(reg, buf, len);
 }
 
+/**
+ * @brief     interface spi bus transfer
+ * @param[in] *xfer points to a transfer segment array
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the segments run one by one
+ */
+uint8_t adxl345_interface_spi_transfer(adxl345_transfer_t *xfer, uint16_t num)
+{
+    uint16_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        if (xfer[i].rw == ADXL345_TRANSFER_READ)
+        {
+            if (spi_read(xfer[i].reg, xfer[i].buf, xfer[i].len) != 0)
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            if (spi_write(xfer[i].reg, xfer[i].buf, xfer[i].len) != 0)
+            {
+                return 1;
+            }
+        }
+        if (xfer[i].delay_us != 0)
+        {
+            delay_us(xfer[i].delay_us);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      interface spi bus async read
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of data buffer
+ * @param[in]  *handle points to the handle passed to adxl345_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       not supported, the blocking hooks are used
+ */
+uint8_t adxl345_interface_spi_read_async(uint8_t reg, uint8_t *buf, uint16_t len, adxl345_handle_t *handle)
+{
+    return 1;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms
@@ -162,6 +272,26 @@ void adxl345_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us
+ * @note      none
+ */
+void adxl345_interface_delay_us(uint32_t us)
+{
+    delay_us(us);
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   the resolution is 1us from the systick counter
+ */
+uint64_t adxl345_interface_timestamp_us(void)
+{
+    return delay_timestamp_us();
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt is the format data
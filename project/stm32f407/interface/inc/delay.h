@@ -71,6 +71,13 @@ void delay_us(uint32_t us);
  */
 void delay_ms(uint32_t ms);
 
+/**
+ * @brief  delay get the timestamp
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t delay_timestamp_us(void);
+
 /**
  * @}
  */
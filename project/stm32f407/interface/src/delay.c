@@ -97,3 +97,23 @@ void delay_ms(uint32_t ms)
 {
     HAL_Delay(ms);
 }
+
+/**
+ * @brief  delay get the timestamp
+ * @return monotonic time in us
+ * @note   the 1ms hal tick is extended with the elapsed systick counts of the current tick,
+ *         the tick is read again to catch a reload between the two reads
+ */
+uint64_t delay_timestamp_us(void)
+{
+    uint32_t tick;
+    uint32_t val;
+    
+    do
+    {
+        tick = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (tick != HAL_GetTick());
+    
+    return (uint64_t)tick * 1000 + (SysTick->LOAD - val) / gs_fac_us;
+}
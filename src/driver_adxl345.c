@@ -37,6 +37,51 @@
 
 #include "driver_adxl345.h"
 
+/**
+ * @brief simd convert kernels, define ADXL345_NO_SIMD to build the scalar kernel only
+ */
+#if !defined(ADXL345_NO_SIMD) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    #if defined(__SSE2__)
+        #define ADXL345_CONVERT_SSE2        /**< sse2 kernel */
+        #include <emmintrin.h>
+    #endif
+    #if defined(__GNUC__) && defined(__x86_64__)
+        #define ADXL345_CONVERT_AVX2        /**< avx2 kernel */
+        #include <immintrin.h>
+    #endif
+    #if defined(__ARM_NEON)
+        #define ADXL345_CONVERT_NEON        /**< neon kernel */
+        #include <arm_neon.h>
+    #endif
+#endif
+
+/**
+ * @brief convert kernel detection definition
+ * @note  the detected kernel only depends on the cpu, so racing first calls store the same value
+ */
+#if defined(__GNUC__) || defined(__clang__)
+    #define ADXL345_CONVERT_LOAD(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)          /**< load acquire */
+    #define ADXL345_CONVERT_STORE(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)    /**< store release */
+#else
+    #define ADXL345_CONVERT_LOAD(p)        (*(volatile uint8_t *)(p))                      /**< load */
+    #define ADXL345_CONVERT_STORE(p, v)    (*(volatile uint8_t *)(p) = (v))                /**< store */
+#endif
+
+/**
+ * @brief bus trace hooks, define ADXL345_TRACE to build them
+ */
+#ifdef ADXL345_TRACE
+    #define ADXL345_TRACE_API(handle)                      a_adxl345_trace_api((handle), __func__)
+    #define ADXL345_TRACE_BEGIN(handle)                    uint32_t trace_start_us = a_adxl345_trace_now(handle)
+    #define ADXL345_TRACE_END(handle, reg, len, flag)      a_adxl345_trace_record((handle), trace_start_us, (reg), (len), (flag))
+    #define ADXL345_TRACE_BATCH(handle, xfer, num, res)    a_adxl345_trace_batch((handle), trace_start_us, (xfer), (num), (res))
+#else
+    #define ADXL345_TRACE_API(handle)
+    #define ADXL345_TRACE_BEGIN(handle)
+    #define ADXL345_TRACE_END(handle, reg, len, flag)
+    #define ADXL345_TRACE_BATCH(handle, xfer, num, res)
+#endif
+
 /**
  * @brief chip register definition
  */
@@ -83,6 +128,179 @@
 #define ADXL345_REG_FIFO_CTL              0x38        /**< fifo control register */
 #define ADXL345_REG_FIFO_STATUS           0x39        /**< fifo status register */
 
+#ifdef ADXL345_TRACE
+/**
+ * @brief     get the trace time
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    low 32 bits of the timestamp in us
+ * @note      none
+ */
+static uint32_t a_adxl345_trace_now(adxl345_handle_t *handle)
+{
+    if ((handle->trace == NULL) || (handle->timestamp_us == NULL))        /* if no trace or no clock */
+    {
+        return 0;                                                         /* return 0 */
+    }
+    
+    return (uint32_t)handle->timestamp_us();                              /* return time */
+}
+
+/**
+ * @brief     tag the following transactions with the api name
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *name points to the api name
+ * @note      the name is hashed only when a record is written
+ */
+static void a_adxl345_trace_api(adxl345_handle_t *handle, const char *name)
+{
+    if (handle->trace != NULL)                     /* if trace */
+    {
+        handle->trace->api_name = name;            /* set api name */
+    }
+}
+
+/**
+ * @brief     write a trace record
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] start_us is the transaction start time
+ * @param[in] reg is the register address
+ * @param[in] len is the payload length
+ * @param[in] flag is the trace flags
+ * @note      the api tag is the 32 bits fnv-1a hash of the api name
+ */
+static void a_adxl345_trace_record(adxl345_handle_t *handle, uint32_t start_us, uint8_t reg, uint16_t len, uint8_t flag)
+{
+    const char *p;
+    uint32_t hash;
+    adxl345_trace_t *trace = handle->trace;
+    adxl345_trace_record_t *record;
+    
+    if (trace == NULL)                                                    /* if no trace */
+    {
+        return;                                                           /* return */
+    }
+    if (trace->api_hashed != trace->api_name)                             /* if the api changed */
+    {
+        hash = 2166136261U;                                               /* fnv-1a offset basis */
+        for (p = trace->api_name; (p != NULL) && (*p != '\0'); p++)       /* hash the name */
+        {
+            hash = (hash ^ (uint8_t)(*p)) * 16777619U;                    /* fnv-1a prime */
+        }
+        trace->api = hash;                                                /* cache the tag */
+        trace->api_hashed = trace->api_name;                              /* cache the name */
+    }
+    record = &trace->record[trace->head];                                 /* get record */
+    record->start_us = start_us;                                          /* set start time */
+    record->end_us = a_adxl345_trace_now(handle);                         /* set end time */
+    record->api = trace->api;                                             /* set api tag */
+    record->len = len;                                                    /* set length */
+    record->reg = reg & 0x3F;                                             /* set register */
+    record->flag = flag;                                                  /* set flags */
+    trace->head = (trace->head + 1) % trace->size;                        /* update head */
+    if (trace->count < trace->size)                                       /* if not full */
+    {
+        trace->count++;                                                   /* update count */
+    }
+    else
+    {
+        trace->dropped++;                                                 /* oldest overwritten */
+    }
+}
+
+/**
+ * @brief     write a trace record for every transfer segment
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] start_us is the transfer start time
+ * @param[in] *xfer points to a transfer segment array
+ * @param[in] num is the segment number
+ * @param[in] res is the transfer result
+ * @note      all segments share the start and end time of the transfer call
+ */
+static void a_adxl345_trace_batch(adxl345_handle_t *handle, uint32_t start_us,
+                                  adxl345_transfer_t *xfer, uint16_t num, uint8_t res)
+{
+    uint16_t i;
+    
+    for (i = 0; i < num; i++)                                                                  /* trace all segments */
+    {
+        a_adxl345_trace_record(handle, start_us, xfer[i].reg, xfer[i].len, ADXL345_TRACE_FLAG_BATCH |
+                               ((xfer[i].rw == ADXL345_TRANSFER_READ) ? ADXL345_TRACE_FLAG_READ : 0) |
+                               ((res != 0) ? ADXL345_TRACE_FLAG_FAILED : 0));                  /* trace segment */
+    }
+}
+#endif
+
+/**
+ * @brief     take the handle lock
+ * @param[in] *handle points to a adxl345 handle structure
+ * @note      nothing is done without the lock hook
+ */
+static inline void a_adxl345_lock(adxl345_handle_t *handle)
+{
+    if (handle->lock != NULL)                    /* if lock */
+    {
+        handle->lock(handle);                    /* lock */
+    }
+}
+
+/**
+ * @brief     release the handle lock
+ * @param[in] *handle points to a adxl345 handle structure
+ * @note      nothing is done without the unlock hook
+ */
+static inline void a_adxl345_unlock(adxl345_handle_t *handle)
+{
+    if (handle->unlock != NULL)                  /* if unlock */
+    {
+        handle->unlock(handle);                  /* unlock */
+    }
+}
+
+/**
+ * @brief     count a bus error
+ * @param[in] *handle points to a adxl345 handle structure
+ * @note      none
+ */
+static inline void a_adxl345_stats_error(adxl345_handle_t *handle)
+{
+    if (handle->stats != NULL)                   /* if stats */
+    {
+        handle->stats->bus_errors++;             /* count error */
+    }
+}
+
+/**
+ * @brief     count the transfer segments
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *xfer points to a transfer segment array
+ * @param[in] num is the segment number
+ * @note      none
+ */
+static void a_adxl345_stats_transfer(adxl345_handle_t *handle, adxl345_transfer_t *xfer, uint16_t num)
+{
+    uint16_t i;
+    
+    for (i = 0; i < num; i++)                                             /* count all segments */
+    {
+        handle->session.transactions++;                                   /* count transaction */
+        handle->session.bytes += xfer[i].len + 1;                         /* count bytes */
+        if (handle->stats == NULL)                                        /* if no stats */
+        {
+            continue;                                                     /* next segment */
+        }
+        if (xfer[i].rw == ADXL345_TRANSFER_READ)                          /* if read */
+        {
+            handle->stats->read_transactions++;                           /* count transaction */
+            handle->stats->read_bytes += xfer[i].len;                     /* count bytes */
+        }
+        else
+        {
+            handle->stats->write_transactions++;                          /* count transaction */
+            handle->stats->write_bytes += xfer[i].len;                    /* count bytes */
+        }
+    }
+}
+
 /**
  * @brief      iic or spi interface read bytes
  * @param[in]  *handle points to a adxl345 handle structure
@@ -92,20 +310,29 @@
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       it fails while an async read is in flight so the bus is never shared with it
  */
 static uint8_t a_adxl345_iic_spi_read(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+    uint8_t res;
+    ADXL345_TRACE_BEGIN(handle);                                         /* trace start time */
+    
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                 /* check async state */
+    {
+        handle->debug_print("adxl345: async read is busy.\n");           /* async read is busy */
+        
+        return 1;                                                        /* return error */
+    }
+    handle->session.transactions++;                                      /* count transaction */
+    handle->session.bytes += len + 1;                                    /* count bytes */
+    if (handle->stats != NULL)                                           /* if stats */
+    {
+        handle->stats->read_transactions++;                              /* count transaction */
+        handle->stats->read_bytes += len;                                /* count bytes */
+    }
     if (handle->iic_spi == ADXL345_INTERFACE_IIC)                        /* iic interface */
     {
-        if (handle->iic_read(handle->iic_addr, reg, buf, len) != 0)      /* read data */
-        {
-            return 1;                                                    /* return error */
-        }
-        else
-        {
-            return 0;                                                    /* success return 0 */
-        }
+        res = handle->iic_read(handle->iic_addr, reg, buf, len);         /* read data */
     }
     else                                                                 /* spi interface */
     {
@@ -115,15 +342,18 @@ static uint8_t a_adxl345_iic_spi_read(adxl345_handle_t *handle, uint8_t reg, uin
         }
         reg |= 1 << 7;                                                   /* flag read */
         
-        if (handle->spi_read(reg, buf, len) != 0)                        /* read data */
-        {
-            return 1;                                                    /* return error */
-        }
-        else
-        {
-            return 0;                                                    /* success return 0 */
-        }
+        res = handle->spi_read(reg, buf, len);                           /* read data */
+    }
+    ADXL345_TRACE_END(handle, reg, len, ADXL345_TRACE_FLAG_READ |
+                      ((res != 0) ? ADXL345_TRACE_FLAG_FAILED : 0));     /* trace transaction */
+    if (res != 0)                                                        /* check result */
+    {
+        a_adxl345_stats_error(handle);                                   /* count error */
+        
+        return 1;                                                        /* return error */
     }
+    
+    return 0;                                                            /* success return 0 */
 }
 
 /**
@@ -135,20 +365,29 @@ static uint8_t a_adxl345_iic_spi_read(adxl345_handle_t *handle, uint8_t reg, uin
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      it fails while an async read is in flight so the bus is never shared with it
  */
 static uint8_t a_adxl345_iic_spi_write(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+    uint8_t res;
+    ADXL345_TRACE_BEGIN(handle);                                          /* trace start time */
+    
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                  /* check async state */
+    {
+        handle->debug_print("adxl345: async read is busy.\n");            /* async read is busy */
+        
+        return 1;                                                         /* return error */
+    }
+    handle->session.transactions++;                                       /* count transaction */
+    handle->session.bytes += len + 1;                                     /* count bytes */
+    if (handle->stats != NULL)                                            /* if stats */
+    {
+        handle->stats->write_transactions++;                              /* count transaction */
+        handle->stats->write_bytes += len;                                /* count bytes */
+    }
     if (handle->iic_spi == ADXL345_INTERFACE_IIC)                         /* iic interface */
     {
-        if (handle->iic_write(handle->iic_addr, reg, buf, len) != 0)      /* write data */
-        {
-            return 1;                                                     /* return error */
-        }
-        else
-        {
-            return 0;                                                     /* success return 0 */
-        }
+        res = handle->iic_write(handle->iic_addr, reg, buf, len);         /* write data */
     }
     else                                                                  /* spi interface */
     {
@@ -157,374 +396,640 @@ static uint8_t a_adxl345_iic_spi_write(adxl345_handle_t *handle, uint8_t reg, ui
             reg |= 1 << 6;                                                /* flag length > 1 */
         }
         
-        if (handle->spi_write(reg, buf, len) != 0)                        /* wrtie data */
+        res = handle->spi_write(reg, buf, len);                           /* wrtie data */
+    }
+    ADXL345_TRACE_END(handle, reg, len,
+                      (res != 0) ? ADXL345_TRACE_FLAG_FAILED : 0);        /* trace transaction */
+    if (res != 0)                                                         /* check result */
+    {
+        a_adxl345_stats_error(handle);                                    /* count error */
+        
+        return 1;                                                         /* return error */
+    }
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief         run several register transactions
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[in,out] *xfer points to a transfer segment array
+ * @param[in]     num is the segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 transfer failed
+ * @note          the segments are passed to the linked transfer hook in one call,
+ *                otherwise they are run one by one with the read and write hooks,
+ *                it fails while an async read is in flight
+ */
+static uint8_t a_adxl345_transfer(adxl345_handle_t *handle, adxl345_transfer_t *xfer, uint16_t num)
+{
+    uint8_t res;
+    uint16_t i;
+    
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                                   /* check async state */
+    {
+        handle->debug_print("adxl345: async read is busy.\n");                             /* async read is busy */
+        
+        return 1;                                                                          /* return error */
+    }
+    if (((handle->iic_spi == ADXL345_INTERFACE_IIC) && (handle->iic_transfer != NULL)) ||
+        ((handle->iic_spi == ADXL345_INTERFACE_SPI) && (handle->spi_transfer != NULL)))    /* if transfer is linked */
+    {
+        ADXL345_TRACE_BEGIN(handle);                                                       /* trace start time */
+        
+        if (handle->iic_spi == ADXL345_INTERFACE_IIC)                                      /* iic transfer */
+        {
+            a_adxl345_stats_transfer(handle, xfer, num);                                   /* count all segments */
+            res = handle->iic_transfer(handle->iic_addr, xfer, num);                       /* run transfer */
+        }
+        else                                                                               /* spi transfer */
+        {
+            for (i = 0; i < num; i++)                                                      /* set all segments */
+            {
+                if (xfer[i].len > 1)                                                       /* if length > 1 */
+                {
+                    xfer[i].reg |= 1 << 6;                                                 /* flag length > 1 */
+                }
+                if (xfer[i].rw == ADXL345_TRANSFER_READ)                                   /* if read */
+                {
+                    xfer[i].reg |= 1 << 7;                                                 /* flag read */
+                }
+            }
+            a_adxl345_stats_transfer(handle, xfer, num);                                   /* count all segments */
+            res = handle->spi_transfer(xfer, num);                                         /* run transfer */
+        }
+        ADXL345_TRACE_BATCH(handle, xfer, num, res);                                       /* trace all segments */
+        if (res != 0)                                                                      /* check result */
+        {
+            a_adxl345_stats_error(handle);                                                 /* count error */
+            
+            return 1;                                                                      /* return error */
+        }
+        
+        return 0;                                                                          /* success return 0 */
+    }
+    
+    for (i = 0; i < num; i++)                                                              /* run all segments */
+    {
+        if (xfer[i].rw == ADXL345_TRANSFER_READ)                                           /* if read */
         {
-            return 1;                                                     /* return error */
+            res = a_adxl345_iic_spi_read(handle, xfer[i].reg, xfer[i].buf, xfer[i].len);   /* read data */
         }
         else
         {
-            return 0;                                                     /* success return 0 */
+            res = a_adxl345_iic_spi_write(handle, xfer[i].reg, xfer[i].buf, xfer[i].len);  /* write data */
+        }
+        if (res != 0)                                                                      /* check result */
+        {
+            return 1;                                                                      /* return error */
+        }
+        if ((xfer[i].delay_us != 0) && (handle->delay_us != NULL))                         /* if delay */
+        {
+            handle->delay_us(xfer[i].delay_us);                                            /* delay */
         }
     }
+    
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     set the chip interface
- * @param[in] *handle points to a adxl345 handle structure
- * @param[in] interface is the chip interface
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- * @note      none
+ * @brief     check whether a register is held in the register cache
+ * @param[in] reg is the register address
+ * @return    check result
+ *            - 0 not cached
+ *            - 1 cached
+ * @note      only the writable configuration registers are cached
  */
-uint8_t adxl345_set_interface(adxl345_handle_t *handle, adxl345_interface_t interface) 
+static uint8_t a_adxl345_cache_is_cached(uint16_t reg)
 {
-    if (handle == NULL)                          /* check handle */
+    if ((reg >= ADXL345_REG_THRESH_TAP) && (reg <= ADXL345_REG_TAP_AXES))        /* 0x1D - 0x2A */
     {
-        return 2;                                /* return error */
+        return 1;                                                                /* cached */
     }
-    
-    handle->iic_spi = (uint8_t)interface;        /* set interface */
-    
-    return 0;                                    /* success return 0 */
+    if ((reg >= ADXL345_REG_BW_RATE) && (reg <= ADXL345_REG_INT_MAP))            /* 0x2C - 0x2F */
+    {
+        return 1;                                                                /* cached */
+    }
+    if ((reg == ADXL345_REG_DATA_FORMAT) || (reg == ADXL345_REG_FIFO_CTL))       /* 0x31 and 0x38 */
+    {
+        return 1;                                                                /* cached */
+    }
+
+    return 0;                                                                    /* not cached */
 }
 
 /**
- * @brief      get the chip interface
+ * @brief      read the configuration registers
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *interface points to a chip interface buffer
+ * @param[out] *buf points to a register buffer starting at 0x1D
+ * @param[in]  fifo_len is 1 for fifo ctl only or 2 for fifo ctl and fifo status
  * @return     status code
  *             - 0 success
- *             - 2 handle is NULL
- * @note       none
+ *             - 1 read failed
+ * @note       the data and interrupt source registers are never read,
+ *             so no fifo entry is popped and no interrupt is cleared
  */
-uint8_t adxl345_get_interface(adxl345_handle_t *handle, adxl345_interface_t *interface) 
+static uint8_t a_adxl345_config_read(adxl345_handle_t *handle, uint8_t *buf, uint16_t fifo_len)
 {
-    if (handle == NULL)                                         /* check handle */
-    {
-        return 2;                                               /* return error */
-    }
-    
-    *interface = (adxl345_interface_t)(handle->iic_spi);        /* get interface */
-    
-    return 0;                                                   /* success return 0 */
+    adxl345_transfer_t xfer[3];
+    
+    xfer[0].reg = ADXL345_REG_THRESH_TAP;                                                        /* 0x1D - 0x2F */
+    xfer[0].rw = ADXL345_TRANSFER_READ;                                                          /* read */
+    xfer[0].len = ADXL345_REG_INT_MAP - ADXL345_REG_THRESH_TAP + 1;                              /* set length */
+    xfer[0].buf = &buf[0];                                                                       /* set buffer */
+    xfer[0].delay_us = 0;                                                                        /* no delay */
+    xfer[1].reg = ADXL345_REG_DATA_FORMAT;                                                       /* 0x31 */
+    xfer[1].rw = ADXL345_TRANSFER_READ;                                                          /* read */
+    xfer[1].len = 1;                                                                             /* set length */
+    xfer[1].buf = &buf[ADXL345_REG_DATA_FORMAT - ADXL345_REG_THRESH_TAP];                        /* set buffer */
+    xfer[1].delay_us = 0;                                                                        /* no delay */
+    xfer[2].reg = ADXL345_REG_FIFO_CTL;                                                          /* 0x38 or 0x38 - 0x39 */
+    xfer[2].rw = ADXL345_TRANSFER_READ;                                                          /* read */
+    xfer[2].len = fifo_len;                                                                      /* set length */
+    xfer[2].buf = &buf[ADXL345_REG_FIFO_CTL - ADXL345_REG_THRESH_TAP];                           /* set buffer */
+    xfer[2].delay_us = 0;                                                                        /* no delay */
+    
+    return a_adxl345_transfer(handle, xfer, 3);                                                  /* read all */
 }
 
 /**
- * @brief     set the iic address pin
+ * @brief     load the register cache from the chip
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] addr_pin is the address pin
  * @return    status code
  *            - 0 success
- *            - 2 handle is NULL
- * @note      none
+ *            - 1 read failed
+ * @note      the data and interrupt source registers are never read,
+ *            so no fifo entry is popped and no interrupt is cleared
  */
-uint8_t adxl345_set_addr_pin(adxl345_handle_t *handle, adxl345_address_t addr_pin)
+static uint8_t a_adxl345_cache_load(adxl345_handle_t *handle)
 {
-    if (handle == NULL)                        /* check handle */
+    handle->reg_cache_valid = 0;                                             /* flag invalid */
+    if (a_adxl345_config_read(handle, handle->reg_cache, 1) != 0)            /* read all */
     {
-        return 2;                              /* return error */
+        return 1;                                                            /* return error */
     }
-    
-    handle->iic_addr = (uint8_t)addr_pin;      /* set pin */
-    
-    return 0;                                  /* success return 0 */
+    handle->reg_cache_valid = 1;                                             /* flag valid */
+
+    return 0;                                                                /* success return 0 */
 }
 
 /**
- * @brief      get the iic address pin
+ * @brief      read configuration registers through the register cache
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *addr_pin points to a address pin buffer
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
  * @return     status code
  *             - 0 success
- *             - 2 handle is NULL
- * @note       none
+ *             - 1 read failed
+ * @note       falls back to a bus read when the cache is disabled or invalid
  */
-uint8_t adxl345_get_addr_pin(adxl345_handle_t *handle, adxl345_address_t *addr_pin)
+static uint8_t a_adxl345_cache_read(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle == NULL)                                       /* check handle */
+    uint16_t i;
+
+    if ((handle->reg_cache_enable != 0) && (handle->reg_cache_valid != 0))                 /* if cache is usable */
     {
-        return 2;                                             /* return error */
+        for (i = 0; i < len; i++)                                                          /* check all registers */
+        {
+            if (a_adxl345_cache_is_cached((uint16_t)(reg + i)) == 0)                       /* if not cached */
+            {
+                return a_adxl345_iic_spi_read(handle, reg, buf, len);                      /* read from the bus */
+            }
+        }
+        for (i = 0; i < len; i++)                                                          /* copy all registers */
+        {
+            buf[i] = handle->reg_cache[reg + i - ADXL345_REG_THRESH_TAP];                  /* read from the cache */
+        }
+
+        return 0;                                                                          /* success return 0 */
     }
-    
-    *addr_pin = (adxl345_address_t)(handle->iic_addr);        /* get pin */
-    
-    return 0;                                                 /* success return 0 */
+
+    return a_adxl345_iic_spi_read(handle, reg, buf, len);                                  /* read from the bus */
 }
 
 /**
- * @brief     set the tap threshold
+ * @brief     update the register cache and the read session after a register write
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] threshold is the tap threshold
- * @return    status code
- *            - 0 success
- *            - 1 set tap threshold failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
  * @note      none
  */
-uint8_t adxl345_set_tap_threshold(adxl345_handle_t *handle, uint8_t threshold)
+static void a_adxl345_cache_update(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle == NULL)                                                                  /* check handle */
+    uint16_t i;
+
+    if (handle->reg_cache_enable != 0)                                                     /* if cache is enabled */
     {
-        return 2;                                                                        /* return error */
+        for (i = 0; i < len; i++)                                                          /* update all registers */
+        {
+            if (a_adxl345_cache_is_cached((uint16_t)(reg + i)) != 0)                       /* if cached */
+            {
+                handle->reg_cache[reg + i - ADXL345_REG_THRESH_TAP] = buf[i];              /* update the cache */
+            }
+        }
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->session.prepared != 0)                                                     /* if session is prepared */
     {
-        return 3;                                                                        /* return error */
+        for (i = 0; i < len; i++)                                                          /* track all registers */
+        {
+            if ((reg + i) == ADXL345_REG_FIFO_CTL)                                         /* if fifo ctl */
+            {
+                handle->session.mode = buf[i] >> 6;                                        /* update mode */
+            }
+            else if ((reg + i) == ADXL345_REG_DATA_FORMAT)                                 /* if data format */
+            {
+                handle->session.full_res = (buf[i] >> 3) & 0x01;                           /* update full resolution */
+                handle->session.justify = (buf[i] >> 2) & 0x01;                            /* update justify */
+                handle->session.range = buf[i] & 0x03;                                     /* update range */
+                handle->session.format = buf[i] & 0x0F;                                    /* update format */
+            }
+        }
     }
-    
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_THRESH_TAP, &threshold, 1);       /* write config */
 }
 
 /**
- * @brief      get the tap threshold
- * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *threshold points to a tap threshold buffer
- * @return     status code
- *             - 0 success
- *             - 1 get tap threshold failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     write configuration registers through the register cache
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      write through, the cache and the read session are updated only after the bus write succeeds
  */
-uint8_t adxl345_get_tap_threshold(adxl345_handle_t *handle, uint8_t *threshold)
+static uint8_t a_adxl345_cache_write(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle == NULL)                                                                /* check handle */
-    {
-        return 2;                                                                      /* return error */
-    }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (a_adxl345_iic_spi_write(handle, reg, buf, len) != 0)        /* write to the bus */
     {
-        return 3;                                                                      /* return error */
+        return 1;                                                   /* return error */
     }
-    
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_THRESH_TAP, threshold, 1);       /* read config */
+    a_adxl345_cache_update(handle, reg, buf, len);                  /* update the cache */
+
+    return 0;                                                       /* success return 0 */
 }
 
 /**
- * @brief      convert the tap threshold to the register raw data
- * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  g is the tap threshold
- * @param[out] *reg points to a register raw buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief      encode a configuration into register values
+ * @param[in]  *config points to a configuration structure
+ * @param[out] *reg points to a register buffer of 0x1D - 0x38
+ * @note       the status, interrupt source and data registers are left zero
  */
-uint8_t adxl345_tap_threshold_convert_to_register(adxl345_handle_t *handle, float g, uint8_t *reg)
+static void a_adxl345_config_encode(const adxl345_config_t *config, uint8_t reg[28])
 {
-    if (handle == NULL)                   /* check handle */
-    {
-        return 2;                         /* return error */
-    }
-    if (handle->inited != 1)              /* check handle initialization */
-    {
-        return 3;                         /* return error */
-    }
-    
-    *reg = (uint8_t)(g / 0.0625f);        /* convert real data to register data */
-    
-    return 0;                             /* success return 0 */
+    uint8_t i;
+    uint8_t enable;
+    uint8_t map;
+    
+    memset(reg, 0, 28);                                                                                     /* clear the buffer */
+    reg[ADXL345_REG_THRESH_TAP - ADXL345_REG_THRESH_TAP] = config->tap_threshold;                           /* set tap threshold */
+    reg[ADXL345_REG_OFSX - ADXL345_REG_THRESH_TAP] = (uint8_t)config->offset_x;                             /* set x offset */
+    reg[ADXL345_REG_OFSY - ADXL345_REG_THRESH_TAP] = (uint8_t)config->offset_y;                             /* set y offset */
+    reg[ADXL345_REG_OFSZ - ADXL345_REG_THRESH_TAP] = (uint8_t)config->offset_z;                             /* set z offset */
+    reg[ADXL345_REG_DUR - ADXL345_REG_THRESH_TAP] = config->duration;                                       /* set duration */
+    reg[ADXL345_REG_LATENT - ADXL345_REG_THRESH_TAP] = config->latent;                                      /* set latent */
+    reg[ADXL345_REG_WINDOW - ADXL345_REG_THRESH_TAP] = config->window;                                      /* set window */
+    reg[ADXL345_REG_THRESH_ACT - ADXL345_REG_THRESH_TAP] = config->action_threshold;                        /* set action threshold */
+    reg[ADXL345_REG_THRESH_INACT - ADXL345_REG_THRESH_TAP] = config->inaction_threshold;                    /* set inaction threshold */
+    reg[ADXL345_REG_TIME_INACT - ADXL345_REG_THRESH_TAP] = config->inaction_time;                           /* set inaction time */
+    reg[ADXL345_REG_ACT_INACT_CTL - ADXL345_REG_THRESH_TAP] = (uint8_t)(((config->action_coupled & 0x01) << 7) |
+                                                              ((config->action_x & 0x01) << ADXL345_ACTION_X) |
+                                                              ((config->action_y & 0x01) << ADXL345_ACTION_Y) |
+                                                              ((config->action_z & 0x01) << ADXL345_ACTION_Z) |
+                                                              ((config->inaction_coupled & 0x01) << 3) |
+                                                              ((config->inaction_x & 0x01) << ADXL345_INACTION_X) |
+                                                              ((config->inaction_y & 0x01) << ADXL345_INACTION_Y) |
+                                                              ((config->inaction_z & 0x01) << ADXL345_INACTION_Z));  /* set action inaction */
+    reg[ADXL345_REG_THRESH_FF - ADXL345_REG_THRESH_TAP] = config->free_fall_threshold;                      /* set free fall threshold */
+    reg[ADXL345_REG_TIME_FF - ADXL345_REG_THRESH_TAP] = config->free_fall_time;                             /* set free fall time */
+    reg[ADXL345_REG_TAP_AXES - ADXL345_REG_THRESH_TAP] = (uint8_t)(((config->tap_suppress & 0x01) << 3) |
+                                                         ((config->tap_axis_x & 0x01) << ADXL345_TAP_AXIS_X) |
+                                                         ((config->tap_axis_y & 0x01) << ADXL345_TAP_AXIS_Y) |
+                                                         ((config->tap_axis_z & 0x01) << ADXL345_TAP_AXIS_Z));  /* set tap axes */
+    reg[ADXL345_REG_BW_RATE - ADXL345_REG_THRESH_TAP] = (uint8_t)(config->rate & 0x1F);                     /* set rate */
+    reg[ADXL345_REG_POWER_CTL - ADXL345_REG_THRESH_TAP] = (uint8_t)(((config->link_activity_inactivity & 0x01) << 5) |
+                                                          ((config->auto_sleep & 0x01) << 4) |
+                                                          ((config->measure & 0x01) << 3) |
+                                                          ((config->sleep & 0x01) << 2) |
+                                                          (config->sleep_frequency & 0x03));                 /* set power control */
+    enable = 0;                                                                                             /* init 0 */
+    map = 0;                                                                                                /* init 0 */
+    for (i = 0; i < 8; i++)                                                                                 /* set all interrupts */
+    {
+        enable |= (uint8_t)((config->interrupt[i] & 0x01) << i);                                            /* set interrupt */
+        map |= (uint8_t)((config->interrupt_map[i] & 0x01) << i);                                           /* set interrupt map */
+    }
+    reg[ADXL345_REG_INT_ENABLE - ADXL345_REG_THRESH_TAP] = enable;                                          /* set interrupt enable */
+    reg[ADXL345_REG_INT_MAP - ADXL345_REG_THRESH_TAP] = map;                                                /* set interrupt map */
+    reg[ADXL345_REG_DATA_FORMAT - ADXL345_REG_THRESH_TAP] = (uint8_t)(((config->self_test & 0x01) << 7) |
+                                                            ((config->spi_wire & 0x01) << 6) |
+                                                            ((config->interrupt_active_level & 0x01) << 5) |
+                                                            ((config->full_resolution & 0x01) << 3) |
+                                                            ((config->justify & 0x01) << 2) |
+                                                            (config->range & 0x03));                         /* set data format */
+    reg[ADXL345_REG_FIFO_CTL - ADXL345_REG_THRESH_TAP] = (uint8_t)(((config->mode & 0x03) << 6) |
+                                                         ((config->trigger_pin & 0x01) << 5) |
+                                                         (config->watermark & 0x1F));                        /* set fifo control */
 }
 
 /**
- * @brief      convert the register raw data to the tap threshold
- * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  reg is the register raw data
- * @param[out] *g points to a tap threshold buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
+ * @brief      decode register values into a configuration
+ * @param[in]  *reg points to a register buffer of 0x1D - 0x38
+ * @param[out] *config points to a configuration structure
  * @note       none
  */
-uint8_t adxl345_tap_threshold_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *g)
+static void a_adxl345_config_decode(const uint8_t reg[28], adxl345_config_t *config)
 {
-    if (handle == NULL)                 /* check handle */
+    uint8_t i;
+    uint8_t prev;
+    
+    config->tap_threshold = reg[ADXL345_REG_THRESH_TAP - ADXL345_REG_THRESH_TAP];                 /* get tap threshold */
+    config->offset_x = (int8_t)reg[ADXL345_REG_OFSX - ADXL345_REG_THRESH_TAP];                    /* get x offset */
+    config->offset_y = (int8_t)reg[ADXL345_REG_OFSY - ADXL345_REG_THRESH_TAP];                    /* get y offset */
+    config->offset_z = (int8_t)reg[ADXL345_REG_OFSZ - ADXL345_REG_THRESH_TAP];                    /* get z offset */
+    config->duration = reg[ADXL345_REG_DUR - ADXL345_REG_THRESH_TAP];                             /* get duration */
+    config->latent = reg[ADXL345_REG_LATENT - ADXL345_REG_THRESH_TAP];                            /* get latent */
+    config->window = reg[ADXL345_REG_WINDOW - ADXL345_REG_THRESH_TAP];                            /* get window */
+    config->action_threshold = reg[ADXL345_REG_THRESH_ACT - ADXL345_REG_THRESH_TAP];              /* get action threshold */
+    config->inaction_threshold = reg[ADXL345_REG_THRESH_INACT - ADXL345_REG_THRESH_TAP];          /* get inaction threshold */
+    config->inaction_time = reg[ADXL345_REG_TIME_INACT - ADXL345_REG_THRESH_TAP];                 /* get inaction time */
+    prev = reg[ADXL345_REG_ACT_INACT_CTL - ADXL345_REG_THRESH_TAP];                               /* get action inaction */
+    config->action_coupled = (adxl345_coupled_t)((prev >> 7) & 0x01);                             /* get action coupled */
+    config->action_x = (adxl345_bool_t)((prev >> ADXL345_ACTION_X) & 0x01);                       /* get x axis action */
+    config->action_y = (adxl345_bool_t)((prev >> ADXL345_ACTION_Y) & 0x01);                       /* get y axis action */
+    config->action_z = (adxl345_bool_t)((prev >> ADXL345_ACTION_Z) & 0x01);                       /* get z axis action */
+    config->inaction_coupled = (adxl345_coupled_t)((prev >> 3) & 0x01);                           /* get inaction coupled */
+    config->inaction_x = (adxl345_bool_t)((prev >> ADXL345_INACTION_X) & 0x01);                   /* get x axis inaction */
+    config->inaction_y = (adxl345_bool_t)((prev >> ADXL345_INACTION_Y) & 0x01);                   /* get y axis inaction */
+    config->inaction_z = (adxl345_bool_t)((prev >> ADXL345_INACTION_Z) & 0x01);                   /* get z axis inaction */
+    config->free_fall_threshold = reg[ADXL345_REG_THRESH_FF - ADXL345_REG_THRESH_TAP];            /* get free fall threshold */
+    config->free_fall_time = reg[ADXL345_REG_TIME_FF - ADXL345_REG_THRESH_TAP];                   /* get free fall time */
+    prev = reg[ADXL345_REG_TAP_AXES - ADXL345_REG_THRESH_TAP];                                    /* get tap axes */
+    config->tap_suppress = (adxl345_bool_t)((prev >> 3) & 0x01);                                  /* get tap suppress */
+    config->tap_axis_x = (adxl345_bool_t)((prev >> ADXL345_TAP_AXIS_X) & 0x01);                   /* get x axis tap */
+    config->tap_axis_y = (adxl345_bool_t)((prev >> ADXL345_TAP_AXIS_Y) & 0x01);                   /* get y axis tap */
+    config->tap_axis_z = (adxl345_bool_t)((prev >> ADXL345_TAP_AXIS_Z) & 0x01);                   /* get z axis tap */
+    config->rate = (adxl345_rate_t)(reg[ADXL345_REG_BW_RATE - ADXL345_REG_THRESH_TAP] & 0x1F);    /* get rate */
+    prev = reg[ADXL345_REG_POWER_CTL - ADXL345_REG_THRESH_TAP];                                   /* get power control */
+    config->link_activity_inactivity = (adxl345_bool_t)((prev >> 5) & 0x01);                      /* get link */
+    config->auto_sleep = (adxl345_bool_t)((prev >> 4) & 0x01);                                    /* get auto sleep */
+    config->measure = (adxl345_bool_t)((prev >> 3) & 0x01);                                       /* get measure */
+    config->sleep = (adxl345_bool_t)((prev >> 2) & 0x01);                                         /* get sleep */
+    config->sleep_frequency = (adxl345_sleep_frequency_t)(prev & 0x03);                           /* get sleep frequency */
+    for (i = 0; i < 8; i++)                                                                       /* get all interrupts */
+    {
+        config->interrupt[i] = (adxl345_bool_t)
+                               ((reg[ADXL345_REG_INT_ENABLE - ADXL345_REG_THRESH_TAP] >> i) & 0x01);       /* get interrupt */
+        config->interrupt_map[i] = (adxl345_interrupt_pin_t)
+                                   ((reg[ADXL345_REG_INT_MAP - ADXL345_REG_THRESH_TAP] >> i) & 0x01);      /* get interrupt map */
+    }
+    prev = reg[ADXL345_REG_DATA_FORMAT - ADXL345_REG_THRESH_TAP];                                 /* get data format */
+    config->self_test = (adxl345_bool_t)((prev >> 7) & 0x01);                                     /* get self test */
+    config->spi_wire = (adxl345_spi_wire_t)((prev >> 6) & 0x01);                                  /* get spi wire */
+    config->interrupt_active_level = (adxl345_interrupt_active_level_t)((prev >> 5) & 0x01);      /* get active level */
+    config->full_resolution = (adxl345_bool_t)((prev >> 3) & 0x01);                               /* get full resolution */
+    config->justify = (adxl345_justify_t)((prev >> 2) & 0x01);                                    /* get justify */
+    config->range = (adxl345_range_t)(prev & 0x03);                                               /* get range */
+    prev = reg[ADXL345_REG_FIFO_CTL - ADXL345_REG_THRESH_TAP];                                    /* get fifo control */
+    config->mode = (adxl345_mode_t)((prev >> 6) & 0x03);                                          /* get mode */
+    config->trigger_pin = (adxl345_interrupt_pin_t)((prev >> 5) & 0x01);                          /* get trigger pin */
+    config->watermark = prev & 0x1F;                                                              /* get watermark */
+}
+
+/**
+ * @brief     write configuration register values in contiguous bursts
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *reg points to a register buffer of 0x1D - 0x38
+ * @param[in] force is the force write flag
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the power control register is written last so that measuring starts on the new configuration,
+ *            without force the bytes matching a valid register cache are trimmed from both ends of each burst
+ */
+static uint8_t a_adxl345_config_write(adxl345_handle_t *handle, uint8_t reg[28], uint8_t force)
+{
+    const uint8_t run[4][2] = {{ADXL345_REG_THRESH_TAP, ADXL345_REG_TAP_AXES},
+                               {ADXL345_REG_DATA_FORMAT, ADXL345_REG_DATA_FORMAT},
+                               {ADXL345_REG_FIFO_CTL, ADXL345_REG_FIFO_CTL},
+                               {ADXL345_REG_BW_RATE, ADXL345_REG_INT_MAP}};
+    adxl345_transfer_t xfer[4];
+    uint8_t first;
+    uint8_t last;
+    uint8_t skip;
+    uint16_t num;
+    uint16_t i;
+    
+    skip = (uint8_t)((force == 0) && (handle->reg_cache_enable != 0) && (handle->reg_cache_valid != 0));      /* check the cache */
+    num = 0;                                                                                                  /* init 0 */
+    for (i = 0; i < 4; i++)                                                                                   /* check all runs */
+    {
+        first = run[i][0];                                                                                    /* set first */
+        last = run[i][1];                                                                                     /* set last */
+        if (skip != 0)                                                                                        /* if skip */
+        {
+            while ((first <= last) &&
+                   (reg[first - ADXL345_REG_THRESH_TAP] == handle->reg_cache[first - ADXL345_REG_THRESH_TAP]))  /* trim the head */
+            {
+                first++;                                                                                      /* next */
+            }
+            while ((last > first) &&
+                   (reg[last - ADXL345_REG_THRESH_TAP] == handle->reg_cache[last - ADXL345_REG_THRESH_TAP]))    /* trim the tail */
+            {
+                last--;                                                                                       /* previous */
+            }
+            if (first > last)                                                                                 /* nothing changed */
+            {
+                continue;                                                                                     /* skip this run */
+            }
+        }
+        xfer[num].reg = first;                                                                                /* set register */
+        xfer[num].rw = ADXL345_TRANSFER_WRITE;                                                                /* write */
+        xfer[num].len = (uint16_t)(last - first + 1);                                                         /* set length */
+        xfer[num].buf = &reg[first - ADXL345_REG_THRESH_TAP];                                                 /* set buffer */
+        xfer[num].delay_us = 0;                                                                               /* no delay */
+        num++;                                                                                                /* next segment */
+    }
+    if (num == 0)                                                                                             /* nothing to write */
     {
-        return 2;                       /* return error */
+        return 0;                                                                                             /* success return 0 */
     }
-    if (handle->inited != 1)            /* check handle initialization */
+    if (a_adxl345_transfer(handle, xfer, num) != 0)                                                           /* write all */
     {
-        return 3;                       /* return error */
+        handle->reg_cache_valid = 0;                                                                          /* flag invalid */
+        
+        return 1;                                                                                             /* return error */
+    }
+    for (i = 0; i < num; i++)                                                                                 /* update all runs */
+    {
+        a_adxl345_cache_update(handle, (uint8_t)(xfer[i].reg & 0x3F), xfer[i].buf, xfer[i].len);              /* update the cache */
     }
     
-    *g = (float)(reg) * 0.0625f;        /* convert raw data to real data */
-    
-    return 0;                           /* success return 0 */
+    return 0;                                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the axis offset
+ * @brief     set the chip interface
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] x is the x axis offset
- * @param[in] y is the y axis offset
- * @param[in] z is the z axis offset
+ * @param[in] interface is the chip interface
  * @return    status code
  *            - 0 success
- *            - 1 set offset failed
  *            - 2 handle is NULL
- *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_offset(adxl345_handle_t *handle, int8_t x, int8_t y, int8_t z) 
+uint8_t adxl345_set_interface(adxl345_handle_t *handle, adxl345_interface_t interface) 
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                              /* check handle */
-    {
-        return 2;                                                                    /* return error */
-    }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle == NULL)                          /* check handle */
     {
-        return 3;                                                                    /* return error */
+        return 2;                                /* return error */
     }
     
-    res = a_adxl345_iic_spi_write(handle, ADXL345_REG_OFSX, (uint8_t *)&x, 1);       /* write config */
-    if (res != 0)                                                                    /* check result */
-    {
-        handle->debug_print("adxl345: write failed.\n");                             /* write failed */
-       
-        return 1;                                                                    /* return error */
-    }
-    res = a_adxl345_iic_spi_write(handle, ADXL345_REG_OFSY, (uint8_t *)&y, 1);       /* write config */
-    if (res != 0)                                                                    /* check result */
-    {
-        handle->debug_print("adxl345: write failed.\n");                             /* write failed */
-       
-        return 1;                                                                    /* return error */
-    }
-    res = a_adxl345_iic_spi_write(handle, ADXL345_REG_OFSZ, (uint8_t *)&z, 1);       /* write config */
-    if (res != 0)                                                                    /* check result */
-    {
-        handle->debug_print("adxl345: write failed.\n");                             /* write failed */
-       
-        return 1;                                                                    /* return error */
-    }
-
-    return 0;                                                                        /* success return 0 */ 
+    handle->iic_spi = (uint8_t)interface;        /* set interface */
+    
+    return 0;                                    /* success return 0 */
 }
 
 /**
- * @brief      get the axis offset
+ * @brief      get the chip interface
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *x points to a x axis offset
- * @param[out] *y points to a y axis offset
- * @param[out] *z points to a z axis offset
+ * @param[out] *interface points to a chip interface buffer
  * @return     status code
  *             - 0 success
- *             - 1 get offset failed
  *             - 2 handle is NULL
- *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_offset(adxl345_handle_t *handle, int8_t *x, int8_t *y, int8_t *z) 
+uint8_t adxl345_get_interface(adxl345_handle_t *handle, adxl345_interface_t *interface) 
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                            /* check handle */
-    {
-        return 2;                                                                  /* return error */
-    }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (handle == NULL)                                         /* check handle */
     {
-        return 3;                                                                  /* return error */
+        return 2;                                               /* return error */
     }
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_OFSX, (uint8_t *)x, 1);       /* read config */
-    if (res != 0)                                                                  /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                            /* read failed */
-       
-        return 1;                                                                  /* return error */
-    }
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_OFSY, (uint8_t *)y, 1);       /* read config */
-    if (res != 0)                                                                  /* check result */
+    *interface = (adxl345_interface_t)(handle->iic_spi);        /* get interface */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the register cache
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 load register cache failed
+ *            - 2 handle is NULL
+ * @note      it can be called before or after the init function,
+ *            if the chip is initialized the cache is loaded immediately
+ */
+uint8_t adxl345_set_register_cache(adxl345_handle_t *handle, adxl345_bool_t enable)
+{
+    if (handle == NULL)                                                         /* check handle */
     {
-        handle->debug_print("adxl345: read failed.\n");                            /* read failed */
-       
-        return 1;                                                                  /* return error */
+        return 2;                                                               /* return error */
     }
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_OFSZ, (uint8_t *)z, 1);       /* read config */
-    if (res != 0)                                                                  /* check result */
+    
+    a_adxl345_lock(handle);                                                     /* lock */
+    handle->reg_cache_enable = (uint8_t)enable;                                 /* set enable */
+    handle->reg_cache_valid = 0;                                                /* flag invalid */
+    if ((enable != 0) && (handle->inited == 1))                                 /* if enable and inited */
     {
-        handle->debug_print("adxl345: read failed.\n");                            /* read failed */
-       
-        return 1;                                                                  /* return error */
+        if (a_adxl345_cache_load(handle) != 0)                                  /* load register cache */
+        {
+            handle->debug_print("adxl345: load register cache failed.\n");      /* load register cache failed */
+            a_adxl345_unlock(handle);                                           /* unlock */
+            
+            return 1;                                                           /* return error */
+        }
     }
-
-    return 0;                                                                      /* success return 0 */
+    a_adxl345_unlock(handle);                                                   /* unlock */
+    
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief      convert the offset to the register raw data
+ * @brief      get the register cache status
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  g is the offset
- * @param[out] *reg points to a register raw buffer
+ * @param[out] *enable points to a bool value buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
- *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_offset_convert_to_register(adxl345_handle_t *handle, float g, int8_t *reg)
+uint8_t adxl345_get_register_cache(adxl345_handle_t *handle, adxl345_bool_t *enable)
 {
-    if (handle == NULL)                  /* check handle */
-    {
-        return 2;                        /* return error */
-    }
-    if (handle->inited != 1)             /* check handle initialization */
+    if (handle == NULL)                                            /* check handle */
     {
-        return 3;                        /* return error */
+        return 2;                                                  /* return error */
     }
     
-    *reg = (int8_t)(g / 0.0156f);        /* convert real data to register data */
+    *enable = (adxl345_bool_t)(handle->reg_cache_enable);          /* get enable */
     
-    return 0;                            /* success return 0 */
+    return 0;                                                      /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the offset
- * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  reg is the register raw data
- * @param[out] *g points to a offset buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     reload the register cache from the chip
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 load register cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 register cache is disabled
+ * @note      call it after the chip has been changed behind the driver,
+ *            e.g. after a power cycle or an external write
  */
-uint8_t adxl345_offset_convert_to_data(adxl345_handle_t *handle, int8_t reg, float *g)
+uint8_t adxl345_register_cache_sync(adxl345_handle_t *handle)
 {
-    if (handle == NULL)                 /* check handle */
+    if (handle == NULL)                                                     /* check handle */
     {
-        return 2;                       /* return error */
+        return 2;                                                           /* return error */
     }
-    if (handle->inited != 1)            /* check handle initialization */
+    if (handle->inited != 1)                                                /* check handle initialization */
     {
-        return 3;                       /* return error */
+        return 3;                                                           /* return error */
+    }
+    a_adxl345_lock(handle);                                                 /* lock */
+    ADXL345_TRACE_API(handle);                                              /* tag the api */
+    if (handle->reg_cache_enable == 0)                                      /* check register cache */
+    {
+        handle->debug_print("adxl345: register cache is disabled.\n");      /* register cache is disabled */
+        a_adxl345_unlock(handle);                                           /* unlock */
+        
+        return 4;                                                           /* return error */
     }
     
-    *g = (float)(reg) * 0.0156f;        /* convert raw data to real data */
+    if (a_adxl345_cache_load(handle) != 0)                                  /* load register cache */
+    {
+        handle->debug_print("adxl345: load register cache failed.\n");      /* load register cache failed */
+        a_adxl345_unlock(handle);                                           /* unlock */
+        
+        return 1;                                                           /* return error */
+    }
+    a_adxl345_unlock(handle);                                               /* unlock */
     
-    return 0;                           /* success return 0 */
+    return 0;                                                               /* success return 0 */
 }
 
 /**
- * @brief     set the duration
+ * @brief     apply a whole configuration
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] t is the duration
+ * @param[in] *config points to a configuration structure
  * @return    status code
  *            - 0 success
- *            - 1 set duration failed
+ *            - 1 apply config failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the registers are written as contiguous bursts and the power control register is written last,
+ *            with the register cache enabled the registers already holding the value are skipped
  */
-uint8_t adxl345_set_duration(adxl345_handle_t *handle, uint8_t t) 
+uint8_t adxl345_apply_config(adxl345_handle_t *handle, const adxl345_config_t *config)
 {
+    uint8_t reg[28];
+    
     if (handle == NULL)                                                   /* check handle */
     {
         return 2;                                                         /* return error */
@@ -533,143 +1038,237 @@ uint8_t adxl345_set_duration(adxl345_handle_t *handle, uint8_t t)
     {
         return 3;                                                         /* return error */
     }
+    a_adxl345_lock(handle);                                               /* lock */
+    ADXL345_TRACE_API(handle);                                            /* tag the api */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_DUR, &t, 1);       /* write config */
-}
-
+    a_adxl345_config_encode(config, reg);                                 /* encode the config */
+    if (a_adxl345_config_write(handle, reg, 0) != 0)                      /* write the config */
+    {
+        handle->debug_print("adxl345: apply config failed.\n");           /* apply config failed */
+        a_adxl345_unlock(handle);                                         /* unlock */
+        
+        return 1;                                                         /* return error */
+    }
+    a_adxl345_unlock(handle);                                             /* unlock */
+    
+    return 0;                                                             /* success return 0 */
+}
+
 /**
- * @brief      get the duration
+ * @brief      read the whole configuration
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *t points to a duration buffer
+ * @param[out] *snapshot points to a configuration snapshot structure
  * @return     status code
  *             - 0 success
- *             - 1 get duration failed
+ *             - 1 config snapshot failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       0x1D - 0x2F, 0x31 and 0x38 - 0x39 are read as three segments of one transfer call,
+ *             the interrupt source and data registers are skipped so no interrupt is cleared and no fifo entry is popped
  */
-uint8_t adxl345_get_duration(adxl345_handle_t *handle, uint8_t *t)
+uint8_t adxl345_config_snapshot(adxl345_handle_t *handle, adxl345_config_snapshot_t *snapshot)
 {
-    if (handle == NULL)                                                 /* check handle */
+    uint8_t buf[29];
+    uint8_t status;
+    
+    if (handle == NULL)                                                                                                   /* check handle */
     {
-        return 2;                                                       /* return error */
+        return 2;                                                                                                         /* return error */
     }
-    if (handle->inited != 1)                                            /* check handle initialization */
+    if (handle->inited != 1)                                                                                              /* check handle initialization */
     {
-        return 3;                                                       /* return error */
+        return 3;                                                                                                         /* return error */
     }
+    a_adxl345_lock(handle);                                                                                               /* lock */
+    ADXL345_TRACE_API(handle);                                                                                            /* tag the api */
     
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_DUR, t, 1);       /* read config */
+    memset(buf, 0, sizeof(buf));                                                                                          /* clear the buffer */
+    if (a_adxl345_config_read(handle, buf, 2) != 0)                                                                       /* read all */
+    {
+        handle->debug_print("adxl345: config snapshot failed.\n");                                                        /* config snapshot failed */
+        a_adxl345_unlock(handle);                                                                                         /* unlock */
+        
+        return 1;                                                                                                         /* return error */
+    }
+    if (handle->reg_cache_enable != 0)                                                                                    /* if cache is enabled */
+    {
+        memcpy(handle->reg_cache, buf, 28);                                                                               /* refresh the cache */
+        handle->reg_cache_valid = 1;                                                                                      /* flag valid */
+    }
+    a_adxl345_config_decode(buf, &snapshot->config);                                                                      /* decode the config */
+    (void)adxl345_tap_threshold_convert_to_data(handle, snapshot->config.tap_threshold, &snapshot->tap_threshold_g);      /* convert tap threshold */
+    (void)adxl345_offset_convert_to_data(handle, snapshot->config.offset_x, &snapshot->offset_x_g);                      /* convert x offset */
+    (void)adxl345_offset_convert_to_data(handle, snapshot->config.offset_y, &snapshot->offset_y_g);                      /* convert y offset */
+    (void)adxl345_offset_convert_to_data(handle, snapshot->config.offset_z, &snapshot->offset_z_g);                      /* convert z offset */
+    (void)adxl345_duration_convert_to_data(handle, snapshot->config.duration, &snapshot->duration_us);                   /* convert duration */
+    (void)adxl345_latent_convert_to_data(handle, snapshot->config.latent, &snapshot->latent_ms);                         /* convert latent */
+    (void)adxl345_window_convert_to_data(handle, snapshot->config.window, &snapshot->window_ms);                         /* convert window */
+    (void)adxl345_action_threshold_convert_to_data(handle, snapshot->config.action_threshold,
+                                                   &snapshot->action_threshold_g);                                       /* convert action threshold */
+    (void)adxl345_inaction_threshold_convert_to_data(handle, snapshot->config.inaction_threshold,
+                                                     &snapshot->inaction_threshold_g);                                   /* convert inaction threshold */
+    (void)adxl345_inaction_time_convert_to_data(handle, snapshot->config.inaction_time, &snapshot->inaction_time_s);     /* convert inaction time */
+    (void)adxl345_free_fall_threshold_convert_to_data(handle, snapshot->config.free_fall_threshold,
+                                                      &snapshot->free_fall_threshold_g);                                 /* convert free fall threshold */
+    (void)adxl345_free_fall_time_convert_to_data(handle, snapshot->config.free_fall_time, &snapshot->free_fall_time_ms); /* convert free fall time */
+    snapshot->action_tap_status = buf[ADXL345_REG_ACT_TAP_STATUS - ADXL345_REG_THRESH_TAP];                               /* get action tap status */
+    status = buf[ADXL345_REG_FIFO_STATUS - ADXL345_REG_THRESH_TAP];                                                       /* get fifo status */
+    snapshot->trigger_status = (adxl345_trigger_status_t)((status >> 7) & 0x01);                                          /* get trigger status */
+    snapshot->fifo_level = status & 0x3F;                                                                                 /* get fifo level */
+    a_adxl345_unlock(handle);                                                                                             /* unlock */
+    
+    return 0;                                                                                                             /* success return 0 */
 }
 
 /**
- * @brief      convert the duration to the register raw data
- * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  us is the duration
- * @param[out] *reg points to a register raw buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     write a configuration snapshot back
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *snapshot points to a configuration snapshot structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 config restore failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      all registers are written whatever the register cache holds, so it can be used after a chip reset
  */
-uint8_t adxl345_duration_convert_to_register(adxl345_handle_t *handle, uint32_t us, uint8_t *reg)
+uint8_t adxl345_config_restore(adxl345_handle_t *handle, const adxl345_config_snapshot_t *snapshot)
 {
-    if (handle == NULL)                /* check handle */
-    { 
-        return 2;                      /* return error */
+    uint8_t reg[28];
+    
+    if (handle == NULL)                                                   /* check handle */
+    {
+        return 2;                                                         /* return error */
     }
-    if (handle->inited != 1)           /* check handle initialization */
+    if (handle->inited != 1)                                              /* check handle initialization */
     {
-        return 3;                      /* return error */
+        return 3;                                                         /* return error */
     }
+    a_adxl345_lock(handle);                                               /* lock */
+    ADXL345_TRACE_API(handle);                                            /* tag the api */
     
-    *reg = (uint8_t)(us / 625);        /* convert real data to register data */
+    a_adxl345_config_encode(&snapshot->config, reg);                      /* encode the config */
+    if (a_adxl345_config_write(handle, reg, 1) != 0)                      /* write the config */
+    {
+        handle->debug_print("adxl345: config restore failed.\n");         /* config restore failed */
+        a_adxl345_unlock(handle);                                         /* unlock */
+        
+        return 1;                                                         /* return error */
+    }
+    a_adxl345_unlock(handle);                                             /* unlock */
     
-    return 0;                          /* success return 0 */
+    return 0;                                                             /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the duration
+ * @brief     set the iic address pin
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] addr_pin is the address pin
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t adxl345_set_addr_pin(adxl345_handle_t *handle, adxl345_address_t addr_pin)
+{
+    if (handle == NULL)                        /* check handle */
+    {
+        return 2;                              /* return error */
+    }
+    
+    handle->iic_addr = (uint8_t)addr_pin;      /* set pin */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the iic address pin
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  reg is the register raw data
- * @param[out] *us points to a duration buffer
+ * @param[out] *addr_pin points to a address pin buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
- *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_duration_convert_to_data(adxl345_handle_t *handle, uint8_t reg, uint32_t *us)
+uint8_t adxl345_get_addr_pin(adxl345_handle_t *handle, adxl345_address_t *addr_pin)
 {
-    if (handle == NULL)                             /* check handle */
-    {
-        return 2;                                   /* return error */
-    }
-    if (handle->inited != 1)                        /* check handle initialization */
+    if (handle == NULL)                                       /* check handle */
     {
-        return 3;                                   /* return error */
+        return 2;                                             /* return error */
     }
     
-    *us = (uint32_t)((float)(reg) * 625.0f);        /* convert raw data to real data */
+    *addr_pin = (adxl345_address_t)(handle->iic_addr);        /* get pin */
     
-    return 0;                                       /* success return 0 */
+    return 0;                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the latent
+ * @brief     set the tap threshold
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] t is the latent time
+ * @param[in] threshold is the tap threshold
  * @return    status code
  *            - 0 success
- *            - 1 set latent failed
+ *            - 1 set tap threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_latent(adxl345_handle_t *handle, uint8_t t) 
+uint8_t adxl345_set_tap_threshold(adxl345_handle_t *handle, uint8_t threshold)
 {
-    if (handle == NULL)                                                      /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                            /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                            /* return error */
+        return 3;                                                                        /* return error */
     }
+    a_adxl345_lock(handle);                                                              /* lock */
+    ADXL345_TRACE_API(handle);                                                           /* tag the api */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_LATENT, &t, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_THRESH_TAP, &threshold, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                            /* unlock */
+    
+    return res;                                                                          /* return the result */
 }
 
 /**
- * @brief      get the latent
+ * @brief      get the tap threshold
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *t points to a latent time buffer
+ * @param[out] *threshold points to a tap threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get latent failed
+ *             - 1 get tap threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_latent(adxl345_handle_t *handle, uint8_t *t)
+uint8_t adxl345_get_tap_threshold(adxl345_handle_t *handle, uint8_t *threshold)
 {
-    if (handle == NULL)                                                    /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                          /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                               /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                          /* return error */
+        return 3;                                                                      /* return error */
     }
+    a_adxl345_lock(handle);                                                            /* lock */
+    ADXL345_TRACE_API(handle);                                                         /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_THRESH_TAP, threshold, 1);          /* read config */
+    a_adxl345_unlock(handle);                                                          /* unlock */
     
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_LATENT, t, 1);       /* read config */
+    return res;                                                                        /* return the result */
 }
 
 /**
- * @brief      convert the latent to the register raw data
+ * @brief      convert the tap threshold to the register raw data
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  ms is the time
+ * @param[in]  g is the tap threshold
  * @param[out] *reg points to a register raw buffer
  * @return     status code
  *             - 0 success
@@ -677,103 +1276,167 @@ uint8_t adxl345_get_latent(adxl345_handle_t *handle, uint8_t *t)
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_latent_convert_to_register(adxl345_handle_t *handle, float ms, uint8_t *reg)
+uint8_t adxl345_tap_threshold_convert_to_register(adxl345_handle_t *handle, float g, uint8_t *reg)
 {
-    if (handle == NULL)                  /* check handle */
+    if (handle == NULL)                   /* check handle */
     {
-        return 2;                        /* return error */
+        return 2;                         /* return error */
     }
-    if (handle->inited != 1)             /* check handle initialization */
+    if (handle->inited != 1)              /* check handle initialization */
     {
-        return 3;                        /* return error */
+        return 3;                         /* return error */
     }
     
-    *reg = (uint8_t)(ms / 1.25f);        /* convert real data to register data */
+    *reg = (uint8_t)(g / 0.0625f);        /* convert real data to register data */
     
-    return 0;                            /* success return 0 */
+    return 0;                             /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the latent
+ * @brief      convert the register raw data to the tap threshold
  * @param[in]  *handle points to a adxl345 handle structure
  * @param[in]  reg is the register raw data
- * @param[out] *ms points to a latent buffer
+ * @param[out] *g points to a tap threshold buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_latent_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *ms)
+uint8_t adxl345_tap_threshold_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *g)
 {
-    if (handle == NULL)                /* check handle */
+    if (handle == NULL)                 /* check handle */
     {
-        return 2;                      /* return error */
+        return 2;                       /* return error */
     }
-    if (handle->inited != 1)           /* check handle initialization */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        return 3;                      /* return error */
+        return 3;                       /* return error */
     }
     
-    *ms = (float)(reg) * 1.25f;        /* convert raw data to real data */
+    *g = (float)(reg) * 0.0625f;        /* convert raw data to real data */
     
-    return 0;                          /* success return 0 */
+    return 0;                           /* success return 0 */
 }
 
 /**
- * @brief     set the window
+ * @brief     set the axis offset
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] t is the window time
+ * @param[in] x is the x axis offset
+ * @param[in] y is the y axis offset
+ * @param[in] z is the z axis offset
  * @return    status code
  *            - 0 success
- *            - 1 set window failed
+ *            - 1 set offset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_window(adxl345_handle_t *handle, uint8_t t)
+uint8_t adxl345_set_offset(adxl345_handle_t *handle, int8_t x, int8_t y, int8_t z) 
 {
-    if (handle == NULL)                                                      /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                            /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                            /* return error */
+        return 3;                                                                    /* return error */
     }
+    a_adxl345_lock(handle);                                                          /* lock */
+    ADXL345_TRACE_API(handle);                                                       /* tag the api */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_WINDOW, &t, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_OFSX, (uint8_t *)&x, 1);         /* write config */
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("adxl345: write failed.\n");                             /* write failed */
+        a_adxl345_unlock(handle);                                                    /* unlock */
+       
+        return 1;                                                                    /* return error */
+    }
+    res = a_adxl345_cache_write(handle, ADXL345_REG_OFSY, (uint8_t *)&y, 1);         /* write config */
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("adxl345: write failed.\n");                             /* write failed */
+        a_adxl345_unlock(handle);                                                    /* unlock */
+       
+        return 1;                                                                    /* return error */
+    }
+    res = a_adxl345_cache_write(handle, ADXL345_REG_OFSZ, (uint8_t *)&z, 1);         /* write config */
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("adxl345: write failed.\n");                             /* write failed */
+        a_adxl345_unlock(handle);                                                    /* unlock */
+       
+        return 1;                                                                    /* return error */
+    }
+    a_adxl345_unlock(handle);                                                        /* unlock */
+
+    return 0;                                                                        /* success return 0 */ 
 }
 
 /**
- * @brief      get the window
+ * @brief      get the axis offset
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *t points to a window time buffer
+ * @param[out] *x points to a x axis offset
+ * @param[out] *y points to a y axis offset
+ * @param[out] *z points to a z axis offset
  * @return     status code
  *             - 0 success
- *             - 1 get window failed
+ *             - 1 get offset failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_window(adxl345_handle_t *handle, uint8_t *t)
+uint8_t adxl345_get_offset(adxl345_handle_t *handle, int8_t *x, int8_t *y, int8_t *z) 
 {
-    if (handle == NULL)                                                    /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                            /* check handle */
     {
-        return 2;                                                          /* return error */
+        return 2;                                                                  /* return error */
     }
-    if (handle->inited != 1)                                               /* check handle initialization */
+    if (handle->inited != 1)                                                       /* check handle initialization */
     {
-        return 3;                                                          /* return error */
+        return 3;                                                                  /* return error */
     }
+    a_adxl345_lock(handle);                                                        /* lock */
+    ADXL345_TRACE_API(handle);                                                     /* tag the api */
     
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_WINDOW, t, 1);       /* read config */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_OFSX, (uint8_t *)x, 1);         /* read config */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                            /* read failed */
+        a_adxl345_unlock(handle);                                                  /* unlock */
+       
+        return 1;                                                                  /* return error */
+    }
+    res = a_adxl345_cache_read(handle, ADXL345_REG_OFSY, (uint8_t *)y, 1);         /* read config */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                            /* read failed */
+        a_adxl345_unlock(handle);                                                  /* unlock */
+       
+        return 1;                                                                  /* return error */
+    }
+    res = a_adxl345_cache_read(handle, ADXL345_REG_OFSZ, (uint8_t *)z, 1);         /* read config */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                            /* read failed */
+        a_adxl345_unlock(handle);                                                  /* unlock */
+       
+        return 1;                                                                  /* return error */
+    }
+    a_adxl345_unlock(handle);                                                      /* unlock */
+
+    return 0;                                                                      /* success return 0 */
 }
 
 /**
- * @brief      convert the window time to the register raw data
+ * @brief      convert the offset to the register raw data
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  ms is the window time
+ * @param[in]  g is the offset
  * @param[out] *reg points to a register raw buffer
  * @return     status code
  *             - 0 success
@@ -781,7 +1444,7 @@ uint8_t adxl345_get_window(adxl345_handle_t *handle, uint8_t *t)
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_window_convert_to_register(adxl345_handle_t *handle, float ms, uint8_t *reg)
+uint8_t adxl345_offset_convert_to_register(adxl345_handle_t *handle, float g, int8_t *reg)
 {
     if (handle == NULL)                  /* check handle */
     {
@@ -792,92 +1455,106 @@ uint8_t adxl345_window_convert_to_register(adxl345_handle_t *handle, float ms, u
         return 3;                        /* return error */
     }
     
-    *reg = (uint8_t)(ms / 1.25f);        /* convert real data to register data */
+    *reg = (int8_t)(g / 0.0156f);        /* convert real data to register data */
     
     return 0;                            /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the window time
+ * @brief      convert the register raw data to the offset
  * @param[in]  *handle points to a adxl345 handle structure
  * @param[in]  reg is the register raw data
- * @param[out] *ms points to a window time buffer
+ * @param[out] *g points to a offset buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_window_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *ms)
+uint8_t adxl345_offset_convert_to_data(adxl345_handle_t *handle, int8_t reg, float *g)
 {
-    if (handle == NULL)                /* check handle */
+    if (handle == NULL)                 /* check handle */
     {
-        return 2;                      /* return error */
+        return 2;                       /* return error */
     }
-    if (handle->inited != 1)           /* check handle initialization */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        return 3;                      /* return error */
+        return 3;                       /* return error */
     }
     
-    *ms = (float)(reg) * 1.25f;        /* convert raw data to real data */
+    *g = (float)(reg) * 0.0156f;        /* convert raw data to real data */
     
-    return 0;                          /* success return 0 */
+    return 0;                           /* success return 0 */
 }
 
 /**
- * @brief     set the action threshold
+ * @brief     set the duration
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] threshold is the action threshold
+ * @param[in] t is the duration
  * @return    status code
  *            - 0 success
- *            - 1 set action threshold failed
+ *            - 1 set duration failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_action_threshold(adxl345_handle_t *handle, uint8_t threshold)
+uint8_t adxl345_set_duration(adxl345_handle_t *handle, uint8_t t) 
 {
-    if (handle == NULL)                                                                  /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                   /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                         /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                              /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                         /* return error */
     }
+    a_adxl345_lock(handle);                                               /* lock */
+    ADXL345_TRACE_API(handle);                                            /* tag the api */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_THRESH_ACT, &threshold, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_DUR, &t, 1);          /* write config */
+    a_adxl345_unlock(handle);                                             /* unlock */
+    
+    return res;                                                           /* return the result */
 }
 
 /**
- * @brief      get the action threshold
+ * @brief      get the duration
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *threshold points to a action threshold buffer
+ * @param[out] *t points to a duration buffer
  * @return     status code
  *             - 0 success
- *             - 1 get action threshold failed
+ *             - 1 get duration failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_action_threshold(adxl345_handle_t *handle, uint8_t *threshold)
+uint8_t adxl345_get_duration(adxl345_handle_t *handle, uint8_t *t)
 {
-    if (handle == NULL)                                                                /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                 /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                                       /* return error */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (handle->inited != 1)                                            /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                                       /* return error */
     }
+    a_adxl345_lock(handle);                                             /* lock */
+    ADXL345_TRACE_API(handle);                                          /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DUR, t, 1);          /* read config */
+    a_adxl345_unlock(handle);                                           /* unlock */
     
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_THRESH_ACT, threshold, 1);       /* read config */
+    return res;                                                         /* return the result */
 }
 
 /**
- * @brief      convert the action threshold to the register raw data
+ * @brief      convert the duration to the register raw data
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  g is the action threshold
+ * @param[in]  us is the duration
  * @param[out] *reg points to a register raw buffer
  * @return     status code
  *             - 0 success
@@ -885,103 +1562,117 @@ uint8_t adxl345_get_action_threshold(adxl345_handle_t *handle, uint8_t *threshol
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_action_threshold_convert_to_register(adxl345_handle_t *handle, float g, uint8_t *reg)
+uint8_t adxl345_duration_convert_to_register(adxl345_handle_t *handle, uint32_t us, uint8_t *reg)
 {
-    if (handle == NULL)                   /* check handle */
-    {
-        return 2;                         /* return error */
+    if (handle == NULL)                /* check handle */
+    { 
+        return 2;                      /* return error */
     }
-    if (handle->inited != 1)              /* check handle initialization */
+    if (handle->inited != 1)           /* check handle initialization */
     {
-        return 3;                         /* return error */
+        return 3;                      /* return error */
     }
     
-    *reg = (uint8_t)(g / 0.0625f);        /* convert real data to register data */
+    *reg = (uint8_t)(us / 625);        /* convert real data to register data */
     
-    return 0;                             /* success return 0 */
+    return 0;                          /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the action threshold
+ * @brief      convert the register raw data to the duration
  * @param[in]  *handle points to a adxl345 handle structure
  * @param[in]  reg is the register raw data
- * @param[out] *g points to a action threshold buffer
+ * @param[out] *us points to a duration buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_action_threshold_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *g)
+uint8_t adxl345_duration_convert_to_data(adxl345_handle_t *handle, uint8_t reg, uint32_t *us)
 {
-    if (handle == NULL)                 /* check handle */
+    if (handle == NULL)                             /* check handle */
     {
-        return 2;                       /* return error */
+        return 2;                                   /* return error */
     }
-    if (handle->inited != 1)            /* check handle initialization */
+    if (handle->inited != 1)                        /* check handle initialization */
     {
-        return 3;                       /* return error */
+        return 3;                                   /* return error */
     }
     
-    *g = (float)(reg) * 0.0625f;        /* convert raw data to real data */
+    *us = (uint32_t)((float)(reg) * 625.0f);        /* convert raw data to real data */
     
-    return 0;                           /* success return 0 */
+    return 0;                                       /* success return 0 */
 }
 
 /**
- * @brief     set the inaction threshold
+ * @brief     set the latent
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] threshold is the inaction threshold
+ * @param[in] t is the latent time
  * @return    status code
  *            - 0 success
- *            - 1 set inaction threshold failed
+ *            - 1 set latent failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_inaction_threshold(adxl345_handle_t *handle, uint8_t threshold)
+uint8_t adxl345_set_latent(adxl345_handle_t *handle, uint8_t t) 
 {
-    if (handle == NULL)                                                                    /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                      /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                            /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                            /* return error */
     }
+    a_adxl345_lock(handle);                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                               /* tag the api */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_THRESH_INACT, &threshold, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_LATENT, &t, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                /* unlock */
+    
+    return res;                                                              /* return the result */
 }
 
 /**
- * @brief      get the inaction threshold
+ * @brief      get the latent
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *threshold points to a inaction threshold buffer
+ * @param[out] *t points to a latent time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get inaction threshold failed
+ *             - 1 get latent failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_inaction_threshold(adxl345_handle_t *handle, uint8_t *threshold)
+uint8_t adxl345_get_latent(adxl345_handle_t *handle, uint8_t *t)
 {
-    if (handle == NULL)                                                                  /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                    /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                          /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                               /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                          /* return error */
     }
+    a_adxl345_lock(handle);                                                /* lock */
+    ADXL345_TRACE_API(handle);                                             /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_LATENT, t, 1);          /* read config */
+    a_adxl345_unlock(handle);                                              /* unlock */
     
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_THRESH_INACT, threshold, 1);       /* read config */
+    return res;                                                            /* return the result */
 }
 
 /**
- * @brief      convert the inaction threshold to the register raw data
+ * @brief      convert the latent to the register raw data
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  g is the inaction threshold
+ * @param[in]  ms is the time
  * @param[out] *reg points to a register raw buffer
  * @return     status code
  *             - 0 success
@@ -989,103 +1680,117 @@ uint8_t adxl345_get_inaction_threshold(adxl345_handle_t *handle, uint8_t *thresh
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_inaction_threshold_convert_to_register(adxl345_handle_t *handle, float g, uint8_t *reg)
+uint8_t adxl345_latent_convert_to_register(adxl345_handle_t *handle, float ms, uint8_t *reg)
 {
-    if (handle == NULL)                   /* check handle */
+    if (handle == NULL)                  /* check handle */
     {
-        return 2;                         /* return error */
+        return 2;                        /* return error */
     }
-    if (handle->inited != 1)              /* check handle initialization */
+    if (handle->inited != 1)             /* check handle initialization */
     {
-        return 3;                         /* return error */
+        return 3;                        /* return error */
     }
     
-    *reg = (uint8_t)(g / 0.0625f);        /* convert real data to register data */
+    *reg = (uint8_t)(ms / 1.25f);        /* convert real data to register data */
     
-    return 0;                             /* success return 0 */
+    return 0;                            /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the inaction threshold
+ * @brief      convert the register raw data to the latent
  * @param[in]  *handle points to a adxl345 handle structure
  * @param[in]  reg is the register raw data
- * @param[out] *g points to a inaction threshold buffer
+ * @param[out] *ms points to a latent buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_inaction_threshold_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *g)
+uint8_t adxl345_latent_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *ms)
 {
-    if (handle == NULL)                 /* check handle */
+    if (handle == NULL)                /* check handle */
     {
-        return 2;                       /* return error */
+        return 2;                      /* return error */
     }
-    if (handle->inited != 1)            /* check handle initialization */
+    if (handle->inited != 1)           /* check handle initialization */
     {
-        return 3;                       /* return error */
+        return 3;                      /* return error */
     }
     
-    *g = (float)(reg) * 0.0625f;        /* convert raw data to real data */
+    *ms = (float)(reg) * 1.25f;        /* convert raw data to real data */
     
-    return 0;                           /* success return 0 */
+    return 0;                          /* success return 0 */
 }
 
 /**
- * @brief     set the inaction time
+ * @brief     set the window
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] t is the inaction time
+ * @param[in] t is the window time
  * @return    status code
  *            - 0 success
- *            - 1 set inaction time failed
+ *            - 1 set window failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_inaction_time(adxl345_handle_t *handle, uint8_t t)
+uint8_t adxl345_set_window(adxl345_handle_t *handle, uint8_t t)
 {
-    if (handle == NULL)                                                          /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                      /* check handle */
     {
-        return 2;                                                                /* return error */
+        return 2;                                                            /* return error */
     }
-    if (handle->inited != 1)                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        return 3;                                                                /* return error */
+        return 3;                                                            /* return error */
     }
+    a_adxl345_lock(handle);                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                               /* tag the api */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_TIME_INACT, &t, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_WINDOW, &t, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                /* unlock */
+    
+    return res;                                                              /* return the result */
 }
 
 /**
- * @brief      get the inaction time
+ * @brief      get the window
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *t points to a inaction time buffer
+ * @param[out] *t points to a window time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get inaction time failed
+ *             - 1 get window failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_inaction_time(adxl345_handle_t *handle, uint8_t *t)
+uint8_t adxl345_get_window(adxl345_handle_t *handle, uint8_t *t)
 {
-    if (handle == NULL)                                                        /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                    /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                          /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                               /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                          /* return error */
     }
+    a_adxl345_lock(handle);                                                /* lock */
+    ADXL345_TRACE_API(handle);                                             /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_WINDOW, t, 1);          /* read config */
+    a_adxl345_unlock(handle);                                              /* unlock */
     
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_TIME_INACT, t, 1);       /* read config */
+    return res;                                                            /* return the result */
 }
 
 /**
- * @brief      convert the inaction time to the register raw data
+ * @brief      convert the window time to the register raw data
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  s is the inaction time
+ * @param[in]  ms is the window time
  * @param[out] *reg points to a register raw buffer
  * @return     status code
  *             - 0 success
@@ -1093,327 +1798,235 @@ uint8_t adxl345_get_inaction_time(adxl345_handle_t *handle, uint8_t *t)
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_inaction_time_convert_to_register(adxl345_handle_t *handle, uint8_t s, uint8_t *reg)
+uint8_t adxl345_window_convert_to_register(adxl345_handle_t *handle, float ms, uint8_t *reg)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                  /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                        /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)             /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                        /* return error */
     }
     
-    *reg = s;                       /* convert real data to register data */
+    *reg = (uint8_t)(ms / 1.25f);        /* convert real data to register data */
     
-    return 0;                       /* success return 0 */
+    return 0;                            /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the inaction time
+ * @brief      convert the register raw data to the window time
  * @param[in]  *handle points to a adxl345 handle structure
  * @param[in]  reg is the register raw data
- * @param[out] *s points to a inaction time buffer
+ * @param[out] *ms points to a window time buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_inaction_time_convert_to_data(adxl345_handle_t *handle, uint8_t reg, uint8_t *s)
+uint8_t adxl345_window_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *ms)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                      /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)           /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                      /* return error */
     }
     
-    *s = reg;                       /* convert raw data to real data */
+    *ms = (float)(reg) * 1.25f;        /* convert raw data to real data */
     
-    return 0;                       /* success return 0 */
+    return 0;                          /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the action or inaction
+ * @brief     set the action threshold
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] type is the action or inaction type
- * @param[in] enable is a bool value
+ * @param[in] threshold is the action threshold
  * @return    status code
  *            - 0 success
- *            - 1 set action inaction failed
+ *            - 1 set action threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_action_inaction(adxl345_handle_t *handle, adxl345_action_inaction_t type, adxl345_bool_t enable)
+uint8_t adxl345_set_action_threshold(adxl345_handle_t *handle, uint8_t threshold)
 {
-    uint8_t res, prev;
+    uint8_t res;
     
-    if (handle == NULL)                                                                           /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                                 /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                                      /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                                 /* return error */
+        return 3;                                                                        /* return error */
     }
+    a_adxl345_lock(handle);                                                              /* lock */
+    ADXL345_TRACE_API(handle);                                                           /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                                 /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
-        
-        return 1;                                                                                 /* return error */
-    }
-    prev &= ~(1 << type);                                                                         /* clear type */
-    prev |= (enable << type);                                                                     /* set type */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_THRESH_ACT, &threshold, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                            /* unlock */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);       /* write config */
+    return res;                                                                          /* return the result */
 }
 
 /**
- * @brief      get the action or inaction status
+ * @brief      get the action threshold
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  type is the action or inaction type
- * @param[out] *enable points to a bool value buffer
+ * @param[out] *threshold points to a action threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get action inaction failed
+ *             - 1 get action threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_action_inaction(adxl345_handle_t *handle, adxl345_action_inaction_t type, adxl345_bool_t *enable)
+uint8_t adxl345_get_action_threshold(adxl345_handle_t *handle, uint8_t *threshold)
 {
-    uint8_t res, prev;
+    uint8_t res;
     
-    if (handle == NULL)                                                                         /* check handle */
-    {
-        return 2;                                                                               /* return error */
-    }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 3;                                                                               /* return error */
+        return 2;                                                                      /* return error */
     }
-    
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                               /* check result */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
-       
-        return 1;                                                                               /* return error */
+        return 3;                                                                      /* return error */
     }
-    prev &= (1 << type);                                                                        /* get type */
-    *enable = (adxl345_bool_t)(prev >> type);                                                   /* set type */
-
-    return 0;                                                                                   /* success return 0 */
-}
-
-/**
- * @brief     set the action coupled
- * @param[in] *handle points to a adxl345 handle structure
- * @param[in] coupled is the action coupled
- * @return    status code
- *            - 0 success
- *            - 1 set action coupled failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t adxl345_set_action_coupled(adxl345_handle_t *handle, adxl345_coupled_t coupled)
-{
-    uint8_t res, prev;
+    a_adxl345_lock(handle);                                                            /* lock */
+    ADXL345_TRACE_API(handle);                                                         /* tag the api */
     
-    if (handle == NULL)                                                                           /* check handle */
-    {
-        return 2;                                                                                 /* return error */
-    }
-    if (handle->inited != 1)                                                                      /* check handle initialization */
-    {
-        return 3;                                                                                 /* return error */
-    }
+    res = a_adxl345_cache_read(handle, ADXL345_REG_THRESH_ACT, threshold, 1);          /* read config */
+    a_adxl345_unlock(handle);                                                          /* unlock */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                                 /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
-       
-        return 1;                                                                                 /* return error */
-    }
-    prev &= ~(1 << 7);                                                                            /* clear coupled */
-    prev |= (coupled << 7);                                                                       /* set coupled */
-
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);       /* write config */
+    return res;                                                                        /* return the result */
 }
 
 /**
- * @brief      get the action coupled
+ * @brief      convert the action threshold to the register raw data
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *coupled points to a action coupled buffer
+ * @param[in]  g is the action threshold
+ * @param[out] *reg points to a register raw buffer
  * @return     status code
  *             - 0 success
- *             - 1 get action coupled failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_action_coupled(adxl345_handle_t *handle, adxl345_coupled_t *coupled)
+uint8_t adxl345_action_threshold_convert_to_register(adxl345_handle_t *handle, float g, uint8_t *reg)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                         /* check handle */
-    {
-        return 2;                                                                               /* return error */
-    }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle == NULL)                   /* check handle */
     {
-        return 3;                                                                               /* return error */
+        return 2;                         /* return error */
     }
-    
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                               /* check result */
+    if (handle->inited != 1)              /* check handle initialization */
     {
-        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
-       
-        return 1;                                                                               /* return error */
+        return 3;                         /* return error */
     }
-    prev &= (1 << 7);                                                                           /* clear config */
-    *coupled = (adxl345_coupled_t)(prev >> 7);                                                  /* set config */
-
-    return 0;                                                                                   /* success return 0 */
-}
-
-/**
- * @brief     set the inaction coupled
- * @param[in] *handle points to a adxl345 handle structure
- * @param[in] coupled is the inaction coupled
- * @return    status code
- *            - 0 success
- *            - 1 set inaction coupled failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t adxl345_set_inaction_coupled(adxl345_handle_t *handle, adxl345_coupled_t coupled)
-{
-    uint8_t res, prev;
     
-    if (handle == NULL)                                                                         /* check handle */
-    {
-        return 2;                                                                               /* return error */
-    }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
-    {
-        return 3;                                                                               /* return error */
-    }
+    *reg = (uint8_t)(g / 0.0625f);        /* convert real data to register data */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                               /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
-       
-        return 1;                                                                               /* return error */
-    }
-    prev &= ~(1 << 3);                                                                          /* clear config */
-    prev |= (coupled << 3);                                                                     /* set inaction coupled */
-   
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);     /* write config */
+    return 0;                             /* success return 0 */
 }
 
 /**
- * @brief      get the inaction coupled
+ * @brief      convert the register raw data to the action threshold
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *coupled points to a inaction coupled buffer
+ * @param[in]  reg is the register raw data
+ * @param[out] *g points to a action threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get inaction coupled failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_inaction_coupled(adxl345_handle_t *handle, adxl345_coupled_t *coupled)
+uint8_t adxl345_action_threshold_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *g)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                         /* check handle */
+    if (handle == NULL)                 /* check handle */
     {
-        return 2;                                                                               /* return error */
+        return 2;                       /* return error */
     }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        return 3;                                                                               /* return error */
+        return 3;                       /* return error */
     }
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                               /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
-       
-        return 1;                                                                               /* return error */
-    }
-    prev &= (1 << 3);                                                                           /* clear config */
-    *coupled = (adxl345_coupled_t)(prev >> 3);                                                  /* get inaction coupled */
-
-    return 0;                                                                                   /* success return 0 */
+    *g = (float)(reg) * 0.0625f;        /* convert raw data to real data */
+    
+    return 0;                           /* success return 0 */
 }
 
 /**
- * @brief     set the free fall threshold
+ * @brief     set the inaction threshold
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] threshold is the free fall threshold
+ * @param[in] threshold is the inaction threshold
  * @return    status code
  *            - 0 success
- *            - 1 set free fall threshold failed
+ *            - 1 set inaction threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_free_fall_threshold(adxl345_handle_t *handle, uint8_t threshold)
+uint8_t adxl345_set_inaction_threshold(adxl345_handle_t *handle, uint8_t threshold)
 {
-    if (handle == NULL)                                                                 /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                          /* return error */
     }
+    a_adxl345_lock(handle);                                                                /* lock */
+    ADXL345_TRACE_API(handle);                                                             /* tag the api */
+    
+    res = a_adxl345_cache_write(handle, ADXL345_REG_THRESH_INACT, &threshold, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                              /* unlock */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_THRESH_FF, &threshold, 1);       /* write config */
+    return res;                                                                            /* return the result */
 }
 
 /**
- * @brief      get the free fall threshold
+ * @brief      get the inaction threshold
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *threshold points to a free fall threshold buffer
+ * @param[out] *threshold points to a inaction threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get free fall threshold failed
+ *             - 1 get inaction threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_free_fall_threshold(adxl345_handle_t *handle, uint8_t *threshold)
+uint8_t adxl345_get_inaction_threshold(adxl345_handle_t *handle, uint8_t *threshold)
 {
-    if (handle == NULL)                                                               /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                                        /* return error */
     }
+    a_adxl345_lock(handle);                                                              /* lock */
+    ADXL345_TRACE_API(handle);                                                           /* tag the api */
     
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_THRESH_FF, threshold, 1);       /* read config */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_THRESH_INACT, threshold, 1);          /* read config */
+    a_adxl345_unlock(handle);                                                            /* unlock */
+    
+    return res;                                                                          /* return the result */
 }
 
 /**
- * @brief      convert the free fall threshold to the register raw data
+ * @brief      convert the inaction threshold to the register raw data
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  g is the free fall threshold
+ * @param[in]  g is the inaction threshold
  * @param[out] *reg points to a register raw buffer
  * @return     status code
  *             - 0 success
@@ -1421,7 +2034,7 @@ uint8_t adxl345_get_free_fall_threshold(adxl345_handle_t *handle, uint8_t *thres
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_free_fall_threshold_convert_to_register(adxl345_handle_t *handle, float g, uint8_t *reg)
+uint8_t adxl345_inaction_threshold_convert_to_register(adxl345_handle_t *handle, float g, uint8_t *reg)
 {
     if (handle == NULL)                   /* check handle */
     {
@@ -1438,17 +2051,17 @@ uint8_t adxl345_free_fall_threshold_convert_to_register(adxl345_handle_t *handle
 }
 
 /**
- * @brief      convert the register raw data to the free fall threshold
+ * @brief      convert the register raw data to the inaction threshold
  * @param[in]  *handle points to a adxl345 handle structure
  * @param[in]  reg is the register raw data
- * @param[out] *g points to a free fall threshold buffer
+ * @param[out] *g points to a inaction threshold buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_free_fall_threshold_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *g)
+uint8_t adxl345_inaction_threshold_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *g)
 {
     if (handle == NULL)                 /* check handle */
     {
@@ -1465,59 +2078,73 @@ uint8_t adxl345_free_fall_threshold_convert_to_data(adxl345_handle_t *handle, ui
 }
 
 /**
- * @brief     set the free fall time
+ * @brief     set the inaction time
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] t is the free fall time
+ * @param[in] t is the inaction time
  * @return    status code
  *            - 0 success
- *            - 1 set free fall time failed
+ *            - 1 set inaction time failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_free_fall_time(adxl345_handle_t *handle, uint8_t t)
+uint8_t adxl345_set_inaction_time(adxl345_handle_t *handle, uint8_t t)
 {
-    if (handle == NULL)                                                       /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                          /* check handle */
     {
-        return 2;                                                             /* return error */
+        return 2;                                                                /* return error */
     }
-    if (handle->inited != 1)                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                     /* check handle initialization */
     {
-        return 3;                                                             /* return error */
+        return 3;                                                                /* return error */
     }
+    a_adxl345_lock(handle);                                                      /* lock */
+    ADXL345_TRACE_API(handle);                                                   /* tag the api */
+    
+    res = a_adxl345_cache_write(handle, ADXL345_REG_TIME_INACT, &t, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                    /* unlock */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_TIME_FF, &t, 1);       /* write config */
+    return res;                                                                  /* return the result */
 }
 
 /**
- * @brief      get the free fall time
+ * @brief      get the inaction time
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *t points to a free fall time buffer
+ * @param[out] *t points to a inaction time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get free fall time failed
+ *             - 1 get inaction time failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_free_fall_time(adxl345_handle_t *handle, uint8_t *t)
+uint8_t adxl345_get_inaction_time(adxl345_handle_t *handle, uint8_t *t)
 {
-    if (handle == NULL)                                                     /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                           /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                           /* return error */
+        return 3;                                                              /* return error */
     }
+    a_adxl345_lock(handle);                                                    /* lock */
+    ADXL345_TRACE_API(handle);                                                 /* tag the api */
     
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_TIME_FF, t, 1);       /* read config */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_TIME_INACT, t, 1);          /* read config */
+    a_adxl345_unlock(handle);                                                  /* unlock */
+    
+    return res;                                                                /* return the result */
 }
 
 /**
- * @brief      convert the free fall time to the register raw data
+ * @brief      convert the inaction time to the register raw data
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  ms is the free fall time
+ * @param[in]  s is the inaction time
  * @param[out] *reg points to a register raw buffer
  * @return     status code
  *             - 0 success
@@ -1525,34 +2152,34 @@ uint8_t adxl345_get_free_fall_time(adxl345_handle_t *handle, uint8_t *t)
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_free_fall_time_convert_to_register(adxl345_handle_t *handle, uint16_t ms, uint8_t *reg)
+uint8_t adxl345_inaction_time_convert_to_register(adxl345_handle_t *handle, uint8_t s, uint8_t *reg)
 {
-    if (handle == NULL)              /* check handle */
+    if (handle == NULL)             /* check handle */
     {
-        return 2;                    /* return error */
+        return 2;                   /* return error */
     }
-    if (handle->inited != 1)         /* check handle initialization */
+    if (handle->inited != 1)        /* check handle initialization */
     {
-        return 3;                    /* return error */
+        return 3;                   /* return error */
     }
     
-    *reg = (uint8_t)(ms / 5);        /* convert real data to register data */
+    *reg = s;                       /* convert real data to register data */
     
-    return 0;                        /* success return 0 */
+    return 0;                       /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the free fall time
+ * @brief      convert the register raw data to the inaction time
  * @param[in]  *handle points to a adxl345 handle structure
  * @param[in]  reg is the register raw data
- * @param[out] *ms points to a free fall time buffer
+ * @param[out] *s points to a inaction time buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_free_fall_time_convert_to_data(adxl345_handle_t *handle, uint8_t reg, uint16_t *ms)
+uint8_t adxl345_inaction_time_convert_to_data(adxl345_handle_t *handle, uint8_t reg, uint8_t *s)
 {
     if (handle == NULL)             /* check handle */
     {
@@ -1563,1152 +2190,1298 @@ uint8_t adxl345_free_fall_time_convert_to_data(adxl345_handle_t *handle, uint8_t
         return 3;                   /* return error */
     }
     
-    *ms = reg * 5;                  /* convert raw data to real data */
+    *s = reg;                       /* convert raw data to real data */
     
     return 0;                       /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the tap axis
+ * @brief     enable or disable the action or inaction
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] axis is the tap axis
+ * @param[in] type is the action or inaction type
  * @param[in] enable is a bool value
  * @return    status code
  *            - 0 success
- *            - 1 set tap axis failed
+ *            - 1 set action inaction failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_tap_axis(adxl345_handle_t *handle, adxl345_tap_axis_t axis, adxl345_bool_t enable)
+uint8_t adxl345_set_action_inaction(adxl345_handle_t *handle, adxl345_action_inaction_t type, adxl345_bool_t enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                           /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                                 /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                      /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                                 /* return error */
     }
+    a_adxl345_lock(handle);                                                                       /* lock */
+    ADXL345_TRACE_API(handle);                                                                    /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                            /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                                 /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
-       
-        return 1;                                                                            /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
+        
+        return 1;                                                                                 /* return error */
     }
-    prev &= ~(1 << axis);                                                                    /* clear axis */
-    prev |= enable << axis;                                                                  /* set axis */
+    prev &= ~(1 << type);                                                                         /* clear type */
+    prev |= (enable << type);                                                                     /* set type */
+    
+    res = a_adxl345_cache_write(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                     /* unlock */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);       /* write config */
+    return res;                                                                                   /* return the result */
 }
 
 /**
- * @brief      get the tap axis status
+ * @brief      get the action or inaction status
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  axis is the tap axis
+ * @param[in]  type is the action or inaction type
  * @param[out] *enable points to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get tap axis failed
+ *             - 1 get action inaction failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note      none
+ * @note       none
  */
-uint8_t adxl345_get_tap_axis(adxl345_handle_t *handle, adxl345_tap_axis_t axis, adxl345_bool_t *enable)
+uint8_t adxl345_get_action_inaction(adxl345_handle_t *handle, adxl345_action_inaction_t type, adxl345_bool_t *enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                               /* return error */
     }
+    a_adxl345_lock(handle);                                                                     /* lock */
+    ADXL345_TRACE_API(handle);                                                                  /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                          /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                               /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                    /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        a_adxl345_unlock(handle);                                                               /* unlock */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                               /* return error */
     }
-    prev &= (1 << axis);                                                                   /* clear axis */
-    *enable = (adxl345_bool_t)(prev >> axis);                                              /* set axis */
+    prev &= (1 << type);                                                                        /* get type */
+    *enable = (adxl345_bool_t)(prev >> type);                                                   /* set type */
+    a_adxl345_unlock(handle);                                                                   /* unlock */
 
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the tap suppress
+ * @brief     set the action coupled
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] enable is a bool value
+ * @param[in] coupled is the action coupled
  * @return    status code
  *            - 0 success
- *            - 1 set tap suppress failed
+ *            - 1 set action coupled failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_tap_suppress(adxl345_handle_t *handle, adxl345_bool_t enable)
+uint8_t adxl345_set_action_coupled(adxl345_handle_t *handle, adxl345_coupled_t coupled)
 {
     uint8_t res, prev;
-   
-    if (handle == NULL)                                                                      /* check handle */
+    
+    if (handle == NULL)                                                                           /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                                 /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                      /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                                 /* return error */
     }
+    a_adxl345_lock(handle);                                                                       /* lock */
+    ADXL345_TRACE_API(handle);                                                                    /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                            /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                                 /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
        
-        return 1;                                                                            /* return error */
+        return 1;                                                                                 /* return error */
     }
-    prev &= ~(1 << 3);                                                                       /* clear suppress */
-    prev |= enable << 3;                                                                     /* set suppress */
+    prev &= ~(1 << 7);                                                                            /* clear coupled */
+    prev |= (coupled << 7);                                                                       /* set coupled */
 
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                     /* unlock */
+    
+    return res;                                                                                   /* return the result */
 }
 
 /**
- * @brief      get the tap suppress status
+ * @brief      get the action coupled
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *enable points to a bool value buffer
+ * @param[out] *coupled points to a action coupled buffer
  * @return     status code
  *             - 0 success
- *             - 1 get tap suppress failed
+ *             - 1 get action coupled failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_tap_suppress(adxl345_handle_t *handle, adxl345_bool_t *enable)
+uint8_t adxl345_get_action_coupled(adxl345_handle_t *handle, adxl345_coupled_t *coupled)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                               /* return error */
     }
+    a_adxl345_lock(handle);                                                                     /* lock */
+    ADXL345_TRACE_API(handle);                                                                  /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                          /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                               /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                    /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        a_adxl345_unlock(handle);                                                               /* unlock */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                               /* return error */
     }
-    prev &= (1 << 3);                                                                      /* clear config */
-    *enable = (adxl345_bool_t)(prev >> 3);                                                 /* set config */
-
-    return 0;                                                                              /* success return 0 */
-}
+    prev &= (1 << 7);                                                                           /* clear config */
+    *coupled = (adxl345_coupled_t)(prev >> 7);                                                  /* set config */
+    a_adxl345_unlock(handle);                                                                   /* unlock */
 
-/**
- * @brief      get the tap status
- * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *status points to a tap status buffer
- * @return     status code
- *             - 0 success
- *             - 1 get tap status failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
- */
-uint8_t adxl345_get_tap_status(adxl345_handle_t *handle, uint8_t *status)
-{
-    if (handle == NULL)                                                                            /* check handle */
-    {
-        return 2;                                                                                  /* return error */
-    }
-    if (handle->inited != 1)                                                                       /* check handle initialization */
-    {
-        return 3;                                                                                  /* return error */
-    }
-    
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_ACT_TAP_STATUS, (uint8_t *)status, 1);       /* read config */
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief     set the sampling rate
+ * @brief     set the inaction coupled
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] rate is the sampling rate
+ * @param[in] coupled is the inaction coupled
  * @return    status code
  *            - 0 success
- *            - 1 set rate failed
+ *            - 1 set inaction coupled failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_rate(adxl345_handle_t *handle, adxl345_rate_t rate)
+uint8_t adxl345_set_inaction_coupled(adxl345_handle_t *handle, adxl345_coupled_t coupled)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                               /* return error */
     }
+    a_adxl345_lock(handle);                                                                     /* lock */
+    ADXL345_TRACE_API(handle);                                                                  /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_BW_RATE, (uint8_t *)&prev, 1);          /* read config */
-    if (res != 0)                                                                            /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                               /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        a_adxl345_unlock(handle);                                                               /* unlock */
        
-        return 1;                                                                            /* return error */
+        return 1;                                                                               /* return error */
     }
-    prev &= ~(0x1F);                                                                         /* clear rate */
-    prev |= rate;                                                                            /* set rate */
-
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_BW_RATE, (uint8_t *)&prev, 1);        /* write config */
+    prev &= ~(1 << 3);                                                                          /* clear config */
+    prev |= (coupled << 3);                                                                     /* set inaction coupled */
+   
+    res = a_adxl345_cache_write(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);        /* write config */
+    a_adxl345_unlock(handle);                                                                   /* unlock */
+    
+    return res;                                                                                 /* return the result */
 }
 
 /**
- * @brief      get the sampling rate
+ * @brief      get the inaction coupled
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *rate points to a sampling rate buffer
+ * @param[out] *coupled points to a inaction coupled buffer
  * @return     status code
  *             - 0 success
- *             - 1 get rate failed
+ *             - 1 get inaction coupled failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_rate(adxl345_handle_t *handle, adxl345_rate_t *rate)
+uint8_t adxl345_get_inaction_coupled(adxl345_handle_t *handle, adxl345_coupled_t *coupled)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                               /* return error */
     }
+    a_adxl345_lock(handle);                                                                     /* lock */
+    ADXL345_TRACE_API(handle);                                                                  /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_BW_RATE, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                         /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_ACT_INACT_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                               /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                   /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        a_adxl345_unlock(handle);                                                               /* unlock */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                               /* return error */
     }
-    prev &= 0x1F;                                                                         /* clear config */
-    *rate = (adxl345_rate_t)(prev);                                                       /* get rate */
+    prev &= (1 << 3);                                                                           /* clear config */
+    *coupled = (adxl345_coupled_t)(prev >> 3);                                                  /* get inaction coupled */
+    a_adxl345_unlock(handle);                                                                   /* unlock */
 
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the interrupt
+ * @brief     set the free fall threshold
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] type is the interrupt type
- * @param[in] enable is the bool value
+ * @param[in] threshold is the free fall threshold
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt failed
+ *            - 1 set free fall threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_interrupt(adxl345_handle_t *handle, adxl345_interrupt_t type, adxl345_bool_t enable)
+uint8_t adxl345_set_free_fall_threshold(adxl345_handle_t *handle, uint8_t threshold)
 {
-    uint8_t res, prev;
+    uint8_t res;
     
-    if (handle == NULL)                                                                        /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                              /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                              /* return error */
+        return 3;                                                                       /* return error */
     }
+    a_adxl345_lock(handle);                                                             /* lock */
+    ADXL345_TRACE_API(handle);                                                          /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_ENABLE, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                                        /* read failed */
-       
-        return 1;                                                                              /* return error */
-    }
-    prev &= ~(1 << type);                                                                      /* clear interrupt */
-    prev |= enable << type;                                                                    /* set interrupt */
-
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_INT_ENABLE, (uint8_t *)&prev, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_THRESH_FF, &threshold, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                           /* unlock */
+    
+    return res;                                                                         /* return the result */
 }
 
 /**
- * @brief      get the interrupt status
+ * @brief      get the free fall threshold
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  type is the interrupt type
- * @param[out] *enable points to a bool value buffer
+ * @param[out] *threshold points to a free fall threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt failed
+ *             - 1 get free fall threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_interrupt(adxl345_handle_t *handle, adxl345_interrupt_t type, adxl345_bool_t *enable)
+uint8_t adxl345_get_free_fall_threshold(adxl345_handle_t *handle, uint8_t *threshold)
 {
-    uint8_t res, prev;
+    uint8_t res;
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                     /* return error */
     }
+    a_adxl345_lock(handle);                                                           /* lock */
+    ADXL345_TRACE_API(handle);                                                        /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_ENABLE, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                            /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_THRESH_FF, threshold, 1);          /* read config */
+    a_adxl345_unlock(handle);                                                         /* unlock */
+    
+    return res;                                                                       /* return the result */
+}
+
+/**
+ * @brief      convert the free fall threshold to the register raw data
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[in]  g is the free fall threshold
+ * @param[out] *reg points to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_free_fall_threshold_convert_to_register(adxl345_handle_t *handle, float g, uint8_t *reg)
+{
+    if (handle == NULL)                   /* check handle */
     {
-        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
-        
-        return 1;                                                                            /* return error */
+        return 2;                         /* return error */
+    }
+    if (handle->inited != 1)              /* check handle initialization */
+    {
+        return 3;                         /* return error */
     }
-    prev &= (1 << type);                                                                     /* clear config */
-    *enable = (adxl345_bool_t)(prev >> type);                                                /* set config */
     
-    return 0;                                                                                /* success return 0 */
+    *reg = (uint8_t)(g / 0.0625f);        /* convert real data to register data */
+    
+    return 0;                             /* success return 0 */
 }
 
 /**
- * @brief     set the interrupt map
+ * @brief      convert the register raw data to the free fall threshold
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[in]  reg is the register raw data
+ * @param[out] *g points to a free fall threshold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_free_fall_threshold_convert_to_data(adxl345_handle_t *handle, uint8_t reg, float *g)
+{
+    if (handle == NULL)                 /* check handle */
+    {
+        return 2;                       /* return error */
+    }
+    if (handle->inited != 1)            /* check handle initialization */
+    {
+        return 3;                       /* return error */
+    }
+    
+    *g = (float)(reg) * 0.0625f;        /* convert raw data to real data */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief     set the free fall time
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] type is the interrupt type
- * @param[in] pin is the interrupt pin
+ * @param[in] t is the free fall time
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt map failed
+ *            - 1 set free fall time failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_interrupt_map(adxl345_handle_t *handle, adxl345_interrupt_t type, adxl345_interrupt_pin_t pin)
+uint8_t adxl345_set_free_fall_time(adxl345_handle_t *handle, uint8_t t)
 {
-    uint8_t res, prev;
+    uint8_t res;
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                       /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                             /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                  /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                             /* return error */
     }
+    a_adxl345_lock(handle);                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_MAP, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                           /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
-       
-        return 1;                                                                           /* return error */
-    }
-    prev &= ~(1 << type);                                                                   /* clear type */
-    prev |= pin << type;                                                                    /* set interrupt map */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_TIME_FF, &t, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                 /* unlock */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_INT_MAP, (uint8_t *)&prev, 1);       /* write config */
+    return res;                                                               /* return the result */
 }
 
 /**
- * @brief      get the interrupt map
+ * @brief      get the free fall time
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[in]  type is the interrupt type
- * @param[out] *pin points to a interrupt pin buffer
+ * @param[out] *t points to a free fall time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt map failed
+ *             - 1 get free fall time failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_interrupt_map(adxl345_handle_t *handle, adxl345_interrupt_t type, adxl345_interrupt_pin_t *pin)
+uint8_t adxl345_get_free_fall_time(adxl345_handle_t *handle, uint8_t *t)
 {
-    uint8_t res, prev;
+    uint8_t res;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                     /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                           /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                           /* return error */
     }
+    a_adxl345_lock(handle);                                                 /* lock */
+    ADXL345_TRACE_API(handle);                                              /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_MAP, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                         /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_TIME_FF, t, 1);          /* read config */
+    a_adxl345_unlock(handle);                                               /* unlock */
+    
+    return res;                                                             /* return the result */
+}
+
+/**
+ * @brief      convert the free fall time to the register raw data
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[in]  ms is the free fall time
+ * @param[out] *reg points to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_free_fall_time_convert_to_register(adxl345_handle_t *handle, uint16_t ms, uint8_t *reg)
+{
+    if (handle == NULL)              /* check handle */
     {
-        handle->debug_print("adxl345: read failed.\n");                                   /* read failed */
-       
-        return 1;                                                                         /* return error */
+        return 2;                    /* return error */
     }
-    prev &= (1 << type);                                                                  /* clear config */
-    *pin = (adxl345_interrupt_pin_t)(prev >> type);                                       /* set interrupt map */
-
-    return 0;                                                                             /* success return 0 */
+    if (handle->inited != 1)         /* check handle initialization */
+    {
+        return 3;                    /* return error */
+    }
+    
+    *reg = (uint8_t)(ms / 5);        /* convert real data to register data */
+    
+    return 0;                        /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt source
+ * @brief      convert the register raw data to the free fall time
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *source points to a interrupt source buffer
+ * @param[in]  reg is the register raw data
+ * @param[out] *ms points to a free fall time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt source failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_interrupt_source(adxl345_handle_t *handle, uint8_t *source)
+uint8_t adxl345_free_fall_time_convert_to_data(adxl345_handle_t *handle, uint8_t reg, uint16_t *ms)
 {
-    if (handle == NULL)                                                                        /* check handle */
+    if (handle == NULL)             /* check handle */
     {
-        return 2;                                                                              /* return error */
+        return 2;                   /* return error */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    if (handle->inited != 1)        /* check handle initialization */
     {
-        return 3;                                                                              /* return error */
+        return 3;                   /* return error */
     }
     
-    return a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_ENABLE, (uint8_t *)source, 1);       /* read config */
+    *ms = reg * 5;                  /* convert raw data to real data */
+    
+    return 0;                       /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the self test
+ * @brief     enable or disable the tap axis
  * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] axis is the tap axis
  * @param[in] enable is a bool value
  * @return    status code
  *            - 0 success
- *            - 1 set self test failed
+ *            - 1 set tap axis failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_self_test(adxl345_handle_t *handle, adxl345_bool_t enable)
+uint8_t adxl345_set_tap_axis(adxl345_handle_t *handle, adxl345_tap_axis_t axis, adxl345_bool_t enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                         /* check handle */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                                               /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        return 3;                                                                               /* return error */
+        return 3;                                                                            /* return error */
     }
+    a_adxl345_lock(handle);                                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                                               /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                               /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        a_adxl345_unlock(handle);                                                            /* unlock */
        
-        return 1;                                                                               /* return error */
+        return 1;                                                                            /* return error */
     }
-    prev &= ~(1 << 7);                                                                          /* clear config */
-    prev |= (enable << 7);                                                                      /* set self test */
-
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* write config */
+    prev &= ~(1 << axis);                                                                    /* clear axis */
+    prev |= enable << axis;                                                                  /* set axis */
+    
+    res = a_adxl345_cache_write(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                /* unlock */
+    
+    return res;                                                                              /* return the result */
 }
 
 /**
- * @brief      get the self test status
+ * @brief      get the tap axis status
  * @param[in]  *handle points to a adxl345 handle structure
+ * @param[in]  axis is the tap axis
  * @param[out] *enable points to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get self test failed
+ *             - 1 get tap axis failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note      none
  */
-uint8_t adxl345_get_self_test(adxl345_handle_t *handle, adxl345_bool_t *enable)
+uint8_t adxl345_get_tap_axis(adxl345_handle_t *handle, adxl345_tap_axis_t axis, adxl345_bool_t *enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                          /* return error */
     }
+    a_adxl345_lock(handle);                                                                /* lock */
+    ADXL345_TRACE_API(handle);                                                             /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
-        
-        return 1;                                                                             /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                    /* read failed */
+        a_adxl345_unlock(handle);                                                          /* unlock */
+       
+        return 1;                                                                          /* return error */
     }
-    prev &= (1 << 7);                                                                         /* clear config */
-    *enable = (adxl345_bool_t)(prev >> 7);                                                    /* set self test */
-    
-    return 0;                                                                                 /* success return 0 */
+    prev &= (1 << axis);                                                                   /* clear axis */
+    *enable = (adxl345_bool_t)(prev >> axis);                                              /* set axis */
+    a_adxl345_unlock(handle);                                                              /* unlock */
+
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     set the chip spi wire
+ * @brief     enable or disable the tap suppress
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] wire is the spi wire
+ * @param[in] enable is a bool value
  * @return    status code
  *            - 0 success
- *            - 1 set spi wire failed
+ *            - 1 set tap suppress failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_spi_wire(adxl345_handle_t *handle, adxl345_spi_wire_t wire)
+uint8_t adxl345_set_tap_suppress(adxl345_handle_t *handle, adxl345_bool_t enable)
 {
     uint8_t res, prev;
-    
-    if (handle == NULL)                                                                         /* check handle */
+   
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                                               /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        return 3;                                                                               /* return error */
+        return 3;                                                                            /* return error */
     }
+    a_adxl345_lock(handle);                                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                                               /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                               /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        a_adxl345_unlock(handle);                                                            /* unlock */
        
-        return 1;                                                                               /* return error */
+        return 1;                                                                            /* return error */
     }
-    prev &= ~(1 << 6);                                                                          /* clear config */
-    prev |= (wire << 6);                                                                        /* set wire */
+    prev &= ~(1 << 3);                                                                       /* clear suppress */
+    prev |= enable << 3;                                                                     /* set suppress */
 
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                /* unlock */
+    
+    return res;                                                                              /* return the result */
 }
 
 /**
- * @brief      get the chip spi wire
+ * @brief      get the tap suppress status
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *wire points to a spi wire buffer
+ * @param[out] *enable points to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get spi wire failed
+ *             - 1 get tap suppress failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_spi_wire(adxl345_handle_t *handle, adxl345_spi_wire_t *wire)
+uint8_t adxl345_get_tap_suppress(adxl345_handle_t *handle, adxl345_bool_t *enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                          /* return error */
     }
+    a_adxl345_lock(handle);                                                                /* lock */
+    ADXL345_TRACE_API(handle);                                                             /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_TAP_AXES, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                    /* read failed */
+        a_adxl345_unlock(handle);                                                          /* unlock */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                          /* return error */
     }
-    prev &= (1 << 6);                                                                         /* clear config */
-    *wire = (adxl345_spi_wire_t)(prev >> 6);                                                  /* set wire */
-
-    return 0;                                                                                 /* success return 0 */
-}
+    prev &= (1 << 3);                                                                      /* clear config */
+    *enable = (adxl345_bool_t)(prev >> 3);                                                 /* set config */
+    a_adxl345_unlock(handle);                                                              /* unlock */
 
-/**
- * @brief     set the interrupt active level
- * @param[in] *handle points to a adxl345 handle structure
- * @param[in] active_level is the interrupt active level
- * @return    status code
- *            - 0 success
- *            - 1 set interrupt active level failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t adxl345_set_interrupt_active_level(adxl345_handle_t *handle, adxl345_interrupt_active_level_t active_level)
-{
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                         /* check handle */
-    {
-        return 2;                                                                               /* return error */
-    }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
-    {
-        return 3;                                                                               /* return error */
-    }
-    
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                               /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
-        
-        return 1;                                                                               /* return error */
-    }
-    prev &= ~(1 << 5);                                                                          /* clear config */
-    prev |= (active_level << 5);                                                                /* set active level */
-    
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* write config */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt active level
+ * @brief      get the tap status
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *active_level points to a interrupt active level buffer
+ * @param[out] *status points to a tap status buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt active level failed
+ *             - 1 get tap status failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_interrupt_active_level(adxl345_handle_t *handle, adxl345_interrupt_active_level_t *active_level)
+uint8_t adxl345_get_tap_status(adxl345_handle_t *handle, uint8_t *status)
 {
-    uint8_t res, prev;
+    uint8_t res;
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                            /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                                  /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                                       /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                                  /* return error */
     }
+    a_adxl345_lock(handle);                                                                        /* lock */
+    ADXL345_TRACE_API(handle);                                                                     /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);     /* read config */
-    if (res != 0)                                                                           /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
-        
-        return 1;                                                                           /* return error */
-    }
-    prev &= (1 << 5);                                                                       /* get config */
-    *active_level = (adxl345_interrupt_active_level_t)(prev >> 5);                          /* get active level */
+    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_ACT_TAP_STATUS, (uint8_t *)status, 1);        /* read config */
+    a_adxl345_unlock(handle);                                                                      /* unlock */
     
-    return 0;                                                                               /* success return 0 */ 
+    return res;                                                                                    /* return the result */
 }
 
 /**
- * @brief     enable or disable the full resolution
+ * @brief     set the sampling rate
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] enable is a bool value
+ * @param[in] rate is the sampling rate
  * @return    status code
  *            - 0 success
- *            - 1 set full resolution failed
+ *            - 1 set rate failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_full_resolution(adxl345_handle_t *handle, adxl345_bool_t enable)
+uint8_t adxl345_set_rate(adxl345_handle_t *handle, adxl345_rate_t rate)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                         /* check handle */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                                               /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        return 3;                                                                               /* return error */
+        return 3;                                                                            /* return error */
     }
+    a_adxl345_lock(handle);                                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                                               /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                               /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_BW_RATE, (uint8_t *)&prev, 1);            /* read config */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
-        
-        return 1;                                                                               /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        a_adxl345_unlock(handle);                                                            /* unlock */
+       
+        return 1;                                                                            /* return error */
     }
-    prev &= ~(1 << 3);                                                                          /* clear resolution */
-    prev |= (enable << 3);                                                                      /* set resolution */
+    prev &= ~(0x1F);                                                                         /* clear rate */
+    prev |= rate;                                                                            /* set rate */
+
+    res = a_adxl345_cache_write(handle, ADXL345_REG_BW_RATE, (uint8_t *)&prev, 1);           /* write config */
+    a_adxl345_unlock(handle);                                                                /* unlock */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* write config */
+    return res;                                                                              /* return the result */
 }
 
 /**
- * @brief      get the full resolution status
+ * @brief      get the sampling rate
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *enable points to a bool value buffer
+ * @param[out] *rate points to a sampling rate buffer
  * @return     status code
  *             - 0 success
- *             - 1 get full resolution failed
+ *             - 1 get rate failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_full_resolution(adxl345_handle_t *handle, adxl345_bool_t *enable)
+uint8_t adxl345_get_rate(adxl345_handle_t *handle, adxl345_rate_t *rate)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                         /* return error */
     }
+    a_adxl345_lock(handle);                                                               /* lock */
+    ADXL345_TRACE_API(handle);                                                            /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_BW_RATE, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
-        
-        return 1;                                                                             /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                   /* read failed */
+        a_adxl345_unlock(handle);                                                         /* unlock */
+       
+        return 1;                                                                         /* return error */
     }
-    prev &= (1 << 3);                                                                         /* clear config */
-    *enable = (adxl345_bool_t)(prev >> 3);                                                    /* set resolution */
-    
-    return 0;                                                                                 /* success return 0 */
+    prev &= 0x1F;                                                                         /* clear config */
+    *rate = (adxl345_rate_t)(prev);                                                       /* get rate */
+    a_adxl345_unlock(handle);                                                             /* unlock */
+
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the justify
+ * @brief     enable or disable the interrupt
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] enable is a bool value
+ * @param[in] type is the interrupt type
+ * @param[in] enable is the bool value
  * @return    status code
  *            - 0 success
- *            - 1 set justify failed
+ *            - 1 set interrupt failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_justify(adxl345_handle_t *handle, adxl345_justify_t enable)
+uint8_t adxl345_set_interrupt(adxl345_handle_t *handle, adxl345_interrupt_t type, adxl345_bool_t enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                         /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                               /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                               /* return error */
+        return 3;                                                                              /* return error */
     }
+    a_adxl345_lock(handle);                                                                    /* lock */
+    ADXL345_TRACE_API(handle);                                                                 /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                               /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_INT_ENABLE, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
-        
-        return 1;                                                                               /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                        /* read failed */
+        a_adxl345_unlock(handle);                                                              /* unlock */
+       
+        return 1;                                                                              /* return error */
     }
-    prev &= ~(1 << 2);                                                                          /* clear config */
-    prev |= (enable << 2);                                                                      /* set justify */
+    prev &= ~(1 << type);                                                                      /* clear interrupt */
+    prev |= enable << type;                                                                    /* set interrupt */
+
+    res = a_adxl345_cache_write(handle, ADXL345_REG_INT_ENABLE, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                  /* unlock */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* write config */
+    return res;                                                                                /* return the result */
 }
 
 /**
- * @brief      get the justify status
+ * @brief      get the interrupt status
  * @param[in]  *handle points to a adxl345 handle structure
+ * @param[in]  type is the interrupt type
  * @param[out] *enable points to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get justify failed
+ *             - 1 get interrupt failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_justify(adxl345_handle_t *handle, adxl345_justify_t *enable)
+uint8_t adxl345_get_interrupt(adxl345_handle_t *handle, adxl345_interrupt_t type, adxl345_bool_t *enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                            /* return error */
     }
+    a_adxl345_lock(handle);                                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                                               /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_INT_ENABLE, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        a_adxl345_unlock(handle);                                                            /* unlock */
         
-        return 1;                                                                             /* return error */
+        return 1;                                                                            /* return error */
     }
-    prev &= (1 << 2);                                                                         /* get config */
-    *enable = (adxl345_justify_t)(prev >> 2);                                                 /* get justify */
+    prev &= (1 << type);                                                                     /* clear config */
+    *enable = (adxl345_bool_t)(prev >> type);                                                /* set config */
+    a_adxl345_unlock(handle);                                                                /* unlock */
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief     set the chip range
+ * @brief     set the interrupt map
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] range is the measurement range
+ * @param[in] type is the interrupt type
+ * @param[in] pin is the interrupt pin
  * @return    status code
  *            - 0 success
- *            - 1 set range failed
+ *            - 1 set interrupt map failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_range(adxl345_handle_t *handle, adxl345_range_t range)
+uint8_t adxl345_set_interrupt_map(adxl345_handle_t *handle, adxl345_interrupt_t type, adxl345_interrupt_pin_t pin)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                         /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                                               /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                                               /* return error */
+        return 3;                                                                           /* return error */
     }
+    a_adxl345_lock(handle);                                                                 /* lock */
+    ADXL345_TRACE_API(handle);                                                              /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                               /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_INT_MAP, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                           /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
+        a_adxl345_unlock(handle);                                                           /* unlock */
        
-        return 1;                                                                               /* return error */
+        return 1;                                                                           /* return error */
     }
-    prev &= ~(3 << 0);                                                                          /* clear config */
-    prev |= (range << 0);                                                                       /* set range */
-
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* write config */
+    prev &= ~(1 << type);                                                                   /* clear type */
+    prev |= pin << type;                                                                    /* set interrupt map */
+    
+    res = a_adxl345_cache_write(handle, ADXL345_REG_INT_MAP, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                               /* unlock */
+    
+    return res;                                                                             /* return the result */
 }
 
 /**
- * @brief      get the chip range
+ * @brief      get the interrupt map
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *range points to a measurement range buffer
+ * @param[in]  type is the interrupt type
+ * @param[out] *pin points to a interrupt pin buffer
  * @return     status code
  *             - 0 success
- *             - 1 get range failed
+ *             - 1 get interrupt map failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_range(adxl345_handle_t *handle, adxl345_range_t *range)
+uint8_t adxl345_get_interrupt_map(adxl345_handle_t *handle, adxl345_interrupt_t type, adxl345_interrupt_pin_t *pin)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                         /* return error */
     }
+    a_adxl345_lock(handle);                                                               /* lock */
+    ADXL345_TRACE_API(handle);                                                            /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_INT_MAP, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
-        
-        return 1;                                                                             /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                   /* read failed */
+        a_adxl345_unlock(handle);                                                         /* unlock */
+       
+        return 1;                                                                         /* return error */
     }
-    prev &= (3 << 0);                                                                         /* get config */
-    *range = (adxl345_range_t)(prev >> 0);                                                    /* set range */
+    prev &= (1 << type);                                                                  /* clear config */
+    *pin = (adxl345_interrupt_pin_t)(prev >> type);                                       /* set interrupt map */
+    a_adxl345_unlock(handle);                                                             /* unlock */
+
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the interrupt source
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *source points to a interrupt source buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get interrupt source failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_get_interrupt_source(adxl345_handle_t *handle, uint8_t *source)
+{
+    uint8_t res;
     
-    return 0;                                                                                 /* success return 0 */
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    a_adxl345_lock(handle);                                                                    /* lock */
+    ADXL345_TRACE_API(handle);                                                                 /* tag the api */
+    
+    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_SOURCE, (uint8_t *)source, 1);        /* read config */
+    a_adxl345_unlock(handle);                                                                  /* unlock */
+    
+    return res;                                                                                /* return the result */
 }
 
 /**
- * @brief     set the chip mode
+ * @brief     enable or disable the self test
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] mode is the chip mode
+ * @param[in] enable is a bool value
  * @return    status code
  *            - 0 success
- *            - 1 set mode failed
+ *            - 1 set self test failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_mode(adxl345_handle_t *handle, adxl345_mode_t mode)
+uint8_t adxl345_set_self_test(adxl345_handle_t *handle, adxl345_bool_t enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                               /* return error */
     }
+    a_adxl345_lock(handle);                                                                     /* lock */
+    ADXL345_TRACE_API(handle);                                                                  /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                            /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                               /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        a_adxl345_unlock(handle);                                                               /* unlock */
        
-        return 1;                                                                            /* return error */
+        return 1;                                                                               /* return error */
     }
-    prev &= ~(3 << 6);                                                                       /* clear config */
-    prev |= (mode << 6);                                                                     /* set mode */
+    prev &= ~(1 << 7);                                                                          /* clear config */
+    prev |= (enable << 7);                                                                      /* set self test */
+
+    res = a_adxl345_cache_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                   /* unlock */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);       /* write config */
+    return res;                                                                                 /* return the result */
 }
 
 /**
- * @brief      get the chip mode
+ * @brief      get the self test status
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *mode points to a chip mode buffer
+ * @param[out] *enable points to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get mode failed
+ *             - 1 get self test failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_mode(adxl345_handle_t *handle, adxl345_mode_t *mode)
+uint8_t adxl345_get_self_test(adxl345_handle_t *handle, adxl345_bool_t *enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                             /* return error */
     }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                          /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                    /* read failed */
-       
-        return 1;                                                                          /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
+        
+        return 1;                                                                             /* return error */
     }
-    prev &= (3 << 6);                                                                      /* get config */
-    *mode = (adxl345_mode_t)(prev >> 6);                                                   /* set mode */
-
-    return 0;                                                                              /* success return 0 */
+    prev &= (1 << 7);                                                                         /* clear config */
+    *enable = (adxl345_bool_t)(prev >> 7);                                                    /* set self test */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
+    
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the trigger pin
+ * @brief     set the chip spi wire
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] pin is the trigger pin
+ * @param[in] wire is the spi wire
  * @return    status code
  *            - 0 success
- *            - 1 set trigger pin failed
+ *            - 1 set spi wire failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_trigger_pin(adxl345_handle_t *handle, adxl345_interrupt_pin_t pin)
+uint8_t adxl345_set_spi_wire(adxl345_handle_t *handle, adxl345_spi_wire_t wire)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                               /* return error */
     }
+    a_adxl345_lock(handle);                                                                     /* lock */
+    ADXL345_TRACE_API(handle);                                                                  /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                            /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                               /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        a_adxl345_unlock(handle);                                                               /* unlock */
        
-        return 1;                                                                            /* return error */
+        return 1;                                                                               /* return error */
     }
-    prev &= ~(1 << 5);                                                                       /* clear config */
-    prev |= (pin << 5);                                                                      /* set pin */
+    prev &= ~(1 << 6);                                                                          /* clear config */
+    prev |= (wire << 6);                                                                        /* set wire */
 
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                   /* unlock */
+    
+    return res;                                                                                 /* return the result */
 }
 
 /**
- * @brief      get the trigger pin
+ * @brief      get the chip spi wire
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *pin points to a trigger pin buffer
+ * @param[out] *wire points to a spi wire buffer
  * @return     status code
  *             - 0 success
- *             - 1 get trigger pin failed
+ *             - 1 get spi wire failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_trigger_pin(adxl345_handle_t *handle, adxl345_interrupt_pin_t *pin)
+uint8_t adxl345_get_spi_wire(adxl345_handle_t *handle, adxl345_spi_wire_t *wire)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                             /* return error */
     }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                          /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                    /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                             /* return error */
     }
-    prev &= (1 << 5);                                                                      /* clear config */
-    *pin = (adxl345_interrupt_pin_t)(prev >> 5);                                           /* set pin */
+    prev &= (1 << 6);                                                                         /* clear config */
+    *wire = (adxl345_spi_wire_t)(prev >> 6);                                                  /* set wire */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
 
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the fifo watermark
+ * @brief     set the interrupt active level
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] level is the watermark level
+ * @param[in] active_level is the interrupt active level
  * @return    status code
  *            - 0 success
- *            - 1 set watermark failed
+ *            - 1 set interrupt active level failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      level <= 0x1F
+ * @note      none
  */
-uint8_t adxl345_set_watermark(adxl345_handle_t *handle, uint8_t level)
+uint8_t adxl345_set_interrupt_active_level(adxl345_handle_t *handle, adxl345_interrupt_active_level_t active_level)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                               /* return error */
     }
+    a_adxl345_lock(handle);                                                                     /* lock */
+    ADXL345_TRACE_API(handle);                                                                  /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                            /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                               /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
-       
-        return 1;                                                                            /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        a_adxl345_unlock(handle);                                                               /* unlock */
+        
+        return 1;                                                                               /* return error */
     }
-    prev &= ~(0x1F);                                                                         /* clear config */
-    prev |= (level & 0x1F);                                                                  /* set watermark */
-
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);       /* write config */
+    prev &= ~(1 << 5);                                                                          /* clear config */
+    prev |= (active_level << 5);                                                                /* set active level */
+    
+    res = a_adxl345_cache_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                   /* unlock */
+    
+    return res;                                                                                 /* return the result */
 }
 
 /**
- * @brief      get the fifo watermark
+ * @brief      get the interrupt active level
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *level points to a watermark level buffer
+ * @param[out] *active_level points to a interrupt active level buffer
  * @return     status code
  *             - 0 success
- *             - 1 get watermark failed
+ *             - 1 get interrupt active level failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_watermark(adxl345_handle_t *handle, uint8_t *level)
+uint8_t adxl345_get_interrupt_active_level(adxl345_handle_t *handle, adxl345_interrupt_active_level_t *active_level)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                           /* return error */
     }
+    a_adxl345_lock(handle);                                                                 /* lock */
+    ADXL345_TRACE_API(handle);                                                              /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                          /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                           /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                    /* read failed */
-       
-        return 1;                                                                          /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
+        a_adxl345_unlock(handle);                                                           /* unlock */
+        
+        return 1;                                                                           /* return error */
     }
-    prev &= (0x1F);                                                                        /* get config */
-    *level = prev & 0x1F;                                                                  /* get watermark */
-
-    return 0;                                                                              /* success return 0 */
+    prev &= (1 << 5);                                                                       /* get config */
+    *active_level = (adxl345_interrupt_active_level_t)(prev >> 5);                          /* get active level */
+    a_adxl345_unlock(handle);                                                               /* unlock */
+    
+    return 0;                                                                               /* success return 0 */ 
 }
 
 /**
- * @brief      get the current fifo watermark level
- * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *level points to a current watermark level buffer
- * @return     status code
- *             - 0 success
- *             - 1 get watermark level failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     enable or disable the full resolution
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set full resolution failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t adxl345_get_watermark_level(adxl345_handle_t *handle, uint8_t *level)
+uint8_t adxl345_set_full_resolution(adxl345_handle_t *handle, adxl345_bool_t enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                               /* return error */
     }
+    a_adxl345_lock(handle);                                                                     /* lock */
+    ADXL345_TRACE_API(handle);                                                                  /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_STATUS, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                               /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        a_adxl345_unlock(handle);                                                               /* unlock */
         
-        return 1;                                                                             /* return error */
+        return 1;                                                                               /* return error */
     }
-    prev &= (0x3F);                                                                           /* get config */
-    *level = prev & 0x3F;                                                                     /* get level */
+    prev &= ~(1 << 3);                                                                          /* clear resolution */
+    prev |= (enable << 3);                                                                      /* set resolution */
     
-    return 0;                                                                                 /* success return 0 */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                   /* unlock */
+    
+    return res;                                                                                 /* return the result */
 }
 
 /**
- * @brief      get the trigger status
+ * @brief      get the full resolution status
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *status points to a trigger status buffer
+ * @param[out] *enable points to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get trigger status failed
+ *             - 1 get full resolution failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_trigger_status(adxl345_handle_t *handle, adxl345_trigger_status_t *status)
+uint8_t adxl345_get_full_resolution(adxl345_handle_t *handle, adxl345_bool_t *enable)
 {
     uint8_t res, prev;
     
@@ -2720,328 +3493,538 @@ uint8_t adxl345_get_trigger_status(adxl345_handle_t *handle, adxl345_trigger_sta
     {
         return 3;                                                                             /* return error */
     }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_STATUS, (uint8_t *)&prev, 1);       /* read config */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
     if (res != 0)                                                                             /* check result */
     {
         handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
-       
+        a_adxl345_unlock(handle);                                                             /* unlock */
+        
         return 1;                                                                             /* return error */
     }
-    prev &= (1 << 7);                                                                         /* get config */
-    *status = (adxl345_trigger_status_t)((prev >> 7) & 0x01);                                 /* get status */
-
+    prev &= (1 << 3);                                                                         /* clear config */
+    *enable = (adxl345_bool_t)(prev >> 3);                                                    /* set resolution */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
+    
     return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the activity and inactivity linking
+ * @brief     enable or disable the justify
  * @param[in] *handle points to a adxl345 handle structure
  * @param[in] enable is a bool value
  * @return    status code
  *            - 0 success
- *            - 1 set link activity inactivity failed
+ *            - 1 set justify failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_link_activity_inactivity(adxl345_handle_t *handle, adxl345_bool_t enable)
+uint8_t adxl345_set_justify(adxl345_handle_t *handle, adxl345_justify_t enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                               /* return error */
     }
+    a_adxl345_lock(handle);                                                                     /* lock */
+    ADXL345_TRACE_API(handle);                                                                  /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                               /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
-       
-        return 1;                                                                             /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        a_adxl345_unlock(handle);                                                               /* unlock */
+        
+        return 1;                                                                               /* return error */
     }
-    prev &= ~(1 << 5);                                                                        /* clear config */
-    prev |= enable << 5;                                                                      /* set enable */
-
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* write config */
+    prev &= ~(1 << 2);                                                                          /* clear config */
+    prev |= (enable << 2);                                                                      /* set justify */
+    
+    res = a_adxl345_cache_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                   /* unlock */
+    
+    return res;                                                                                 /* return the result */
 }
 
 /**
- * @brief      get the activity and inactivity linking status
+ * @brief      get the justify status
  * @param[in]  *handle points to a adxl345 handle structure
  * @param[out] *enable points to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get link activity inactivity failed
+ *             - 1 get justify failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_link_activity_inactivity(adxl345_handle_t *handle, adxl345_bool_t *enable)
+uint8_t adxl345_get_justify(adxl345_handle_t *handle, adxl345_justify_t *enable)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                             /* return error */
     }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                           /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
-       
-        return 1;                                                                           /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
+        
+        return 1;                                                                             /* return error */
     }
-    prev &= 1 << 5;                                                                         /* get config */
-    *enable = (adxl345_bool_t)(prev >> 5);                                                  /* get enable */
-
-    return 0;                                                                               /* success return 0 */
+    prev &= (1 << 2);                                                                         /* get config */
+    *enable = (adxl345_justify_t)(prev >> 2);                                                 /* get justify */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
+    
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the auto sleep
+ * @brief     set the chip range
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] enable is a bool value
+ * @param[in] range is the measurement range
  * @return    status code
  *            - 0 success
- *            - 1 set auto sleep failed
+ *            - 1 set range failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_auto_sleep(adxl345_handle_t *handle, adxl345_bool_t enable)
+uint8_t adxl345_set_range(adxl345_handle_t *handle, adxl345_range_t range)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                               /* return error */
     }
+    a_adxl345_lock(handle);                                                                     /* lock */
+    ADXL345_TRACE_API(handle);                                                                  /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                               /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                         /* read failed */
+        a_adxl345_unlock(handle);                                                               /* unlock */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                               /* return error */
     }
-    prev &= ~(1 << 4);                                                                        /* get config */
-    prev |= enable << 4;                                                                      /* set enable */
+    prev &= ~(3 << 0);                                                                          /* clear config */
+    prev |= (range << 0);                                                                       /* set range */
 
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                   /* unlock */
+    
+    return res;                                                                                 /* return the result */
 }
 
 /**
- * @brief      get the auto sleep status
+ * @brief      get the chip range
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *enable points to a bool value buffer
+ * @param[out] *range points to a measurement range buffer
  * @return     status code
  *             - 0 success
- *             - 1 get auto sleep failed
+ *             - 1 get range failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_auto_sleep(adxl345_handle_t *handle, adxl345_bool_t *enable)
+uint8_t adxl345_get_range(adxl345_handle_t *handle, adxl345_range_t *range)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                             /* return error */
     }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                           /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
         
-        return 1;                                                                           /* return error */
+        return 1;                                                                             /* return error */
     }
-    prev &= 1 << 4;                                                                         /* get config */
-    *enable = (adxl345_bool_t)(prev >> 4);                                                  /* get auto sleep */
+    prev &= (3 << 0);                                                                         /* get config */
+    *range = (adxl345_range_t)(prev >> 0);                                                    /* set range */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
     
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the measure
+ * @brief     set the chip mode
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] enable is a bool value
+ * @param[in] mode is the chip mode
  * @return    status code
  *            - 0 success
- *            - 1 set measure failed
+ *            - 1 set mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_measure(adxl345_handle_t *handle, adxl345_bool_t enable)
+uint8_t adxl345_set_mode(adxl345_handle_t *handle, adxl345_mode_t mode)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                            /* return error */
     }
+    a_adxl345_lock(handle);                                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                                               /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        a_adxl345_unlock(handle);                                                            /* unlock */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                            /* return error */
     }
-    prev &= ~(1 << 3);                                                                        /* clear config */
-    prev |= enable << 3;                                                                      /* set measure */
-
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* write config */
+    prev &= ~(3 << 6);                                                                       /* clear config */
+    prev |= (mode << 6);                                                                     /* set mode */
+    
+    res = a_adxl345_cache_write(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                /* unlock */
+    
+    return res;                                                                              /* return the result */
 }
 
 /**
- * @brief      get the measure status
+ * @brief      get the chip mode
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *enable points to a bool value buffer
+ * @param[out] *mode points to a chip mode buffer
  * @return     status code
  *             - 0 success
- *             - 1 get measure failed
+ *             - 1 get mode failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_measure(adxl345_handle_t *handle, adxl345_bool_t *enable)
+uint8_t adxl345_get_mode(adxl345_handle_t *handle, adxl345_mode_t *mode)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                          /* return error */
     }
+    a_adxl345_lock(handle);                                                                /* lock */
+    ADXL345_TRACE_API(handle);                                                             /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                           /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                    /* read failed */
+        a_adxl345_unlock(handle);                                                          /* unlock */
        
-        return 1;                                                                           /* return error */
+        return 1;                                                                          /* return error */
     }
-    prev &= 1 << 3;                                                                         /* get config */
-    *enable = (adxl345_bool_t)(prev >> 3);                                                  /* get measure */
+    prev &= (3 << 6);                                                                      /* get config */
+    *mode = (adxl345_mode_t)(prev >> 6);                                                   /* set mode */
+    a_adxl345_unlock(handle);                                                              /* unlock */
 
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the sleep mode
+ * @brief     set the trigger pin
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] enable is a bool value
+ * @param[in] pin is the trigger pin
  * @return    status code
  *            - 0 success
- *            - 1 set sleep failed
+ *            - 1 set trigger pin failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_sleep(adxl345_handle_t *handle, adxl345_bool_t enable)
+uint8_t adxl345_set_trigger_pin(adxl345_handle_t *handle, adxl345_interrupt_pin_t pin)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                            /* return error */
     }
+    a_adxl345_lock(handle);                                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                                               /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        a_adxl345_unlock(handle);                                                            /* unlock */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                            /* return error */
     }
-    prev &= ~(1 << 2);                                                                        /* clear config */
-    prev |= enable << 2;                                                                      /* set sleep */
+    prev &= ~(1 << 5);                                                                       /* clear config */
+    prev |= (pin << 5);                                                                      /* set pin */
 
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                /* unlock */
+    
+    return res;                                                                              /* return the result */
 }
 
 /**
- * @brief      get the sleep mode status
+ * @brief      get the trigger pin
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *enable points to a bool value buffer
+ * @param[out] *pin points to a trigger pin buffer
  * @return     status code
  *             - 0 success
- *             - 1 get sleep failed
+ *             - 1 get trigger pin failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_sleep(adxl345_handle_t *handle, adxl345_bool_t *enable)
+uint8_t adxl345_get_trigger_pin(adxl345_handle_t *handle, adxl345_interrupt_pin_t *pin)
 {
     uint8_t res, prev;
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                          /* return error */
     }
+    a_adxl345_lock(handle);                                                                /* lock */
+    ADXL345_TRACE_API(handle);                                                             /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                           /* check result */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
+        handle->debug_print("adxl345: read failed.\n");                                    /* read failed */
+        a_adxl345_unlock(handle);                                                          /* unlock */
        
-        return 1;                                                                           /* return error */
+        return 1;                                                                          /* return error */
     }
-    prev &= 1 << 2;                                                                         /* get config */
-    *enable = (adxl345_bool_t)(prev >> 2);                                                  /* get sleep */
-    
-    return 0;                                                                               /* success return 0 */
+    prev &= (1 << 5);                                                                      /* clear config */
+    *pin = (adxl345_interrupt_pin_t)(prev >> 5);                                           /* set pin */
+    a_adxl345_unlock(handle);                                                              /* unlock */
+
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     set the sleep frequency
+ * @brief     set the fifo watermark
  * @param[in] *handle points to a adxl345 handle structure
- * @param[in] sleep_frequency is the sleep frequency
+ * @param[in] level is the watermark level
  * @return    status code
  *            - 0 success
- *            - 1 set sleep frequency failed
+ *            - 1 set watermark failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      level <= 0x1F
+ */
+uint8_t adxl345_set_watermark(adxl345_handle_t *handle, uint8_t level)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    a_adxl345_lock(handle);                                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                                               /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                            /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        a_adxl345_unlock(handle);                                                            /* unlock */
+       
+        return 1;                                                                            /* return error */
+    }
+    prev &= ~(0x1F);                                                                         /* clear config */
+    prev |= (level & 0x1F);                                                                  /* set watermark */
+
+    res = a_adxl345_cache_write(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                /* unlock */
+    
+    return res;                                                                              /* return the result */
+}
+
+/**
+ * @brief      get the fifo watermark
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *level points to a watermark level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get watermark failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_get_watermark(adxl345_handle_t *handle, uint8_t *level)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    a_adxl345_lock(handle);                                                                /* lock */
+    ADXL345_TRACE_API(handle);                                                             /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                          /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                    /* read failed */
+        a_adxl345_unlock(handle);                                                          /* unlock */
+       
+        return 1;                                                                          /* return error */
+    }
+    prev &= (0x1F);                                                                        /* get config */
+    *level = prev & 0x1F;                                                                  /* get watermark */
+    a_adxl345_unlock(handle);                                                              /* unlock */
+
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the current fifo watermark level
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *level points to a current watermark level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get watermark level failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_get_watermark_level(adxl345_handle_t *handle, uint8_t *level)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
+    
+    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_STATUS, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
+        
+        return 1;                                                                             /* return error */
+    }
+    prev &= (0x3F);                                                                           /* get config */
+    *level = prev & 0x3F;                                                                     /* get level */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the trigger status
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *status points to a trigger status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get trigger status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_get_trigger_status(adxl345_handle_t *handle, adxl345_trigger_status_t *status)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
+    
+    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_STATUS, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
+       
+        return 1;                                                                             /* return error */
+    }
+    prev &= (1 << 7);                                                                         /* get config */
+    *status = (adxl345_trigger_status_t)((prev >> 7) & 0x01);                                 /* get status */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
+
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the activity and inactivity linking
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set link activity inactivity failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t adxl345_set_sleep_frequency(adxl345_handle_t *handle, adxl345_sleep_frequency_t sleep_frequency)
+uint8_t adxl345_set_link_activity_inactivity(adxl345_handle_t *handle, adxl345_bool_t enable)
 {
     uint8_t res, prev;
     
@@ -3053,32 +4036,38 @@ uint8_t adxl345_set_sleep_frequency(adxl345_handle_t *handle, adxl345_sleep_freq
     {
         return 3;                                                                             /* return error */
     }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* read config */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);           /* read config */
     if (res != 0)                                                                             /* check result */
     {
         handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
        
         return 1;                                                                             /* return error */
     }
-    prev &= ~0x03;                                                                            /* clear config */
-    prev |= sleep_frequency;                                                                  /* set frequency */
+    prev &= ~(1 << 5);                                                                        /* clear config */
+    prev |= enable << 5;                                                                      /* set enable */
 
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* write config */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
+    
+    return res;                                                                               /* return the result */
 }
 
 /**
- * @brief      get the sleep frequency
+ * @brief      get the activity and inactivity linking status
  * @param[in]  *handle points to a adxl345 handle structure
- * @param[out] *sleep_frequency points to a sleep frequency buffer
+ * @param[out] *enable points to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get sleep frequency failed
+ *             - 1 get link activity inactivity failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t adxl345_get_sleep_frequency(adxl345_handle_t *handle, adxl345_sleep_frequency_t *sleep_frequency)
+uint8_t adxl345_get_link_activity_inactivity(adxl345_handle_t *handle, adxl345_bool_t *enable)
 {
     uint8_t res, prev;
     
@@ -3090,419 +4079,2530 @@ uint8_t adxl345_get_sleep_frequency(adxl345_handle_t *handle, adxl345_sleep_freq
     {
         return 3;                                                                           /* return error */
     }
+    a_adxl345_lock(handle);                                                                 /* lock */
+    ADXL345_TRACE_API(handle);                                                              /* tag the api */
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* read config */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* read config */
     if (res != 0)                                                                           /* check result */
     {
         handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
+        a_adxl345_unlock(handle);                                                           /* unlock */
        
         return 1;                                                                           /* return error */
     }
-    prev &= 0x03;                                                                           /* get config */
-    *sleep_frequency = (adxl345_sleep_frequency_t)(prev & 0x03);                            /* get frequency */
-   
+    prev &= 1 << 5;                                                                         /* get config */
+    *enable = (adxl345_bool_t)(prev >> 5);                                                  /* get enable */
+    a_adxl345_unlock(handle);                                                               /* unlock */
+
     return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief     enable or disable the auto sleep
  * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] enable is a bool value
  * @return    status code
  *            - 0 success
- *            - 1 close failed
+ *            - 1 set auto sleep failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t adxl345_set_auto_sleep(adxl345_handle_t *handle, adxl345_bool_t enable)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
+       
+        return 1;                                                                             /* return error */
+    }
+    prev &= ~(1 << 4);                                                                        /* get config */
+    prev |= enable << 4;                                                                      /* set enable */
+
+    res = a_adxl345_cache_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
+    
+    return res;                                                                               /* return the result */
+}
+
+/**
+ * @brief      get the auto sleep status
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *enable points to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get auto sleep failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_get_auto_sleep(adxl345_handle_t *handle, adxl345_bool_t *enable)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    a_adxl345_lock(handle);                                                                 /* lock */
+    ADXL345_TRACE_API(handle);                                                              /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
+        a_adxl345_unlock(handle);                                                           /* unlock */
+        
+        return 1;                                                                           /* return error */
+    }
+    prev &= 1 << 4;                                                                         /* get config */
+    *enable = (adxl345_bool_t)(prev >> 4);                                                  /* get auto sleep */
+    a_adxl345_unlock(handle);                                                               /* unlock */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the measure
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set measure failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
  * @note      none
  */
-static uint8_t a_adxl345_close(adxl345_handle_t *handle)
+uint8_t adxl345_set_measure(adxl345_handle_t *handle, adxl345_bool_t enable)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
+       
+        return 1;                                                                             /* return error */
+    }
+    prev &= ~(1 << 3);                                                                        /* clear config */
+    prev |= enable << 3;                                                                      /* set measure */
+
+    res = a_adxl345_cache_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
+    
+    return res;                                                                               /* return the result */
+}
+
+/**
+ * @brief      get the measure status
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *enable points to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get measure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_get_measure(adxl345_handle_t *handle, adxl345_bool_t *enable)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    a_adxl345_lock(handle);                                                                 /* lock */
+    ADXL345_TRACE_API(handle);                                                              /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
+        a_adxl345_unlock(handle);                                                           /* unlock */
+       
+        return 1;                                                                           /* return error */
+    }
+    prev &= 1 << 3;                                                                         /* get config */
+    *enable = (adxl345_bool_t)(prev >> 3);                                                  /* get measure */
+    a_adxl345_unlock(handle);                                                               /* unlock */
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the sleep mode
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set sleep failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t adxl345_set_sleep(adxl345_handle_t *handle, adxl345_bool_t enable)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
+       
+        return 1;                                                                             /* return error */
+    }
+    prev &= ~(1 << 2);                                                                        /* clear config */
+    prev |= enable << 2;                                                                      /* set sleep */
+
+    res = a_adxl345_cache_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
+    
+    return res;                                                                               /* return the result */
+}
+
+/**
+ * @brief      get the sleep mode status
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *enable points to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get sleep failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_get_sleep(adxl345_handle_t *handle, adxl345_bool_t *enable)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    a_adxl345_lock(handle);                                                                 /* lock */
+    ADXL345_TRACE_API(handle);                                                              /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
+        a_adxl345_unlock(handle);                                                           /* unlock */
+       
+        return 1;                                                                           /* return error */
+    }
+    prev &= 1 << 2;                                                                         /* get config */
+    *enable = (adxl345_bool_t)(prev >> 2);                                                  /* get sleep */
+    a_adxl345_unlock(handle);                                                               /* unlock */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the sleep frequency
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] sleep_frequency is the sleep frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 set sleep frequency failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t adxl345_set_sleep_frequency(adxl345_handle_t *handle, adxl345_sleep_frequency_t sleep_frequency)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    a_adxl345_lock(handle);                                                                   /* lock */
+    ADXL345_TRACE_API(handle);                                                                /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);           /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+        a_adxl345_unlock(handle);                                                             /* unlock */
+       
+        return 1;                                                                             /* return error */
+    }
+    prev &= ~0x03;                                                                            /* clear config */
+    prev |= sleep_frequency;                                                                  /* set frequency */
+
+    res = a_adxl345_cache_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);          /* write config */
+    a_adxl345_unlock(handle);                                                                 /* unlock */
+    
+    return res;                                                                               /* return the result */
+}
+
+/**
+ * @brief      get the sleep frequency
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *sleep_frequency points to a sleep frequency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get sleep frequency failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t adxl345_get_sleep_frequency(adxl345_handle_t *handle, adxl345_sleep_frequency_t *sleep_frequency)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    a_adxl345_lock(handle);                                                                 /* lock */
+    ADXL345_TRACE_API(handle);                                                              /* tag the api */
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* read config */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                     /* read failed */
+        a_adxl345_unlock(handle);                                                           /* unlock */
+       
+        return 1;                                                                           /* return error */
+    }
+    prev &= 0x03;                                                                           /* get config */
+    *sleep_frequency = (adxl345_sleep_frequency_t)(prev & 0x03);                            /* get frequency */
+    a_adxl345_unlock(handle);                                                               /* unlock */
+   
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      none
+ */
+static uint8_t a_adxl345_close(adxl345_handle_t *handle)
+{
+    if (handle->iic_spi == ADXL345_INTERFACE_IIC)                        /* iic interface */
+    {
+        if (handle->iic_deinit() != 0)                                   /* iic deinit */
+        {
+            handle->debug_print("adxl345: iic deinit failed.\n");        /* iic deinit failed */
+       
+            return 1;                                                    /* return error */
+        }
+        else
+        {
+            return 0;                                                    /* success return 0 */
+        }
+    }
+    else                                                                 /* spi interface */
+    {
+        if (handle->spi_deinit() != 0)                                   /* spi deinit */
+        {
+            handle->debug_print("adxl345: spi deinit failed.\n");        /* spi deinit failed */
+       
+            return 1;                                                    /* return error */
+        }
+        else
+        {
+            return 0;                                                    /* success return 0 */
+        }
+    }
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi or iic initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 id is invalid
+ *            - 5 load register cache failed
+ * @note      one of receive_callback and event_callback must be linked
+ */
+uint8_t adxl345_init(adxl345_handle_t *handle)
+{
+    uint8_t id;
+  
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (handle->debug_print == NULL)                                                /* check debug_print */
+    {
+        return 3;                                                                   /* return error */
+    }
+    if (handle->iic_init == NULL)                                                   /* check iic_init */
+    {
+        handle->debug_print("adxl345: iic_init is null.\n");                        /* iic_init is null */
+       
+        return 3;                                                                   /* return error */
+    }
+    if (handle->iic_deinit == NULL)                                                 /* check iic_deinit */
+    {
+        handle->debug_print("adxl345: iic_deinit is null.\n");                      /* iic_deinit is null */
+       
+        return 3;                                                                   /* return error */
+    }
+    if (handle->iic_read == NULL)                                                   /* check iic_read */
+    {
+        handle->debug_print("adxl345: iic_read is null.\n");                        /* iic_read is null */
+       
+        return 3;                                                                   /* return error */
+    }
+    if (handle->iic_write == NULL)                                                  /* check iic_write */
+    {
+        handle->debug_print("adxl345: iic_write is null.\n");                       /* iic_write is null */
+       
+        return 3;                                                                   /* return error */
+    }
+    if (handle->spi_init == NULL)                                                   /* check spi_init */
+    {
+        handle->debug_print("adxl345: spi_init is null.\n");                        /* spi_init is null */
+       
+        return 3;                                                                   /* return error */
+    }
+    if (handle->spi_deinit == NULL)                                                 /* check spi_deinit */
+    {
+        handle->debug_print("adxl345: spi_deinit is null.\n");                      /* spi_deinit is null */
+       
+        return 3;                                                                   /* return error */
+    }
+    if (handle->spi_read == NULL)                                                   /* check spi_read */
+    {
+        handle->debug_print("adxl345: spi_read is null.\n");                        /* spi_read is null */
+       
+        return 3;                                                                   /* return error */
+    }
+    if (handle->spi_write == NULL)                                                  /* check spi_write */
+    {
+        handle->debug_print("adxl345: spi_write is null.\n");                       /* spi_write is null */
+       
+        return 3;                                                                   /* return error */
+    }
+    if (handle->delay_ms == NULL)                                                   /* check delay_ms */
+    {
+        handle->debug_print("adxl345: delay_ms is null.\n");                        /* delay_ms is null */
+       
+        return 3;                                                                   /* return error */
+    }
+    if ((handle->receive_callback == NULL) && (handle->event_callback == NULL))     /* check receive_callback */
+    {
+        handle->debug_print("adxl345: receive_callback is null.\n");                /* receive_callback is null */
+       
+        return 3;                                                                   /* return error */
+    }
+    
+    if (handle->iic_spi == ADXL345_INTERFACE_IIC)                                   /* iic interface */
+    {
+        if (handle->iic_init() != 0)                                                /* initialize iic bus */
+        {
+            handle->debug_print("adxl345: iic init failed.\n");                     /* iic init failed */
+            
+            return 1;                                                               /* return error */
+        }
+    }
+    else                                                                            /* spi interface */
+    {
+        if (handle->spi_init() != 0)                                                /* initialize spi bus */
+        {
+            handle->debug_print("adxl345: spi init failed.\n");                     /* spi init failed */
+           
+            return 1;                                                               /* return error */
+        }
+    }
+    a_adxl345_lock(handle);                                                         /* lock */
+    ADXL345_TRACE_API(handle);                                                      /* tag the api */
+    if (a_adxl345_iic_spi_read(handle, ADXL345_REG_DEVID, (uint8_t *)&id, 1) != 0)  /* read id */
+    {
+        handle->debug_print("adxl345: read failed.\n");                             /* read failed */
+        (void)a_adxl345_close(handle);                                              /* close */
+        a_adxl345_unlock(handle);                                                   /* unlock */
+        
+        return 4;                                                                   /* return error */
+    }
+    if (id != 0xE5)                                                                 /* check id */
+    {
+        handle->debug_print("adxl345: id is invalid.\n");                           /* id is invalid */
+        (void)a_adxl345_close(handle);                                              /* close */
+        a_adxl345_unlock(handle);                                                   /* unlock */
+       
+        return 4;                                                                   /* return error */
+    }
+    if (handle->reg_cache_enable != 0)                                              /* if register cache is enabled */
+    {
+        if (a_adxl345_cache_load(handle) != 0)                                      /* load register cache */
+        {
+            handle->debug_print("adxl345: load register cache failed.\n");          /* load register cache failed */
+            (void)a_adxl345_close(handle);                                          /* close */
+            a_adxl345_unlock(handle);                                               /* unlock */
+            
+            return 5;                                                               /* return error */
+        }
+    }
+    handle->inited = 1;                                                             /* flag finish initialization */
+    a_adxl345_unlock(handle);                                                       /* unlock */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 power down failed
+ * @note      none
+ */
+uint8_t adxl345_deinit(adxl345_handle_t *handle)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    a_adxl345_lock(handle);                                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                                               /* tag the api */
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                                     /* check async state */
+    {
+        handle->debug_print("adxl345: async read is busy.\n");                               /* async read is busy */
+        a_adxl345_unlock(handle);                                                            /* unlock */
+        
+        return 5;                                                                            /* return error */
+    }
+    
+    res = a_adxl345_cache_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);          /* read config */
+    if (res != 0)                                                                            /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        a_adxl345_unlock(handle);                                                            /* unlock */
+       
+        return 4;                                                                            /* return error */
+    }
+    prev &= ~(1 << 3);                                                                       /* stop measure */
+    prev |= 1 << 2;                                                                          /* sleep */
+    res = a_adxl345_cache_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);         /* write config */
+    if (res != 0)                                                                            /* check result */
+    {
+        handle->debug_print("adxl345: write failed.\n");                                     /* write failed */
+        a_adxl345_unlock(handle);                                                            /* unlock */
+       
+        return 4;                                                                            /* return error */
+    }
+    else
+    {
+        res = a_adxl345_close(handle);                                                       /* close */
+        if (res != 0)                                                                        /* check result */
+        {
+            a_adxl345_unlock(handle);                                                        /* unlock */
+            return 1;                                                                        /* return error */
+        }
+        else
+        {
+            handle->inited = 0;                                                              /* flag close */
+            handle->reg_cache_valid = 0;                                                     /* flag register cache invalid */
+            handle->session.prepared = 0;                                                    /* flag session not prepared */
+            handle->irq_frame.pending = 0;                                                   /* flag irq frame consumed */
+            a_adxl345_unlock(handle);                                                        /* unlock */
+    
+            return 0;                                                                        /* success return 0 */
+        }
+    }
+}
+
+/**
+ * @brief     sign extend the data registers
+ * @param[in] lsb is the low byte
+ * @param[in] msb is the high byte
+ * @param[in] n is the justify shift
+ * @return    raw data
+ * @note      portable, no right shift of a negative value is used
+ */
+static inline int16_t a_adxl345_sign_extend(uint8_t lsb, uint8_t msb, uint8_t n)
+{
+    int32_t u;
+    int32_t m;
+    
+    u = (int32_t)((uint16_t)(((uint16_t)msb << 8) | lsb) >> n);        /* shift the data */
+    m = (int32_t)1 << (15 - n);                                         /* sign bit */
+    
+    return (int16_t)((u ^ m) - m);                                      /* extend the sign */
+}
+
+/**
+ * @brief     convert the raw data to mg
+ * @param[in] raw is the raw data
+ * @param[in] ug is the scale factor in ug/LSB
+ * @return    rounded mg data
+ * @note      rounds half away from zero without a branch
+ */
+static inline int32_t a_adxl345_raw_to_mg(int16_t raw, int32_t ug)
+{
+    int32_t v;
+    
+    v = (int32_t)raw * ug;                                                   /* convert to ug */
+    
+    return (v + 500 - (int32_t)(((uint32_t)v >> 31) * 1000)) / 1000;         /* round */
+}
+
+/**
+ * @brief     define the decode kernels for one justify shift
+ * @param[in] N is the justify shift
+ * @note      the shift is a compile time constant in every kernel
+ */
+#define ADXL345_DECODE_KERNEL(N)                                                               \
+static void a_adxl345_decode_shift_##N(uint8_t *buf, int16_t (*raw)[3], uint16_t len)         \
+{                                                                                              \
+    uint16_t i;                                                                                \
+                                                                                               \
+    for (i = 0; i < len; i++)                                                                  \
+    {                                                                                          \
+        raw[i][0] = a_adxl345_sign_extend(buf[i * 6 + 0], buf[i * 6 + 1], N);                  \
+        raw[i][1] = a_adxl345_sign_extend(buf[i * 6 + 2], buf[i * 6 + 3], N);                  \
+        raw[i][2] = a_adxl345_sign_extend(buf[i * 6 + 4], buf[i * 6 + 5], N);                  \
+    }                                                                                          \
+}                                                                                              \
+static void a_adxl345_decode_g_shift_##N(uint8_t *buf, int16_t (*raw)[3], float (*g)[3],      \
+                                         uint16_t len, float scale)                           \
+{                                                                                              \
+    uint16_t i;                                                                                \
+                                                                                               \
+    for (i = 0; i < len; i++)                                                                  \
+    {                                                                                          \
+        raw[i][0] = a_adxl345_sign_extend(buf[i * 6 + 0], buf[i * 6 + 1], N);                  \
+        raw[i][1] = a_adxl345_sign_extend(buf[i * 6 + 2], buf[i * 6 + 3], N);                  \
+        raw[i][2] = a_adxl345_sign_extend(buf[i * 6 + 4], buf[i * 6 + 5], N);                  \
+        g[i][0] = (float)(raw[i][0]) * scale;                                                  \
+        g[i][1] = (float)(raw[i][1]) * scale;                                                  \
+        g[i][2] = (float)(raw[i][2]) * scale;                                                  \
+    }                                                                                          \
+}                                                                                              \
+static void a_adxl345_decode_soa_shift_##N(uint8_t *buf, float *x, float *y, float *z,        \
+                                           uint16_t stride, uint16_t len, float scale)        \
+{                                                                                              \
+    uint16_t i;                                                                                \
+    uint32_t j;                                                                                \
+                                                                                               \
+    for (i = 0, j = 0; i < len; i++, j += stride)                                              \
+    {                                                                                          \
+        x[j] = (float)a_adxl345_sign_extend(buf[i * 6 + 0], buf[i * 6 + 1], N) * scale;        \
+        y[j] = (float)a_adxl345_sign_extend(buf[i * 6 + 2], buf[i * 6 + 3], N) * scale;        \
+        z[j] = (float)a_adxl345_sign_extend(buf[i * 6 + 4], buf[i * 6 + 5], N) * scale;        \
+    }                                                                                          \
+}
+
+ADXL345_DECODE_KERNEL(0)        /* right justify */
+ADXL345_DECODE_KERNEL(3)        /* left justify, full resolution 16g */
+ADXL345_DECODE_KERNEL(4)        /* left justify, full resolution 8g */
+ADXL345_DECODE_KERNEL(5)        /* left justify, full resolution 4g */
+ADXL345_DECODE_KERNEL(6)        /* left justify, 10 bits */
+
+/**
+ * @brief adxl345 decoder structure definition
+ */
+typedef struct a_adxl345_decoder_s
+{
+    void (*kernel)(uint8_t *buf, int16_t (*raw)[3], uint16_t len);                                   /**< raw decode kernel */
+    void (*kernel_g)(uint8_t *buf, int16_t (*raw)[3], float (*g)[3], uint16_t len, float scale);     /**< raw and g decode kernel */
+    void (*kernel_soa)(uint8_t *buf, float *x, float *y, float *z,
+                       uint16_t stride, uint16_t len, float scale);                                  /**< per axis g decode kernel */
+    float scale;                                                                                     /**< scale factor in g/LSB */
+    int32_t ug;                                                                                      /**< scale factor in ug/LSB */
+} a_adxl345_decoder_t;
+
+/**
+ * @brief register a decoder for one justify shift
+ */
+#define ADXL345_DECODER(N, SCALE, UG)        {a_adxl345_decode_shift_##N, a_adxl345_decode_g_shift_##N, \
+                                              a_adxl345_decode_soa_shift_##N, SCALE, UG}
+
+/**
+ * @brief decoder table indexed by the full_res, justify and range bits of the data format register
+ */
+static const a_adxl345_decoder_t gs_decoder[16] =
+{
+    ADXL345_DECODER(0, 0.0039f, 3900),         /* 10 bits, right justify, 2g */
+    ADXL345_DECODER(0, 0.0078f, 7800),         /* 10 bits, right justify, 4g */
+    ADXL345_DECODER(0, 0.0156f, 15600),        /* 10 bits, right justify, 8g */
+    ADXL345_DECODER(0, 0.0312f, 31200),        /* 10 bits, right justify, 16g */
+    ADXL345_DECODER(6, 0.0039f, 3900),         /* 10 bits, left justify, 2g */
+    ADXL345_DECODER(6, 0.0078f, 7800),         /* 10 bits, left justify, 4g */
+    ADXL345_DECODER(6, 0.0156f, 15600),        /* 10 bits, left justify, 8g */
+    ADXL345_DECODER(6, 0.0312f, 31200),        /* 10 bits, left justify, 16g */
+    ADXL345_DECODER(0, 0.004f, 4000),          /* full resolution, right justify, 2g */
+    ADXL345_DECODER(0, 0.004f, 4000),          /* full resolution, right justify, 4g */
+    ADXL345_DECODER(0, 0.004f, 4000),          /* full resolution, right justify, 8g */
+    ADXL345_DECODER(0, 0.004f, 4000),          /* full resolution, right justify, 16g */
+    ADXL345_DECODER(6, 0.004f, 4000),          /* full resolution, left justify, 2g */
+    ADXL345_DECODER(5, 0.004f, 4000),          /* full resolution, left justify, 4g */
+    ADXL345_DECODER(4, 0.004f, 4000),          /* full resolution, left justify, 8g */
+    ADXL345_DECODER(3, 0.004f, 4000),          /* full resolution, left justify, 16g */
+};
+
+/**
+ * @brief      decode the raw data registers
+ * @param[in]  *buf points to a data register buffer
+ * @param[out] **raw points to a raw data buffer
+ * @param[out] **g points to a converted data buffer
+ * @param[out] **mg points to a mg data buffer
+ * @param[in]  len is the sample number
+ * @param[in]  format is the full_res, justify and range bits
+ * @note       g and mg can be NULL
+ */
+static void a_adxl345_decode(uint8_t *buf, int16_t (*raw)[3], float (*g)[3], int32_t (*mg)[3], uint16_t len,
+                             uint8_t format)
+{
+    uint16_t i;
+    const a_adxl345_decoder_t *decoder;
+    
+    decoder = &gs_decoder[format & 0x0F];                                        /* get decoder */
+    if (g != NULL)                                                               /* if g is requested */
+    {
+        decoder->kernel_g(buf, raw, g, len, decoder->scale);                     /* decode raw and g data */
+    }
+    else
+    {
+        decoder->kernel(buf, raw, len);                                          /* decode raw data */
+    }
+    if (mg != NULL)                                                              /* if mg is requested */
+    {
+        for (i = 0; i < len; i++)                                                /* convert all */
+        {
+            mg[i][0] = a_adxl345_raw_to_mg(raw[i][0], decoder->ug);              /* convert x */
+            mg[i][1] = a_adxl345_raw_to_mg(raw[i][1], decoder->ug);              /* convert y */
+            mg[i][2] = a_adxl345_raw_to_mg(raw[i][2], decoder->ug);              /* convert z */
+        }
+    }
+}
+
+/**
+ * @brief      scalar convert kernel
+ * @param[in]  *buf points to a frame buffer
+ * @param[out] *g points to a float output buffer
+ * @param[out] *mg points to a mg output buffer
+ * @param[in]  n is the axis value number
+ * @param[in]  decoder points to a decoder
+ * @param[in]  shift is the justify shift
+ * @note       g and mg can be NULL
+ */
+static void a_adxl345_convert_scalar(uint8_t *buf, float *g, int32_t *mg, uint32_t n,
+                                     const a_adxl345_decoder_t *decoder, uint8_t shift)
+{
+    uint32_t i;
+    int16_t raw;
+    
+    for (i = 0; i < n; i++)                                                             /* convert all */
+    {
+        raw = a_adxl345_sign_extend(buf[i * 2 + 0], buf[i * 2 + 1], shift);             /* decode raw data */
+        if (g != NULL)                                                                  /* if g is requested */
+        {
+            g[i] = (float)(raw) * decoder->scale;                                       /* convert g */
+        }
+        if (mg != NULL)                                                                 /* if mg is requested */
+        {
+            mg[i] = a_adxl345_raw_to_mg(raw, decoder->ug);                              /* convert mg */
+        }
+    }
+}
+
+#if defined(ADXL345_CONVERT_SSE2)
+/**
+ * @brief      sse2 convert kernel
+ * @param[in]  *buf points to a frame buffer
+ * @param[out] *g points to a float output buffer
+ * @param[out] *mg points to a mg output buffer
+ * @param[in]  n is the axis value number
+ * @param[in]  decoder points to a decoder
+ * @param[in]  shift is the justify shift
+ * @note       mg is rounded from the exact value raw * ug / 100 divided by 10
+ */
+static void a_adxl345_convert_sse2(uint8_t *buf, float *g, int32_t *mg, uint32_t n,
+                                   const a_adxl345_decoder_t *decoder, uint8_t shift)
+{
+    uint32_t i;
+    __m128i v, cnt;
+    __m128 f[2], scale, k, ten, half, sign;
+    uint8_t j;
+    
+    cnt = _mm_cvtsi32_si128(shift);                                                      /* set shift */
+    scale = _mm_set1_ps(decoder->scale);                                                 /* set scale */
+    k = _mm_set1_ps((float)(decoder->ug / 100));                                         /* set ug / 100 */
+    ten = _mm_set1_ps(10.0f);                                                            /* set 10 */
+    half = _mm_set1_ps(0.5f);                                                            /* set 0.5 */
+    sign = _mm_set1_ps(-0.0f);                                                           /* set sign mask */
+    for (i = 0; i + 8 <= n; i += 8)                                                      /* 8 values per loop */
+    {
+        v = _mm_loadu_si128((const __m128i *)(buf + i * 2));                            /* load 8 values */
+        v = _mm_sra_epi16(v, cnt);                                                       /* sign extend */
+        f[0] = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));           /* convert low */
+        f[1] = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));           /* convert high */
+        for (j = 0; j < 2; j++)                                                          /* two halves */
+        {
+            if (g != NULL)                                                               /* if g is requested */
+            {
+                _mm_storeu_ps(g + i + j * 4, _mm_mul_ps(f[j], scale));                   /* store g */
+            }
+            if (mg != NULL)                                                              /* if mg is requested */
+            {
+                __m128 y;
+                
+                y = _mm_div_ps(_mm_mul_ps(f[j], k), ten);                                /* raw * ug / 1000 */
+                y = _mm_add_ps(y, _mm_or_ps(_mm_and_ps(y, sign), half));                 /* add half away from zero */
+                _mm_storeu_si128((__m128i *)(mg + i + j * 4), _mm_cvttps_epi32(y));      /* store mg */
+            }
+        }
+    }
+    a_adxl345_convert_scalar(buf + i * 2, (g != NULL) ? (g + i) : NULL,
+                             (mg != NULL) ? (mg + i) : NULL, n - i, decoder, shift);    /* convert the tail */
+}
+#endif
+
+#if defined(ADXL345_CONVERT_AVX2)
+/**
+ * @brief      avx2 convert kernel
+ * @param[in]  *buf points to a frame buffer
+ * @param[out] *g points to a float output buffer
+ * @param[out] *mg points to a mg output buffer
+ * @param[in]  n is the axis value number
+ * @param[in]  decoder points to a decoder
+ * @param[in]  shift is the justify shift
+ * @note       mg is rounded from the exact value raw * ug / 100 divided by 10
+ */
+__attribute__((target("avx2")))
+static void a_adxl345_convert_avx2(uint8_t *buf, float *g, int32_t *mg, uint32_t n,
+                                   const a_adxl345_decoder_t *decoder, uint8_t shift)
+{
+    uint32_t i;
+    __m128i cnt;
+    __m256i v;
+    __m256 f[2], scale, k, ten, half, sign;
+    uint8_t j;
+    
+    cnt = _mm_cvtsi32_si128(shift);                                                      /* set shift */
+    scale = _mm256_set1_ps(decoder->scale);                                              /* set scale */
+    k = _mm256_set1_ps((float)(decoder->ug / 100));                                      /* set ug / 100 */
+    ten = _mm256_set1_ps(10.0f);                                                         /* set 10 */
+    half = _mm256_set1_ps(0.5f);                                                         /* set 0.5 */
+    sign = _mm256_set1_ps(-0.0f);                                                        /* set sign mask */
+    for (i = 0; i + 16 <= n; i += 16)                                                    /* 16 values per loop */
+    {
+        v = _mm256_loadu_si256((const __m256i *)(buf + i * 2));                         /* load 16 values */
+        v = _mm256_sra_epi16(v, cnt);                                                    /* sign extend */
+        f[0] = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(v)));    /* convert low */
+        f[1] = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1))); /* convert high */
+        for (j = 0; j < 2; j++)                                                          /* two halves */
+        {
+            if (g != NULL)                                                               /* if g is requested */
+            {
+                _mm256_storeu_ps(g + i + j * 8, _mm256_mul_ps(f[j], scale));             /* store g */
+            }
+            if (mg != NULL)                                                              /* if mg is requested */
+            {
+                __m256 y;
+                
+                y = _mm256_div_ps(_mm256_mul_ps(f[j], k), ten);                          /* raw * ug / 1000 */
+                y = _mm256_add_ps(y, _mm256_or_ps(_mm256_and_ps(y, sign), half));        /* add half away from zero */
+                _mm256_storeu_si256((__m256i *)(mg + i + j * 8), _mm256_cvttps_epi32(y)); /* store mg */
+            }
+        }
+    }
+    a_adxl345_convert_scalar(buf + i * 2, (g != NULL) ? (g + i) : NULL,
+                             (mg != NULL) ? (mg + i) : NULL, n - i, decoder, shift);    /* convert the tail */
+}
+#endif
+
+#if defined(ADXL345_CONVERT_NEON)
+/**
+ * @brief      neon convert kernel
+ * @param[in]  *buf points to a frame buffer
+ * @param[out] *g points to a float output buffer
+ * @param[out] *mg points to a mg output buffer
+ * @param[in]  n is the axis value number
+ * @param[in]  decoder points to a decoder
+ * @param[in]  shift is the justify shift
+ * @note       mg uses the vector divide on aarch64 and the scalar kernel on armv7
+ */
+static void a_adxl345_convert_neon(uint8_t *buf, float *g, int32_t *mg, uint32_t n,
+                                   const a_adxl345_decoder_t *decoder, uint8_t shift)
+{
+    uint32_t i;
+    int16x8_t v, cnt;
+    float32x4_t f[2];
+    uint8_t j;
+#if defined(__aarch64__)
+    float32x4_t k, ten, half;
+    
+    k = vdupq_n_f32((float)(decoder->ug / 100));                                         /* set ug / 100 */
+    ten = vdupq_n_f32(10.0f);                                                            /* set 10 */
+    half = vdupq_n_f32(0.5f);                                                            /* set 0.5 */
+#else
+    if (mg != NULL)                                                                      /* no vector divide */
+    {
+        a_adxl345_convert_scalar(buf, g, mg, n, decoder, shift);                         /* convert with scalar */
+        
+        return;                                                                          /* return */
+    }
+#endif
+    cnt = vdupq_n_s16((int16_t)(-(int16_t)shift));                                       /* set right shift */
+    for (i = 0; i + 8 <= n; i += 8)                                                      /* 8 values per loop */
+    {
+        v = vreinterpretq_s16_u8(vld1q_u8(buf + i * 2));                                /* load 8 values */
+        v = vshlq_s16(v, cnt);                                                           /* sign extend */
+        f[0] = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));                                /* convert low */
+        f[1] = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));                               /* convert high */
+        for (j = 0; j < 2; j++)                                                          /* two halves */
+        {
+            if (g != NULL)                                                               /* if g is requested */
+            {
+                vst1q_f32(g + i + j * 4, vmulq_n_f32(f[j], decoder->scale));             /* store g */
+            }
+#if defined(__aarch64__)
+            if (mg != NULL)                                                              /* if mg is requested */
+            {
+                float32x4_t y;
+                
+                y = vdivq_f32(vmulq_f32(f[j], k), ten);                                  /* raw * ug / 1000 */
+                y = vaddq_f32(y, vbslq_f32(vcltzq_f32(y), vnegq_f32(half), half));       /* add half away from zero */
+                vst1q_s32(mg + i + j * 4, vcvtq_s32_f32(y));                             /* store mg */
+            }
+#endif
+        }
+    }
+    a_adxl345_convert_scalar(buf + i * 2, (g != NULL) ? (g + i) : NULL,
+                             (mg != NULL) ? (mg + i) : NULL, n - i, decoder, shift);    /* convert the tail */
+}
+#endif
+
+/**
+ * @brief convert kernel table indexed by adxl345_convert_kernel_t
+ */
+static void (*const gs_convert_kernel[4])(uint8_t *buf, float *g, int32_t *mg, uint32_t n,
+                                          const a_adxl345_decoder_t *decoder, uint8_t shift) =
+{
+    a_adxl345_convert_scalar,        /* scalar */
+#if defined(ADXL345_CONVERT_SSE2)
+    a_adxl345_convert_sse2,          /* sse2 */
+#else
+    NULL,                            /* sse2 */
+#endif
+#if defined(ADXL345_CONVERT_AVX2)
+    a_adxl345_convert_avx2,          /* avx2 */
+#else
+    NULL,                            /* avx2 */
+#endif
+#if defined(ADXL345_CONVERT_NEON)
+    a_adxl345_convert_neon,          /* neon */
+#else
+    NULL,                            /* neon */
+#endif
+};
+
+/**
+ * @brief justify shift table indexed by the full_res, justify and range bits of the data format register
+ */
+static const uint8_t gs_convert_shift[16] =
+{
+    0, 0, 0, 0, 6, 6, 6, 6, 0, 0, 0, 0, 6, 5, 4, 3,
+};
+
+static uint8_t gs_convert_kernel_detected = 0xFF;        /**< detected convert kernel, 0xFF means not detected */
+
+/**
+ * @brief     check whether a convert kernel runs on this cpu
+ * @param[in] kernel is the convert kernel
+ * @return    check result
+ *            - 0 not supported
+ *            - 1 supported
+ * @note      none
+ */
+static uint8_t a_adxl345_convert_supported(adxl345_convert_kernel_t kernel)
+{
+    if (((uint8_t)kernel > 3) || (gs_convert_kernel[kernel] == NULL))        /* check kernel */
+    {
+        return 0;                                                            /* not supported */
+    }
+#if defined(ADXL345_CONVERT_AVX2)
+    if (kernel == ADXL345_CONVERT_KERNEL_AVX2)                               /* if avx2 */
+    {
+        return (__builtin_cpu_supports("avx2") != 0) ? 1 : 0;                /* check cpu */
+    }
+#endif
+    
+    return 1;                                                                /* supported */
+}
+
+/**
+ * @brief  get the fastest convert kernel of this cpu
+ * @return convert kernel
+ * @note   the cpu is probed once, later calls only load the detected kernel
+ */
+static adxl345_convert_kernel_t a_adxl345_convert_detect(void)
+{
+    adxl345_convert_kernel_t kernel;
+    uint8_t detected;
+    
+    detected = ADXL345_CONVERT_LOAD(&gs_convert_kernel_detected);                    /* load kernel */
+    if (detected != 0xFF)                                                            /* if detected */
+    {
+        return (adxl345_convert_kernel_t)(detected);                                 /* return kernel */
+    }
+    for (kernel = ADXL345_CONVERT_KERNEL_NEON; kernel > ADXL345_CONVERT_KERNEL_SCALAR;
+         kernel = (adxl345_convert_kernel_t)(kernel - 1))                            /* find the best kernel */
+    {
+        if (a_adxl345_convert_supported(kernel) != 0)                                /* if supported */
+        {
+            break;                                                                   /* break */
+        }
+    }
+    ADXL345_CONVERT_STORE(&gs_convert_kernel_detected, (uint8_t)kernel);             /* store kernel */
+    
+    return kernel;                                                                   /* return kernel */
+}
+
+/**
+ * @brief     read the irq frame of 0x30 - 0x39
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      the burst clears the interrupt source and pops one fifo entry,
+ *            in fifo mode the entry is kept in the frame until the next data read consumes it,
+ *            while an entry is kept only 0x30 - 0x31 and 0x38 - 0x39 are read so it is never overwritten
+ */
+static uint8_t a_adxl345_irq_frame_read(adxl345_handle_t *handle)
+{
+    uint8_t buf[10];
+    uint8_t level;
+    
+    if (handle->irq_frame.pending != 0)                                                                   /* if an entry is kept */
+    {
+        if (a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_SOURCE, &buf[0], 2) != 0)                      /* read 0x30 - 0x31 */
+        {
+            return 1;                                                                                     /* return error */
+        }
+        if (a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_CTL,
+                                   &buf[ADXL345_REG_FIFO_CTL - ADXL345_REG_INT_SOURCE], 2) != 0)          /* read 0x38 - 0x39 */
+        {
+            return 1;                                                                                     /* return error */
+        }
+    }
+    else
+    {
+        if (a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_SOURCE, buf, 10) != 0)                         /* read 0x30 - 0x39 */
+        {
+            return 1;                                                                                     /* return error */
+        }
+    }
+    handle->irq_frame.timestamp_us = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;         /* get timestamp */
+    handle->irq_frame.source = buf[ADXL345_REG_INT_SOURCE - ADXL345_REG_INT_SOURCE];                      /* get source */
+    handle->irq_frame.format = buf[ADXL345_REG_DATA_FORMAT - ADXL345_REG_INT_SOURCE] & 0x0F;              /* get format */
+    handle->irq_frame.mode = buf[ADXL345_REG_FIFO_CTL - ADXL345_REG_INT_SOURCE] >> 6;                     /* get mode */
+    handle->irq_frame.trigger = (buf[ADXL345_REG_FIFO_STATUS - ADXL345_REG_INT_SOURCE] >> 7) & 0x01;      /* get trigger */
+    level = buf[ADXL345_REG_FIFO_STATUS - ADXL345_REG_INT_SOURCE] & 0x3F;                                 /* get fifo level */
+    if (handle->irq_frame.pending != 0)                                                                   /* if an entry is kept */
+    {
+        handle->irq_frame.fifo_level = (uint8_t)(level + 1);                                              /* count the kept entry */
+    }
+    else
+    {
+        /* the fifo status of the burst is read right after datax0 - dataz1 popped an entry, within 5us it is */
+        /* not guaranteed to be updated, it is taken as the level before the pop, if it leaves no remainder */
+        /* the status is read again after 5us when it is the level after the pop, so no entry is left behind */
+        if ((level <= 1) && ((buf[ADXL345_REG_FIFO_CTL - ADXL345_REG_INT_SOURCE] >> 6) != ADXL345_MODE_BYPASS))
+        {
+            if (handle->delay_us != NULL)                                                                 /* if delay */
+            {
+                handle->delay_us(5);                                                                      /* wait 5us */
+            }
+            if (a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_STATUS,
+                                       &buf[ADXL345_REG_FIFO_STATUS - ADXL345_REG_INT_SOURCE], 1) != 0)   /* read fifo status again */
+            {
+                return 1;                                                                                 /* return error */
+            }
+            if ((buf[ADXL345_REG_FIFO_STATUS - ADXL345_REG_INT_SOURCE] & 0x3F) != 0)                      /* if entries remain */
+            {
+                level = (uint8_t)((buf[ADXL345_REG_FIFO_STATUS - ADXL345_REG_INT_SOURCE] & 0x3F) + 1);    /* count the popped entry */
+            }
+            handle->irq_frame.trigger = (buf[ADXL345_REG_FIFO_STATUS - ADXL345_REG_INT_SOURCE] >> 7) & 0x01;    /* get trigger */
+        }
+        handle->irq_frame.fifo_level = level;                                                             /* set fifo level */
+        memcpy(handle->irq_frame.sample, &buf[ADXL345_REG_DATAX0 - ADXL345_REG_INT_SOURCE], 6);           /* get sample */
+        handle->irq_frame.pending = (uint8_t)((handle->irq_frame.mode != ADXL345_MODE_BYPASS) &&
+                                              (handle->irq_frame.fifo_level != 0));                       /* flag pending if an entry was popped */
+    }
+    a_adxl345_cache_update(handle, ADXL345_REG_DATA_FORMAT,
+                           &buf[ADXL345_REG_DATA_FORMAT - ADXL345_REG_INT_SOURCE], 1);                    /* refresh data format */
+    a_adxl345_cache_update(handle, ADXL345_REG_FIFO_CTL,
+                           &buf[ADXL345_REG_FIFO_CTL - ADXL345_REG_INT_SOURCE], 1);                       /* refresh fifo ctl */
+    
+    return 0;                                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      read the interrupt event context
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *event points to a event structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       in burst mode act tap status is read only for tap and activity events,
+ *             otherwise 0x2B - 0x30 is read in one transaction and fifo status only for fifo events
+ */
+static uint8_t a_adxl345_event_read(adxl345_handle_t *handle, adxl345_event_t *event)
+{
+    uint8_t buf[6];
+    const uint8_t act_tap = (1 << ADXL345_INTERRUPT_SINGLE_TAP) | (1 << ADXL345_INTERRUPT_DOUBLE_TAP) |
+                            (1 << ADXL345_INTERRUPT_ACTIVITY) | (1 << ADXL345_INTERRUPT_INACTIVITY);
+    const uint8_t fifo = (1 << ADXL345_INTERRUPT_WATERMARK) | (1 << ADXL345_INTERRUPT_OVERRUN);
+    
+    memset(event, 0, sizeof(adxl345_event_t));                                                          /* clear the event */
+    event->handle = handle;                                                                             /* set handle */
+    if (handle->irq_burst != 0)                                                                         /* if burst mode */
+    {
+        if (a_adxl345_irq_frame_read(handle) != 0)                                                      /* read irq frame */
+        {
+            return 1;                                                                                   /* return error */
+        }
+        event->source = handle->irq_frame.source;                                                       /* get source */
+        event->fifo_level = handle->irq_frame.fifo_level;                                               /* get fifo level */
+        event->trigger = handle->irq_frame.trigger;                                                     /* get trigger */
+        if ((event->source & act_tap) != 0)                                                             /* if tap or activity */
+        {
+            if (a_adxl345_iic_spi_read(handle, ADXL345_REG_ACT_TAP_STATUS, buf, 1) != 0)                /* read act tap status */
+            {
+                return 1;                                                                               /* return error */
+            }
+            event->action_tap_status = buf[0];                                                          /* get act tap status */
+        }
+        
+        return 0;                                                                                       /* success return 0 */
+    }
+    
+    if (a_adxl345_iic_spi_read(handle, ADXL345_REG_ACT_TAP_STATUS, buf, 6) != 0)                        /* read 0x2B - 0x30 */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    event->action_tap_status = buf[ADXL345_REG_ACT_TAP_STATUS - ADXL345_REG_ACT_TAP_STATUS];            /* get act tap status */
+    event->source = buf[ADXL345_REG_INT_SOURCE - ADXL345_REG_ACT_TAP_STATUS];                           /* get source */
+    if ((event->source & fifo) != 0)                                                                    /* if fifo event */
+    {
+        if (a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_STATUS, buf, 1) != 0)                       /* read fifo status */
+        {
+            return 1;                                                                                   /* return error */
+        }
+        event->fifo_level = buf[0] & 0x3F;                                                              /* get fifo level */
+        event->trigger = (buf[0] >> 7) & 0x01;                                                          /* get trigger */
+    }
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     record a fifo level observation
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] timestamp_us is the observation time
+ * @param[in] level is the observed fifo level
+ * @note      none
+ */
+static void a_adxl345_fifo_observe(adxl345_handle_t *handle, uint64_t timestamp_us, uint8_t level)
+{
+    handle->timing.anchor_us = timestamp_us;                                  /* set anchor */
+    handle->timing.level = level;                                             /* set level */
+    handle->timing.anchor_consumed = handle->timing.consumed;                 /* samples read before */
+    if (handle->stats == NULL)                                                /* if no stats */
+    {
+        return;                                                               /* return */
+    }
+    if (level > handle->stats->fifo_high_water)                               /* if higher */
+    {
+        handle->stats->fifo_high_water = level;                               /* set high water */
+    }
+    if (level >= 32)                                                          /* if full */
+    {
+        handle->stats->full_drains++;                                         /* count full drain */
+        handle->stats->full_drain_run++;                                      /* extend the run */
+        if (handle->stats->full_drain_run > handle->stats->full_drain_run_max)
+        {
+            handle->stats->full_drain_run_max = handle->stats->full_drain_run;      /* set longest run */
+        }
+    }
+    else
+    {
+        handle->stats->full_drain_run = 0;                                    /* end the run */
+    }
+}
+
+/**
+ * @brief     count the delivered samples
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] len is the sample number
+ * @note      none
+ */
+static inline void a_adxl345_count_samples(adxl345_handle_t *handle, uint16_t len)
+{
+    handle->timing.consumed += len;             /* count consumed */
+    if (handle->stats != NULL)                  /* if stats */
+    {
+        handle->stats->samples += len;          /* count samples */
+    }
+}
+
+/**
+ * @brief      pop the fifo entries with one transfer call
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] **frame points to a frame slot array
+ * @param[in]  first is the first slot
+ * @param[in]  size is the slot number
+ * @param[in]  cnt is the entry number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       cnt <= 33, the slot index wraps at size
+ */
+static uint8_t a_adxl345_fifo_pop_vectored(adxl345_handle_t *handle, uint8_t (*frame)[6],
+                                           uint16_t first, uint16_t size, uint16_t cnt)
+{
+    uint16_t i;
+    adxl345_transfer_t xfer[33];
+    
+    for (i = 0; i < cnt; i++)                                                                     /* set all segments */
+    {
+        xfer[i].reg = ADXL345_REG_DATAX0;                                                         /* set data register */
+        xfer[i].rw = ADXL345_TRANSFER_READ;                                                       /* read */
+        xfer[i].len = 6;                                                                          /* one entry */
+        xfer[i].buf = frame[(first + i) % size];                                                  /* set buffer */
+        xfer[i].delay_us = 5;                                                                     /* datasheet fifo spacing */
+    }
+    
+    return a_adxl345_transfer(handle, xfer, cnt);                                                 /* pop all entries */
+}
+
+/**
+ * @brief         pop the fifo entries
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **frame points to a frame slot array
+ * @param[in]     first is the first slot
+ * @param[in]     size is the slot number
+ * @param[in,out] *len points to a length buffer
+ * @param[in]     status is the fifo status already read, 0xFF reads it
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          each entry is popped by an individual 6 bytes read of the data registers
+ *                and the datasheet 5us spacing is kept with delay_us if it is linked,
+ *                the slot index wraps at size, len is the popped entry number even if the read failed
+ */
+static uint8_t a_adxl345_fifo_pop(adxl345_handle_t *handle, uint8_t (*frame)[6],
+                                  uint16_t first, uint16_t size, uint16_t *len, uint8_t status)
+{
+    uint8_t res, prev;
+    uint16_t i, cnt, start;
+    
+    if (((*len) != 0) && (handle->irq_frame.pending != 0))                                        /* if the irq frame holds a sample */
+    {
+        memcpy(frame[first % size], handle->irq_frame.sample, 6);                                 /* take the irq sample */
+        handle->irq_frame.pending = 0;                                                            /* flag consumed */
+        start = 1;                                                                                /* one sample in hand */
+        prev = (handle->irq_frame.fifo_level != 0) ? (handle->irq_frame.fifo_level - 1) : 0;      /* remaining entries */
+        a_adxl345_fifo_observe(handle, handle->irq_frame.timestamp_us,
+                               handle->irq_frame.fifo_level);                                     /* observed with the frame */
+    }
+    else if (status != 0xFF)                                                                      /* if the status is known */
+    {
+        start = 0;                                                                                /* no sample in hand */
+        prev = status;                                                                            /* use the status */
+        a_adxl345_fifo_observe(handle, (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0,
+                               prev & 0x3F);                                                      /* observed now */
+    }
+    else
+    {
+        start = 0;                                                                                /* no sample in hand */
+        res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_STATUS, (uint8_t *)&prev, 1);       /* read fifo status */
+        if (res != 0)                                                                             /* check result */
+        {
+            handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+            *len = 0;                                                                             /* set length 0 */
+            
+            return 1;                                                                             /* return error */
+        }
+        a_adxl345_fifo_observe(handle, (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0,
+                               prev & 0x3F);                                                      /* observed now */
+    }
+    first = (uint16_t)((first + start) % size);                                                   /* skip the irq sample */
+    cnt = prev & 0x3F;                                                                            /* get cnt */
+    cnt = ((*len - start) < cnt) ? (*len - start) : cnt;                                          /* get min cnt */
+    cnt = (cnt < (33 - start)) ? cnt : (33 - start);                                              /* 32 fifo entries and the output registers */
+    if (((handle->iic_spi == ADXL345_INTERFACE_IIC) && (handle->iic_transfer != NULL)) ||
+        ((handle->iic_spi == ADXL345_INTERFACE_SPI) && (handle->spi_transfer != NULL)))           /* if transfer is linked */
+    {
+        if ((cnt != 0) && (a_adxl345_fifo_pop_vectored(handle, frame, first, size, cnt) != 0))    /* pop all entries in one call */
+        {
+            handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+            *len = start;                                                                         /* set length */
+            a_adxl345_count_samples(handle, *len);                                                /* count samples */
+            
+            return 1;                                                                             /* return error */
+        }
+        *len = start + cnt;                                                                       /* set length */
+        a_adxl345_count_samples(handle, *len);                                                    /* count samples */
+        
+        return 0;                                                                                 /* success return 0 */
+    }
+    for (i = 0; i < cnt; i++)                                                                     /* pop all entries */
+    {
+        if ((i != 0) && (handle->delay_us != NULL))                                               /* if not the first entry */
+        {
+            handle->delay_us(5);                                                                  /* wait 5us */
+        }
+        res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATAX0, frame[(first + i) % size], 6);   /* pop one entry */
+        if (res != 0)                                                                             /* check result */
+        {
+            handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
+            *len = start + i;                                                                     /* set popped length */
+            a_adxl345_count_samples(handle, *len);                                                /* count samples */
+            
+            return 1;                                                                             /* return error */
+        }
+    }
+    if ((cnt != 0) && (handle->delay_us != NULL))                                                 /* if popped */
+    {
+        handle->delay_us(5);                                                                      /* wait 5us before next status read */
+    }
+    *len = start + cnt;                                                                           /* set length */
+    a_adxl345_count_samples(handle, *len);                                                        /* count samples */
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief         read the data register frames with a known fifo mode
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[in]     *session points to a session structure holding the fifo mode
+ * @param[out]    *buf points to a frame buffer of 33 * 6 bytes
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          only the fifo status and data registers are accessed,
+ *                len is the read frame number even if the read failed
+ */
+static uint8_t a_adxl345_read_frames(adxl345_handle_t *handle, adxl345_session_t *session,
+                                     uint8_t *buf, uint16_t *len)
+{
+    if (session->mode != ADXL345_MODE_BYPASS)                                                     /* fifo mode */
+    {
+        return a_adxl345_fifo_pop(handle, (uint8_t (*)[6])buf, 0, 33, len, 0xFF);                 /* pop fifo */
+    }
+    handle->timing.level = 0xFF;                                                                  /* no fifo level in bypass mode */
+    if (a_adxl345_iic_spi_read(handle, ADXL345_REG_DATAX0, buf, 6) != 0)                          /* read data */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
+        *len = 0;                                                                                 /* set length 0 */
+       
+        return 1;                                                                                 /* return error */
+    }
+    handle->timing.anchor_us = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;       /* observed now */
+    *len = 1;                                                                                     /* set length 1 */
+    a_adxl345_count_samples(handle, 1);                                                           /* count samples */
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      drain the fifo into the ring
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[in]  status is the fifo status already read, 0xFF reads it
+ * @param[out] *drained points to a drained frame number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 drain failed
+ * @note       the entries are popped straight into the ring slots,
+ *             the oldest frames are overwritten when the ring is full,
+ *             the stored frames are flushed when the data format changed since they were drained
+ */
+static uint8_t a_adxl345_ring_drain(adxl345_handle_t *handle, uint8_t status, uint16_t *drained)
+{
+    uint8_t res, prev, format;
+    uint16_t len, over;
+    adxl345_ring_t *ring = handle->ring;
+    
+    if (handle->irq_frame.pending != 0)                                                           /* if the irq frame is in hand */
+    {
+        format = handle->irq_frame.format;                                                        /* get format */
+    }
+    else if (handle->session.prepared != 0)                                                       /* if session is prepared */
+    {
+        format = handle->session.format;                                                          /* get format */
+    }
+    else
+    {
+        res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);         /* read config */
+        if (res != 0)                                                                             /* check result */
+        {
+            *drained = 0;                                                                         /* set drained 0 */
+            
+            return 1;                                                                             /* return error */
+        }
+        format = prev & 0x0F;                                                                     /* get format */
+    }
+    if ((ring->count != 0) && (format != ring->format))                                           /* if the data format changed */
+    {
+        ring->flushed += ring->count;                                                             /* count flushed */
+        ring->tail = ring->head;                                                                  /* drop the stored frames */
+        ring->count = 0;                                                                          /* clear count */
+    }
+    ring->format = format;                                                                        /* set format */
+    len = (ring->size < 33) ? ring->size : 33;                                                    /* limit to the ring size */
+    res = a_adxl345_fifo_pop(handle, ring->frame, ring->head, ring->size, &len, status);          /* pop into the ring */
+    if ((ring->count + len) > ring->size)                                                         /* if overwritten */
+    {
+        over = (uint16_t)(ring->count + len - ring->size);                                        /* get overwritten number */
+        ring->tail = (uint16_t)((ring->tail + over) % ring->size);                                /* drop the oldest */
+        ring->count = (uint16_t)(ring->count - over);                                             /* update count */
+        ring->overwritten += over;                                                                /* count overwritten */
+    }
+    ring->head = (uint16_t)((ring->head + len) % ring->size);                                     /* update head */
+    ring->count = (uint16_t)(ring->count + len);                                                  /* update count */
+    *drained = len;                                                                               /* set drained */
+    
+    return res;                                                                                   /* return the result */
+}
+
+/**
+ * @brief adxl345 output data rate table definition, indexed by the rate bits
+ */
+static const float gs_rate_hz[16] =
+{
+    0.10f, 0.20f, 0.39f, 0.78f, 1.56f, 3.13f, 6.25f, 12.5f,
+    25.0f, 50.0f, 100.0f, 200.0f, 400.0f, 800.0f, 1600.0f, 3200.0f,
+};
+
+/**
+ * @brief      timestamp the samples of the last read and track the real sample period
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[in]  rate is the bw rate register value
+ * @param[out] *timestamp_us points to a timestamp buffer
+ * @param[in]  len is the sample number
+ * @note       the newest sample in the fifo is taken as produced at the observation time,
+ *             the period is measured over at least 32 samples and filtered with a 1/16 ewma,
+ *             measurements more than 10% off the nominal period or across a full fifo are dropped
+ */
+static void a_adxl345_timing_update(adxl345_handle_t *handle, uint8_t rate, uint64_t *timestamp_us, uint16_t len)
+{
+    uint16_t i;
+    uint32_t generated;
+    int32_t back;
+    float nominal;
+    float period;
+    adxl345_timing_t *timing = &handle->timing;
+    
+    nominal = 1000000.0f / gs_rate_hz[rate & 0x0F];                                                   /* nominal period */
+    if ((timing->valid == 0) || (timing->rate != rate))                                               /* first read or new rate */
+    {
+        timing->period_us = nominal;                                                                  /* start from the nominal period */
+        timing->rate = rate;                                                                          /* set rate */
+        timing->valid = 1;                                                                            /* flag valid */
+        timing->base_valid = 0;                                                                       /* restart the base */
+    }
+    if ((timing->level == 0xFF) || (timing->level >= 32))                                             /* unknown level or samples may be lost */
+    {
+        timing->base_valid = 0;                                                                       /* restart the base */
+    }
+    else
+    {
+        generated = timing->anchor_consumed + timing->level;                                          /* samples generated until the observation */
+        if (timing->base_valid == 0)                                                                  /* if no base */
+        {
+            timing->base_us = timing->anchor_us;                                                      /* set base time */
+            timing->base_generated = generated;                                                       /* set base samples */
+            timing->base_valid = 1;                                                                   /* flag base valid */
+        }
+        else if ((generated - timing->base_generated) >= 32)                                          /* if the base is long enough */
+        {
+            period = (float)(timing->anchor_us - timing->base_us) /
+                     (float)(generated - timing->base_generated);                                     /* measured period */
+            if ((period > nominal * 0.9f) && (period < nominal * 1.1f))                               /* if plausible */
+            {
+                timing->period_us += (period - timing->period_us) / 16.0f;                            /* track the drift */
+            }
+            timing->base_us = timing->anchor_us;                                                      /* move base time */
+            timing->base_generated = generated;                                                       /* move base samples */
+        }
+    }
+    for (i = 0; i < len; i++)                                                                         /* back-fill all samples */
+    {
+        back = (timing->level == 0xFF) ? 0 : ((int32_t)timing->level - 1 - (int32_t)i);               /* periods before the newest */
+        back = (back < 0) ? 0 : back;                                                                 /* never after the observation */
+        timestamp_us[i] = timing->anchor_us - (uint64_t)((float)back * timing->period_us + 0.5f);     /* set timestamp */
+    }
+}
+
+/**
+ * @brief         read and decode the samples with a known data format
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[in]     *session points to a session structure holding the data format
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **g points to a converted data buffer
+ * @param[out]    **mg points to a mg data buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          the frames read before a failure are still decoded
+ */
+static uint8_t a_adxl345_read_samples(adxl345_handle_t *handle, adxl345_session_t *session,
+                                      int16_t (*raw)[3], float (*g)[3], int32_t (*mg)[3], uint16_t *len)
+{
+    uint8_t res;
+    uint8_t buf[33 * 6];
+    
+    res = a_adxl345_read_frames(handle, session, buf, len);                                       /* read frames */
+    a_adxl345_decode(buf, raw, g, mg, *len, session->format);                                     /* decode data */
+    
+    return res;                                                                                   /* return the result */
+}
+
+/**
+ * @brief         read the data with the current fifo mode and data format
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **g points to a converted data buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          none
+ */
+static uint8_t a_adxl345_read_data(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t *len)
+{
+    uint8_t res, prev;
+    adxl345_session_t session;
+    
+    handle->session.transactions = 0;                                                             /* clear transactions */
+    handle->session.bytes = 0;                                                                    /* clear bytes */
+    if (handle->irq_frame.pending != 0)                                                           /* if the irq frame is in hand */
+    {
+        session.mode = handle->irq_frame.mode;                                                    /* get mode */
+        session.full_res = (handle->irq_frame.format >> 3) & 0x01;                                /* get full reselution */
+        session.justify = (handle->irq_frame.format >> 2) & 0x01;                                 /* get justify */
+        session.range = handle->irq_frame.format & 0x03;                                          /* get range */
+        session.format = handle->irq_frame.format;                                                /* get format */
+        
+        return a_adxl345_read_samples(handle, &session, raw, g, NULL, len);                       /* read samples */
+    }
+    res = a_adxl345_cache_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);                /* read config */
+    if (res != 0)                                                                                 /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
+       
+        return 1;                                                                                 /* return error */
+    }
+    session.mode = prev >> 6;                                                                     /* get mode */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);             /* read config */
+    if (res != 0)                                                                                 /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
+       
+        return 1;                                                                                 /* return error */
+    }
+    session.full_res = (prev >> 3) & 0x01;                                                        /* get full reselution */
+    session.justify = (prev >> 2) & 0x01;                                                         /* get justify */
+    session.range = prev & 0x03;                                                                  /* get range */
+    session.format = prev & 0x0F;                                                                 /* get format */
+    
+    return a_adxl345_read_samples(handle, &session, raw, g, NULL, len);                           /* read samples */
+}
+
+/**
+ * @brief     capture the fifo mode and the data format into the read session
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      none
+ */
+static uint8_t a_adxl345_session_prepare(adxl345_handle_t *handle)
+{
+    uint8_t res, prev;
+    
+    handle->session.prepared = 0;                                                                 /* flag not prepared */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);                /* read config */
+    if (res != 0)                                                                                 /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
+       
+        return 1;                                                                                 /* return error */
+    }
+    handle->session.mode = prev >> 6;                                                             /* get mode */
+    res = a_adxl345_cache_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);             /* read config */
+    if (res != 0)                                                                                 /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
+       
+        return 1;                                                                                 /* return error */
+    }
+    handle->session.full_res = (prev >> 3) & 0x01;                                                /* get full reselution */
+    handle->session.justify = (prev >> 2) & 0x01;                                                 /* get justify */
+    handle->session.range = prev & 0x03;                                                          /* get range */
+    handle->session.format = prev & 0x0F;                                                         /* get format */
+    handle->session.prepared = 1;                                                                 /* flag prepared */
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief         read the data
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **g points to a converted data buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 async read is busy
+ * @note          g can be NULL for the raw output only
+ */
+uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t *len) 
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    a_adxl345_lock(handle);                                                                       /* lock */
+    ADXL345_TRACE_API(handle);                                                                    /* tag the api */
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                                          /* check async state */
+    {
+        handle->debug_print("adxl345: async read is busy.\n");                                    /* async read is busy */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
+        
+        return 4;                                                                                 /* return error */
+    }
+    
+    if ((*len) == 0)                                                                              /* check length */
+    {
+        handle->debug_print("adxl345: length is zero.\n");                                        /* length is zero */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
+       
+        return 1;                                                                                 /* return error */
+    }
+    
+    res = a_adxl345_read_data(handle, raw, g, len);                                               /* read data */
+    a_adxl345_unlock(handle);                                                                     /* unlock */
+    
+    return res;                                                                                   /* return the result */
+}
+
+/**
+ * @brief     prepare the read session
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the fifo mode and the data format are captured once and tracked
+ *            by the driver setters, so adxl345_read_session only accesses the data registers
+ */
+uint8_t adxl345_read_prepare(adxl345_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    a_adxl345_lock(handle);                                                                       /* lock */
+    ADXL345_TRACE_API(handle);                                                                    /* tag the api */
+    
+    res = a_adxl345_session_prepare(handle);                                                      /* prepare */
+    a_adxl345_unlock(handle);                                                                     /* unlock */
+    
+    return res;                                                                                   /* return the result */
+}
+
+/**
+ * @brief         read the data with the prepared session
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **g points to a converted data buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 async read is busy
+ * @note          the session is prepared automatically if needed,
+ *                g can be NULL for the raw output only
+ */
+uint8_t adxl345_read_session(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t *len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    a_adxl345_lock(handle);                                                                       /* lock */
+    ADXL345_TRACE_API(handle);                                                                    /* tag the api */
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                                          /* check async state */
+    {
+        handle->debug_print("adxl345: async read is busy.\n");                                    /* async read is busy */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
+        
+        return 4;                                                                                 /* return error */
+    }
+    
+    if ((*len) == 0)                                                                              /* check length */
+    {
+        handle->debug_print("adxl345: length is zero.\n");                                        /* length is zero */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
+       
+        return 1;                                                                                 /* return error */
+    }
+    handle->session.transactions = 0;                                                             /* clear transactions */
+    handle->session.bytes = 0;                                                                    /* clear bytes */
+    if (handle->session.prepared == 0)                                                            /* if not prepared */
+    {
+        res = a_adxl345_session_prepare(handle);                                                  /* prepare */
+        if (res != 0)                                                                             /* check result */
+        {
+            a_adxl345_unlock(handle);                                                             /* unlock */
+            return 1;                                                                             /* return error */
+        }
+    }
+    
+    res = a_adxl345_read_samples(handle, &handle->session, raw, g, NULL, len);                    /* read samples */
+    a_adxl345_unlock(handle);                                                                     /* unlock */
+    
+    return res;                                                                                   /* return the result */
+}
+
+/**
+ * @brief         read the data in mg
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **mg points to a mg data buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 async read is busy
+ * @note          uses the prepared session and integer arithmetic only,
+ *                mg is the float result of adxl345_read multiplied by 1000 and rounded half away from zero
+ */
+uint8_t adxl345_read_mg(adxl345_handle_t *handle, int16_t (*raw)[3], int32_t (*mg)[3], uint16_t *len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    a_adxl345_lock(handle);                                                                       /* lock */
+    ADXL345_TRACE_API(handle);                                                                    /* tag the api */
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                                          /* check async state */
+    {
+        handle->debug_print("adxl345: async read is busy.\n");                                    /* async read is busy */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
+        
+        return 4;                                                                                 /* return error */
+    }
+    
+    if ((*len) == 0)                                                                              /* check length */
+    {
+        handle->debug_print("adxl345: length is zero.\n");                                        /* length is zero */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
+       
+        return 1;                                                                                 /* return error */
+    }
+    handle->session.transactions = 0;                                                             /* clear transactions */
+    handle->session.bytes = 0;                                                                    /* clear bytes */
+    if (handle->session.prepared == 0)                                                            /* if not prepared */
+    {
+        res = a_adxl345_session_prepare(handle);                                                  /* prepare */
+        if (res != 0)                                                                             /* check result */
+        {
+            a_adxl345_unlock(handle);                                                             /* unlock */
+            return 1;                                                                             /* return error */
+        }
+    }
+    
+    res = a_adxl345_read_samples(handle, &handle->session, raw, NULL, mg, len);                  /* read samples */
+    a_adxl345_unlock(handle);                                                                    /* unlock */
+    
+    return res;                                                                                  /* return the result */
+}
+
+/**
+ * @brief      decode the data register frames
+ * @param[in]  data_format is the data format register value
+ * @param[in]  *buf points to a frame buffer of 6 bytes per sample
+ * @param[out] **raw points to a raw data buffer
+ * @param[out] **g points to a converted data buffer
+ * @param[out] **mg points to a mg data buffer
+ * @param[in]  len is the sample number
+ * @return     status code
+ *             - 0 success
+ *             - 2 buf or raw is NULL
+ * @note       g and mg can be NULL
+ */
+uint8_t adxl345_decode(uint8_t data_format, uint8_t *buf, int16_t (*raw)[3], float (*g)[3], int32_t (*mg)[3], uint16_t len)
+{
+    if ((buf == NULL) || (raw == NULL))                           /* check buffer */
+    {
+        return 2;                                                 /* return error */
+    }
+    
+    a_adxl345_decode(buf, raw, g, mg, len, data_format);          /* decode data */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief      decode the data register frames into per axis arrays
+ * @param[in]  data_format is the data format register value
+ * @param[in]  *buf points to a frame buffer of 6 bytes per sample
+ * @param[out] *x points to a x axis g buffer
+ * @param[out] *y points to a y axis g buffer
+ * @param[out] *z points to a z axis g buffer
+ * @param[in]  stride is the element distance between two samples in each axis buffer
+ * @param[in]  len is the sample number
+ * @return     status code
+ *             - 0 success
+ *             - 2 buf or axis buffer is NULL
+ * @note       stride 0 is the same as stride 1
+ */
+uint8_t adxl345_decode_soa(uint8_t data_format, uint8_t *buf, float *x, float *y, float *z, uint16_t stride, uint16_t len)
+{
+    const a_adxl345_decoder_t *decoder;
+    
+    if ((buf == NULL) || (x == NULL) || (y == NULL) || (z == NULL))         /* check buffer */
+    {
+        return 2;                                                           /* return error */
+    }
+    
+    decoder = &gs_decoder[data_format & 0x0F];                              /* get decoder */
+    decoder->kernel_soa(buf, x, y, z, (stride == 0) ? 1 : stride,
+                        len, decoder->scale);                               /* decode data */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief         read the data into per axis arrays
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    *x points to a x axis g buffer
+ * @param[out]    *y points to a y axis g buffer
+ * @param[out]    *z points to a z axis g buffer
+ * @param[in]     stride is the element distance between two samples in each axis buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 async read is busy
+ * @note          uses the prepared session, stride 0 is the same as stride 1
+ */
+uint8_t adxl345_read_soa(adxl345_handle_t *handle, float *x, float *y, float *z, uint16_t stride, uint16_t *len)
+{
+    uint8_t res;
+    uint8_t buf[33 * 6];
+    const a_adxl345_decoder_t *decoder;
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    a_adxl345_lock(handle);                                                                       /* lock */
+    ADXL345_TRACE_API(handle);                                                                    /* tag the api */
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                                          /* check async state */
+    {
+        handle->debug_print("adxl345: async read is busy.\n");                                    /* async read is busy */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
+        
+        return 4;                                                                                 /* return error */
+    }
+    
+    if ((*len) == 0)                                                                              /* check length */
+    {
+        handle->debug_print("adxl345: length is zero.\n");                                        /* length is zero */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
+       
+        return 1;                                                                                 /* return error */
+    }
+    handle->session.transactions = 0;                                                             /* clear transactions */
+    handle->session.bytes = 0;                                                                    /* clear bytes */
+    if (handle->session.prepared == 0)                                                            /* if not prepared */
+    {
+        res = a_adxl345_session_prepare(handle);                                                  /* prepare */
+        if (res != 0)                                                                             /* check result */
+        {
+            a_adxl345_unlock(handle);                                                             /* unlock */
+            return 1;                                                                             /* return error */
+        }
+    }
+    
+    res = a_adxl345_read_frames(handle, &handle->session, buf, len);                              /* read frames */
+    decoder = &gs_decoder[handle->session.format & 0x0F];                                         /* get decoder */
+    decoder->kernel_soa(buf, x, y, z, (stride == 0) ? 1 : stride, *len, decoder->scale);          /* decode data */
+    a_adxl345_unlock(handle);                                                                     /* unlock */
+    
+    return res;                                                                                   /* return the result */
+}
+
+/**
+ * @brief      convert the data register frames in a batch
+ * @param[in]  kernel is the convert kernel
+ * @param[in]  data_format is the data format register value
+ * @param[in]  *buf points to a frame buffer of 6 bytes per sample
+ * @param[out] **g points to a converted data buffer
+ * @param[out] **mg points to a mg data buffer
+ * @param[in]  len is the sample number
+ * @return     status code
+ *             - 0 success
+ *             - 1 no output is requested
+ *             - 2 buf is NULL
+ *             - 3 kernel is not supported
+ * @note       g or mg can be NULL, ADXL345_CONVERT_KERNEL_AUTO picks the fastest kernel of the cpu,
+ *             all kernels give bit exact results
+ */
+uint8_t adxl345_convert_batch(adxl345_convert_kernel_t kernel, uint8_t data_format, uint8_t *buf,
+                              float (*g)[3], int32_t (*mg)[3], uint32_t len)
+{
+    if (buf == NULL)                                                                     /* check buffer */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if ((g == NULL) && (mg == NULL))                                                     /* check output */
+    {
+        return 1;                                                                        /* return error */
+    }
+    if (kernel == ADXL345_CONVERT_KERNEL_AUTO)                                           /* if auto */
+    {
+        kernel = a_adxl345_convert_detect();                                             /* detect kernel */
+    }
+    else if (a_adxl345_convert_supported(kernel) == 0)                                   /* check kernel */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    gs_convert_kernel[kernel](buf, (float *)g, (int32_t *)mg, len * 3,
+                              &gs_decoder[data_format & 0x0F],
+                              gs_convert_shift[data_format & 0x0F]);                     /* convert */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     check whether a batch convert kernel runs on this cpu
+ * @param[in] kernel is the convert kernel
+ * @return    status code
+ *            - 0 supported
+ *            - 1 kernel is not supported
+ * @note      none
+ */
+uint8_t adxl345_check_convert_kernel(adxl345_convert_kernel_t kernel)
+{
+    if (a_adxl345_convert_supported(kernel) == 0)                   /* check kernel */
+    {
+        return 1;                                                   /* return error */
+    }
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the batch convert kernel picked by ADXL345_CONVERT_KERNEL_AUTO
+ * @param[out] *kernel points to a convert kernel buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the cpu is probed once and the result is shared by all handles and threads
+ */
+uint8_t adxl345_get_convert_kernel(adxl345_convert_kernel_t *kernel)
+{
+    *kernel = a_adxl345_convert_detect();                   /* get kernel */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the bus cost of the last read
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *transactions points to a bus transactions buffer
+ * @param[out] *bytes points to a bus bytes buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       the cost of the last read or fifo drain call,
+ *             bytes include the register address byte of each transaction
+ */
+uint8_t adxl345_get_read_cost(adxl345_handle_t *handle, uint16_t *transactions, uint16_t *bytes)
+{
+    if (handle == NULL)                                         /* check handle */
+    {
+        return 2;                                               /* return error */
+    }
+    
+    *transactions = handle->session.transactions;               /* get transactions */
+    *bytes = handle->session.bytes;                             /* get bytes */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief         read the data with a timestamp for every sample
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **g points to a converted data buffer
+ * @param[out]    *timestamp_us points to a timestamp buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 timestamp_us is NULL
+ *                - 5 async read is busy
+ * @note          the newest sample is anchored at the fifo level observation time
+ *                and the older ones are back-filled with the estimated sample period
+ */
+uint8_t adxl345_read_timestamp(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
+                               uint64_t *timestamp_us, uint16_t *len)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    a_adxl345_lock(handle);                                                              /* lock */
+    ADXL345_TRACE_API(handle);                                                           /* tag the api */
+    if (handle->timestamp_us == NULL)                                                    /* check timestamp_us */
+    {
+        handle->debug_print("adxl345: timestamp_us is null.\n");                         /* timestamp_us is null */
+        a_adxl345_unlock(handle);                                                        /* unlock */
+        
+        return 4;                                                                        /* return error */
+    }
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                                 /* check async state */
+    {
+        handle->debug_print("adxl345: async read is busy.\n");                           /* async read is busy */
+        a_adxl345_unlock(handle);                                                        /* unlock */
+        
+        return 5;                                                                        /* return error */
+    }
+    
+    if ((*len) == 0)                                                                     /* check length */
+    {
+        handle->debug_print("adxl345: length is zero.\n");                               /* length is zero */
+        a_adxl345_unlock(handle);                                                        /* unlock */
+        
+        return 1;                                                                        /* return error */
+    }
+    res = a_adxl345_read_data(handle, raw, g, len);                                      /* read data */
+    if (res != 0)                                                                        /* check result */
+    {
+        a_adxl345_unlock(handle);                                                        /* unlock */
+        return 1;                                                                        /* return error */
+    }
+    res = a_adxl345_cache_read(handle, ADXL345_REG_BW_RATE, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                        /* check result */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                  /* read failed */
+        a_adxl345_unlock(handle);                                                        /* unlock */
+        
+        return 1;                                                                        /* return error */
+    }
+    a_adxl345_timing_update(handle, prev & 0x1F, timestamp_us, *len);                    /* timestamp samples */
+    a_adxl345_unlock(handle);                                                            /* unlock */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the estimated output data rate
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *hz points to a rate buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 no estimate yet
+ * @note       the estimate tracks the real rate from the timestamped reads
+ */
+uint8_t adxl345_get_estimated_rate(adxl345_handle_t *handle, float *hz)
 {
-    if (handle->iic_spi == ADXL345_INTERFACE_IIC)                        /* iic interface */
+    if (handle == NULL)                                                    /* check handle */
     {
-        if (handle->iic_deinit() != 0)                                   /* iic deinit */
-        {
-            handle->debug_print("adxl345: iic deinit failed.\n");        /* iic deinit failed */
-       
-            return 1;                                                    /* return error */
-        }
-        else
-        {
-            return 0;                                                    /* success return 0 */
-        }
+        return 2;                                                          /* return error */
     }
-    else                                                                 /* spi interface */
+    
+    a_adxl345_lock(handle);                                                /* lock */
+    if (handle->timing.valid == 0)                                         /* check estimate */
     {
-        if (handle->spi_deinit() != 0)                                   /* spi deinit */
-        {
-            handle->debug_print("adxl345: spi deinit failed.\n");        /* spi deinit failed */
-       
-            return 1;                                                    /* return error */
-        }
-        else
-        {
-            return 0;                                                    /* success return 0 */
-        }
+        handle->debug_print("adxl345: no estimate yet.\n");                /* no estimate yet */
+        a_adxl345_unlock(handle);                                          /* unlock */
+        
+        return 4;                                                          /* return error */
     }
+    *hz = 1000000.0f / handle->timing.period_us;                           /* get rate */
+    a_adxl345_unlock(handle);                                              /* unlock */
+    
+    return 0;                                                              /* success return 0 */
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     start one async read
  * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
  * @return    status code
  *            - 0 success
- *            - 1 spi or iic initialization failed
- *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 id is invalid
- * @note      none
+ *            - 1 read failed
+ * @note      the transaction is counted when it is started, it is not traced
  */
-uint8_t adxl345_init(adxl345_handle_t *handle)
+static uint8_t a_adxl345_async_start(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    uint8_t id;
-  
-    if (handle == NULL)                                                             /* check handle */
+    uint8_t res;
+    
+    handle->session.transactions++;                                                /* count transaction */
+    handle->session.bytes += len + 1;                                              /* count bytes */
+    if (handle->stats != NULL)                                                     /* if stats */
     {
-        return 2;                                                                   /* return error */
+        handle->stats->read_transactions++;                                        /* count transaction */
+        handle->stats->read_bytes += len;                                          /* count bytes */
     }
-    if (handle->debug_print == NULL)                                                /* check debug_print */
+    if (handle->iic_spi == ADXL345_INTERFACE_IIC)                                  /* iic interface */
     {
-        return 3;                                                                   /* return error */
+        res = handle->iic_read_async(handle->iic_addr, reg, buf, len, handle);     /* start read */
     }
-    if (handle->iic_init == NULL)                                                   /* check iic_init */
+    else                                                                           /* spi interface */
     {
-        handle->debug_print("adxl345: iic_init is null.\n");                        /* iic_init is null */
-       
-        return 3;                                                                   /* return error */
+        if (len > 1)                                                               /* if length > 1 */
+        {
+            reg |= 1 << 6;                                                         /* flag length > 1 */
+        }
+        reg |= 1 << 7;                                                             /* flag read */
+        
+        res = handle->spi_read_async(reg, buf, len, handle);                       /* start read */
     }
-    if (handle->iic_deinit == NULL)                                                 /* check iic_deinit */
+    if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("adxl345: iic_deinit is null.\n");                      /* iic_deinit is null */
-       
-        return 3;                                                                   /* return error */
+        a_adxl345_stats_error(handle);                                             /* count error */
+        
+        return 1;                                                                  /* return error */
     }
-    if (handle->iic_read == NULL)                                                   /* check iic_read */
-    {
-        handle->debug_print("adxl345: iic_read is null.\n");                        /* iic_read is null */
-       
-        return 3;                                                                   /* return error */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     finish the async read and run the callback
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] res is the read result
+ * @note      it is entered locked and releases the lock before the callback,
+ *            an irq deferred while the read was in flight runs after the callback
+ */
+static void a_adxl345_async_finish(adxl345_handle_t *handle, uint8_t res)
+{
+    uint8_t deferred;
+    uint16_t len;
+    int16_t (*raw)[3];
+    float (*g)[3];
+    void (*callback)(adxl345_handle_t *handle, uint8_t res, int16_t (*raw)[3], float (*g)[3], uint16_t len);
+    
+    len = handle->async.done;                                                         /* get read length */
+    raw = handle->async.raw;                                                          /* get raw buffer */
+    g = handle->async.g;                                                              /* get g buffer */
+    callback = handle->async.callback;                                                /* get callback */
+    a_adxl345_decode(handle->async.buf, raw, g, NULL, len, handle->async.format);     /* decode data */
+    a_adxl345_count_samples(handle, len);                                             /* count samples */
+    deferred = handle->async.irq_deferred;                                            /* get deferred irq */
+    handle->async.irq_deferred = 0;                                                   /* clear deferred irq */
+    handle->async.state = ADXL345_ASYNC_STATE_IDLE;                                   /* flag idle */
+    a_adxl345_unlock(handle);                                                         /* unlock before the callback */
+    if (callback != NULL)                                                             /* if callback */
+    {
+        callback(handle, res, raw, g, len);                                           /* run callback */
+    }
+    if (deferred != 0)                                                                /* if an irq was deferred */
+    {
+        (void)adxl345_irq_handler(handle);                                            /* run the irq handler */
     }
-    if (handle->iic_write == NULL)                                                  /* check iic_write */
+}
+
+/**
+ * @brief      start an async read
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *buf points to a frame buffer of 6 bytes per sample
+ * @param[out] **raw points to a raw data buffer
+ * @param[out] **g points to a converted data buffer
+ * @param[in]  len is the max sample number
+ * @param[in]  *callback points to a completion callback
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 read async is NULL
+ *             - 5 async read is busy
+ * @note       the buffers must stay valid until the callback runs, g can be NULL for the raw output only,
+ *             buf holds at least min(len, 33) frames, the handle keeps no frame storage of its own,
+ *             in fifo mode the fifo status and every entry are chained reads, one in flight at a time,
+ *             the callback runs before the return if the irq frame sample already completes the read,
+ *             until the callback the other data reads and adxl345_deinit return busy, the irq handler is deferred
+ *             and every other api touching the bus fails
+ */
+uint8_t adxl345_read_async(adxl345_handle_t *handle, uint8_t *buf, int16_t (*raw)[3], float (*g)[3], uint16_t len,
+                           void (*callback)(adxl345_handle_t *handle, uint8_t res,
+                                            int16_t (*raw)[3], float (*g)[3], uint16_t len))
+{
+    uint8_t res;
+    uint16_t cnt;
+    
+    if (handle == NULL)                                                                                            /* check handle */
     {
-        handle->debug_print("adxl345: iic_write is null.\n");                       /* iic_write is null */
-       
-        return 3;                                                                   /* return error */
+        return 2;                                                                                                  /* return error */
     }
-    if (handle->spi_init == NULL)                                                   /* check spi_init */
+    if (handle->inited != 1)                                                                                       /* check handle initialization */
     {
-        handle->debug_print("adxl345: spi_init is null.\n");                        /* spi_init is null */
-       
-        return 3;                                                                   /* return error */
+        return 3;                                                                                                  /* return error */
     }
-    if (handle->spi_deinit == NULL)                                                 /* check spi_deinit */
+    a_adxl345_lock(handle);                                                                                        /* lock */
+    ADXL345_TRACE_API(handle);                                                                                     /* tag the api */
+    
+    if (((handle->iic_spi == ADXL345_INTERFACE_IIC) && (handle->iic_read_async == NULL)) ||
+        ((handle->iic_spi == ADXL345_INTERFACE_SPI) && (handle->spi_read_async == NULL)))                          /* check read async */
     {
-        handle->debug_print("adxl345: spi_deinit is null.\n");                      /* spi_deinit is null */
-       
-        return 3;                                                                   /* return error */
+        handle->debug_print("adxl345: read async is null.\n");                                                     /* read async is null */
+        a_adxl345_unlock(handle);                                                                                  /* unlock */
+        
+        return 4;                                                                                                  /* return error */
     }
-    if (handle->spi_read == NULL)                                                   /* check spi_read */
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                                                           /* check state */
     {
-        handle->debug_print("adxl345: spi_read is null.\n");                        /* spi_read is null */
-       
-        return 3;                                                                   /* return error */
+        handle->debug_print("adxl345: async read is busy.\n");                                                     /* async read is busy */
+        a_adxl345_unlock(handle);                                                                                  /* unlock */
+        
+        return 5;                                                                                                  /* return error */
     }
-    if (handle->spi_write == NULL)                                                  /* check spi_write */
+    if (len == 0)                                                                                                  /* check length */
     {
-        handle->debug_print("adxl345: spi_write is null.\n");                       /* spi_write is null */
-       
-        return 3;                                                                   /* return error */
+        handle->debug_print("adxl345: length is zero.\n");                                                         /* length is zero */
+        a_adxl345_unlock(handle);                                                                                  /* unlock */
+        
+        return 1;                                                                                                  /* return error */
     }
-    if (handle->delay_ms == NULL)                                                   /* check delay_ms */
+    if ((buf == NULL) || (raw == NULL))                                                                            /* check buffer */
     {
-        handle->debug_print("adxl345: delay_ms is null.\n");                        /* delay_ms is null */
-       
-        return 3;                                                                   /* return error */
+        handle->debug_print("adxl345: buffer is null.\n");                                                         /* buffer is null */
+        a_adxl345_unlock(handle);                                                                                  /* unlock */
+        
+        return 1;                                                                                                  /* return error */
     }
-    if (handle->receive_callback == NULL)                                           /* check receive_callback */
+    handle->session.transactions = 0;                                                                              /* clear transactions */
+    handle->session.bytes = 0;                                                                                     /* clear bytes */
+    if (handle->irq_frame.pending != 0)                                                                            /* if the irq frame is in hand */
     {
-        handle->debug_print("adxl345: receive_callback is null.\n");                /* receive_callback is null */
-       
-        return 3;                                                                   /* return error */
+        handle->async.mode = handle->irq_frame.mode;                                                               /* get mode */
+        handle->async.format = handle->irq_frame.format;                                                           /* get format */
     }
-    
-    if (handle->iic_spi == ADXL345_INTERFACE_IIC)                                   /* iic interface */
+    else
     {
-        if (handle->iic_init() != 0)                                                /* initialize iic bus */
+        if (handle->session.prepared == 0)                                                                         /* if not prepared */
         {
-            handle->debug_print("adxl345: iic init failed.\n");                     /* iic init failed */
+            res = a_adxl345_session_prepare(handle);                                                               /* prepare */
+            if (res != 0)                                                                                          /* check result */
+            {
+                a_adxl345_unlock(handle);                                                                          /* unlock */
+                
+                return 1;                                                                                          /* return error */
+            }
+        }
+        handle->async.mode = handle->session.mode;                                                                 /* get mode */
+        handle->async.format = handle->session.format;                                                             /* get format */
+    }
+    handle->async.len = (len < 33) ? len : 33;                                                                     /* 32 fifo entries and the output registers */
+    handle->async.done = 0;                                                                                        /* init 0 */
+    handle->async.buf = buf;                                                                                       /* set frame buffer */
+    handle->async.raw = raw;                                                                                       /* set raw buffer */
+    handle->async.g = g;                                                                                           /* set g buffer */
+    handle->async.callback = callback;                                                                             /* set callback */
+    if (handle->irq_frame.pending != 0)                                                                            /* if the irq frame holds a sample */
+    {
+        memcpy(handle->async.buf, handle->irq_frame.sample, 6);                                                    /* take the irq sample */
+        handle->irq_frame.pending = 0;                                                                             /* flag consumed */
+        handle->async.done = 1;                                                                                    /* one sample in hand */
+        cnt = (handle->irq_frame.fifo_level != 0) ? (handle->irq_frame.fifo_level - 1) : 0;                        /* remaining entries */
+        a_adxl345_fifo_observe(handle, handle->irq_frame.timestamp_us,
+                               handle->irq_frame.fifo_level);                                                      /* observed with the frame */
+        handle->async.cnt = (uint16_t)(1 + (((handle->async.len - 1) < cnt) ? (handle->async.len - 1) : cnt));     /* set total */
+        if (handle->async.done >= handle->async.cnt)                                                               /* if complete */
+        {
+            a_adxl345_async_finish(handle, 0);                                                                     /* finish and unlock */
             
-            return 1;                                                               /* return error */
+            return 0;                                                                                              /* success return 0 */
         }
+        handle->async.state = ADXL345_ASYNC_STATE_DATA;                                                            /* data read next */
+        res = a_adxl345_async_start(handle, ADXL345_REG_DATAX0, &handle->async.buf[6], 6);                         /* pop one entry */
     }
-    else                                                                            /* spi interface */
+    else if (handle->async.mode != ADXL345_MODE_BYPASS)                                                            /* fifo mode */
     {
-        if (handle->spi_init() != 0)                                                /* initialize spi bus */
-        {
-            handle->debug_print("adxl345: spi init failed.\n");                     /* spi init failed */
-           
-            return 1;                                                               /* return error */
-        }
+        handle->async.state = ADXL345_ASYNC_STATE_STATUS;                                                          /* fifo status read next */
+        res = a_adxl345_async_start(handle, ADXL345_REG_FIFO_STATUS, &handle->async.status, 1);                    /* read fifo status */
     }
-    if (a_adxl345_iic_spi_read(handle, ADXL345_REG_DEVID, (uint8_t *)&id, 1) != 0)  /* read id */
+    else
     {
-        handle->debug_print("adxl345: read failed.\n");                             /* read failed */
-        (void)a_adxl345_close(handle);                                              /* close */
-        
-        return 4;                                                                   /* return error */
+        handle->async.cnt = 1;                                                                                     /* one sample in bypass mode */
+        handle->async.state = ADXL345_ASYNC_STATE_DATA;                                                            /* data read next */
+        res = a_adxl345_async_start(handle, ADXL345_REG_DATAX0, handle->async.buf, 6);                             /* read data */
     }
-    if (id != 0xE5)                                                                 /* check id */
+    if (res != 0)                                                                                                  /* check result */
     {
-        handle->debug_print("adxl345: id is invalid.\n");                           /* id is invalid */
-        (void)a_adxl345_close(handle);                                              /* close */
-       
-        return 4;                                                                   /* return error */
+        handle->debug_print("adxl345: read failed.\n");                                                            /* read failed */
+        handle->async.state = ADXL345_ASYNC_STATE_IDLE;                                                            /* flag idle */
+        a_adxl345_unlock(handle);                                                                                  /* unlock */
+        
+        return 1;                                                                                                  /* return error */
     }
-    handle->inited = 1;                                                             /* flag finish initialization */
+    a_adxl345_unlock(handle);                                                                                      /* unlock */
     
-    return 0;                                                                       /* success return 0 */
+    return 0;                                                                                                      /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief     complete the async read in flight
  * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] res is the result of the finished read, 0 means success
  * @return    status code
  *            - 0 success
- *            - 1 iic or spi deinit failed
  *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 power down failed
- * @note      none
+ *            - 4 no async read in flight
+ * @note      called by the platform when a read started by the async hook is done,
+ *            it starts the next chained read or decodes the frames and runs the callback,
+ *            it must not be called from inside the async hook
  */
-uint8_t adxl345_deinit(adxl345_handle_t *handle)
+uint8_t adxl345_async_complete(adxl345_handle_t *handle, uint8_t res)
 {
-    uint8_t res, prev;
+    uint16_t cnt;
+    uint64_t now;
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    a_adxl345_lock(handle);                                                            /* lock */
+    if (handle->async.state == ADXL345_ASYNC_STATE_IDLE)                               /* check state */
     {
-        return 3;                                                                            /* return error */
+        handle->debug_print("adxl345: no async read in flight.\n");                    /* no async read in flight */
+        a_adxl345_unlock(handle);                                                      /* unlock */
+        
+        return 4;                                                                      /* return error */
     }
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                            /* check result */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
-       
-        return 4;                                                                            /* return error */
+        a_adxl345_stats_error(handle);                                                 /* count error */
+        handle->debug_print("adxl345: read failed.\n");                                /* read failed */
+        a_adxl345_async_finish(handle, 1);                                             /* finish with the read frames */
+        
+        return 0;                                                                      /* success return 0 */
     }
-    prev &= ~(1 << 3);                                                                       /* stop measure */
-    prev |= 1 << 2;                                                                          /* sleep */
-    res = a_adxl345_iic_spi_write(handle, ADXL345_REG_POWER_CTL, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                            /* check result */
+    now = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;                 /* get completion time */
+    if (handle->async.state == ADXL345_ASYNC_STATE_STATUS)                             /* fifo status is read */
     {
-        handle->debug_print("adxl345: write failed.\n");                                     /* write failed */
-       
-        return 4;                                                                            /* return error */
+        a_adxl345_fifo_observe(handle, now, handle->async.status & 0x3F);              /* observed now */
+        cnt = handle->async.status & 0x3F;                                             /* get cnt */
+        cnt = (handle->async.len < cnt) ? handle->async.len : cnt;                     /* get min cnt */
+        handle->async.cnt = cnt;                                                       /* set total */
     }
     else
     {
-        res = a_adxl345_close(handle);                                                       /* close */
-        if (res != 0)                                                                        /* check result */
-        {
-            return 1;                                                                        /* return error */
-        }
-        else
+        if (handle->async.mode == ADXL345_MODE_BYPASS)                                 /* bypass mode */
         {
-            handle->inited = 0;                                                              /* flag close */
-    
-            return 0;                                                                        /* success return 0 */
+            handle->timing.level = 0xFF;                                               /* no fifo level in bypass mode */
+            handle->timing.anchor_us = now;                                            /* observed now */
         }
+        handle->async.done++;                                                          /* one more sample */
+    }
+    if (handle->async.done >= handle->async.cnt)                                       /* if complete */
+    {
+        a_adxl345_async_finish(handle, 0);                                             /* finish and unlock */
+        
+        return 0;                                                                      /* success return 0 */
+    }
+    handle->async.state = ADXL345_ASYNC_STATE_DATA;                                    /* data read next */
+    if (a_adxl345_async_start(handle, ADXL345_REG_DATAX0,
+                              &handle->async.buf[handle->async.done * 6], 6) != 0)     /* pop the next entry */
+    {
+        handle->debug_print("adxl345: read failed.\n");                                /* read failed */
+        a_adxl345_async_finish(handle, 1);                                             /* finish with the read frames */
+        
+        return 0;                                                                      /* success return 0 */
     }
+    a_adxl345_unlock(handle);                                                          /* unlock */
+    
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief         read the data
+ * @brief         drain the fifo
  * @param[in]     *handle points to a adxl345 handle structure
  * @param[out]    **raw points to a raw data buffer
  * @param[out]    **g points to a converted data buffer
  * @param[in,out] *len points to a length buffer
  * @return        status code
- *                - 0 success
- *                - 1 read failed
- *                - 2 handle is NULL
- *                - 3 handle is not initialized
- * @note          none
- */
-uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t *len) 
-{
-    uint8_t res, prev;
-    uint8_t mode, cnt, i;
-    uint8_t justify, full_res, range;
-    uint8_t buf[32 * 6];
-    
-    if (handle == NULL)                                                                           /* check handle */
-    {
-        return 2;                                                                                 /* return error */
-    }
-    if (handle->inited != 1)                                                                      /* check handle initialization */
-    {
-        return 3;                                                                                 /* return error */
-    }
-    
-    if ((*len) == 0)                                                                              /* check length */
-    {
-        handle->debug_print("adxl345: length is zero.\n");                                        /* length is zero */
-       
-        return 1;                                                                                 /* return error */
-    }
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);              /* read config */
-    if (res != 0)                                                                                 /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
-       
-        return 1;                                                                                 /* return error */
-    }
-    mode = prev >> 6;                                                                             /* get mode */
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);           /* read config */
-    if (res != 0)                                                                                 /* check result */
-    {
-        handle->debug_print("adxl345: read failed.\n");                                           /* read failed */
-       
-        return 1;                                                                                 /* return error */
-    }
-    full_res = (prev >> 3) & 0x01;                                                                /* get full reselution */
-    justify = (prev >> 2) & 0x01;                                                                 /* get justify */
-    range = prev & 0x03;                                                                          /* get range */
-    if (mode == ADXL345_MODE_BYPASS)                                                              /* bypass */
-    {
-        *len = 1;                                                                                 /* set length 1 */
-        res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATAX0, (uint8_t *)buf, 6);              /* read data */
-        if (res != 0)                                                                             /* check result */
-        {
-            handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
-           
-            return 1;                                                                             /* return error */
-        }
-        raw[0][0] = (int16_t)(buf[1] << 8) | buf[0];                                              /* set raw z */
-        raw[0][1] = (int16_t)(buf[3] << 8) | buf[2];                                              /* set raw y */
-        raw[0][2] = (int16_t)(buf[5] << 8) | buf[4];                                              /* set raw z */
-        if (full_res == 1)                                                                        /* if full reselution */
-        {
-            if (justify == 1)                                                                     /* if justify */
-            {
-                raw[0][0] = (raw[0][0] & 0x80) | (raw[0][0] & (~0x80)) >> (16 - 10 - range);      /* set raw x */
-                raw[0][1] = (raw[0][1] & 0x80) | (raw[0][1] & (~0x80)) >> (16 - 10 - range);      /* set raw y */
-                raw[0][2] = (raw[0][2] & 0x80) | (raw[0][2] & (~0x80)) >> (16 - 10 - range);      /* set raw z */
-            }
-            g[0][0] = (float)(raw[0][0]) * 0.004f;                                                /* convert x */
-            g[0][1] = (float)(raw[0][1]) * 0.004f;                                                /* convert y */
-            g[0][2] = (float)(raw[0][2]) * 0.004f;                                                /* convert z */
-        }
-        else
-        {
-            if (justify == 1)                                                                     /* if justify */
-            {
-                raw[0][0] = (raw[0][0] & 0x80) | (raw[0][0] & (~0x80)) >> (16 - 10);              /* set raw z */
-                raw[0][1] = (raw[0][1] & 0x80) | (raw[0][1] & (~0x80)) >> (16 - 10);              /* set raw y */
-                raw[0][2] = (raw[0][2] & 0x80) | (raw[0][2] & (~0x80)) >> (16 - 10);              /* set raw z */
-            }
-            if (range == 0x00)                                                                    /* if 2g */
-            {
-                g[0][0] = (float)(raw[0][0]) * 0.0039f;                                           /* convert x */
-                g[0][1] = (float)(raw[0][1]) * 0.0039f;                                           /* convert y */
-                g[0][2] = (float)(raw[0][2]) * 0.0039f;                                           /* convert z */
-            }
-            else if (range == 0x01)                                                               /* if 4g */
-            {
-                g[0][0] = (float)(raw[0][0]) * 0.0078f;                                           /* convert x */
-                g[0][1] = (float)(raw[0][1]) * 0.0078f;                                           /* convert y */
-                g[0][2] = (float)(raw[0][2]) * 0.0078f;                                           /* convert z */
-            }
-            else if (range == 0x02)                                                               /* if 8g */
-            {
-                g[0][0] = (float)(raw[0][0]) * 0.0156f;                                           /* convert x */
-                g[0][1] = (float)(raw[0][1]) * 0.0156f;                                           /* convert y */
-                g[0][2] = (float)(raw[0][2]) * 0.0156f;                                           /* convert z */
-            }
-            else                                                                                  /* if 16g */
-            {
-                g[0][0] = (float)(raw[0][0]) * 0.0312f;                                           /* convert x */
-                g[0][1] = (float)(raw[0][1]) * 0.0312f;                                           /* convert y */
-                g[0][2] = (float)(raw[0][2]) * 0.0312f;                                           /* convert z */
-            }
-        }
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 async read is busy
+ * @note          pops up to len entries with individual 6 bytes reads and decodes them into the caller buffers,
+ *                g can be NULL for the raw output only, 3200Hz needs a spi clock of at least 2MHz
+ */
+uint8_t adxl345_fifo_drain(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t *len)
+{
+    uint8_t res;
+    uint8_t buf[33 * 6];
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
     }
-    else                                                                                          /* fifo mode */
+    if (handle->inited != 1)                                                                      /* check handle initialization */
     {
-        res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_STATUS, (uint8_t *)&prev, 1);       /* read fifo status */
-        if (res != 0)                                                                             /* check result */
-        {
-            handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
-            
-            return 1;                                                                             /* return error */
-        }
-        cnt = prev & 0x3F;                                                                        /* get cnt */
-        *len = ((*len) < cnt) ? (*len) : cnt;                                                     /* get min cnt */
-        res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATAX0, (uint8_t *)buf, 6*(*len));       /* read data */
+        return 3;                                                                                 /* return error */
+    }
+    a_adxl345_lock(handle);                                                                       /* lock */
+    ADXL345_TRACE_API(handle);                                                                    /* tag the api */
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                                          /* check async state */
+    {
+        handle->debug_print("adxl345: async read is busy.\n");                                    /* async read is busy */
+        a_adxl345_unlock(handle);                                                                 /* unlock */
+        
+        return 4;                                                                                 /* return error */
+    }
+    
+    handle->session.transactions = 0;                                                             /* clear transactions */
+    handle->session.bytes = 0;                                                                    /* clear bytes */
+    if (handle->session.prepared == 0)                                                            /* if not prepared */
+    {
+        res = a_adxl345_session_prepare(handle);                                                  /* prepare */
         if (res != 0)                                                                             /* check result */
         {
-            handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
-           
+            a_adxl345_unlock(handle);                                                             /* unlock */
             return 1;                                                                             /* return error */
         }
-        for (i = 0; i < (*len); i++)                                                              /* read length */
-        {
-            raw[i][0] = (int16_t)(buf[1 + i * 6] << 8) | buf[0 + i * 6];                          /* set raw x */
-            raw[i][1] = (int16_t)(buf[3 + i * 6] << 8) | buf[2 + i * 6];                          /* set raw y */
-            raw[i][2] = (int16_t)(buf[5 + i * 6] << 8) | buf[4 + i * 6];                          /* set raw z */
-            if (full_res == 1)                                                                    /* if full resolution */
-            {
-                if (justify == 1)                                                                 /* if justify */
-                {
-                    raw[i][0] = (raw[i][0] & 0x80) | (raw[i][0] & (~0x80)) >> (16 -10 - range);   /* get raw x */
-                    raw[i][1] = (raw[i][1] & 0x80) | (raw[i][1] & (~0x80)) >> (16 -10 - range);   /* get raw y */
-                    raw[i][2] = (raw[i][2] & 0x80) | (raw[i][2] & (~0x80)) >> (16 -10 - range);   /* get raw z */
-                }
-                g[i][0] = (float)(raw[i][0])*0.004f;                                              /* convert x */
-                g[i][1] = (float)(raw[i][1])*0.004f;                                              /* convert y */
-                g[i][2] = (float)(raw[i][2])*0.004f;                                              /* convert z */
-            }
-            else
-            {
-                if (justify == 1)                                                                 /* if justify */
-                {
-                    raw[i][0] = (raw[i][0] & 0x80) | (raw[i][0] & (~0x80)) >> (16 - 10);          /* set raw x */
-                    raw[i][1] = (raw[i][1] & 0x80) | (raw[i][1] & (~0x80)) >> (16 - 10);          /* set raw y */
-                    raw[i][2] = (raw[i][2] & 0x80) | (raw[i][2] & (~0x80)) >> (16 - 10);          /* set raw z */
-                }
-                if (range == 0x00)                                                                /* if 2g */
-                {
-                    g[i][0] = (float)(raw[i][0]) * 0.0039f;                                       /* convert x */
-                    g[i][1] = (float)(raw[i][1]) * 0.0039f;                                       /* convert y */
-                    g[i][2] = (float)(raw[i][2]) * 0.0039f;                                       /* convert z */
-                }
-                else if (range == 0x01)                                                           /* if 4g */
-                {
-                    g[i][0] = (float)(raw[i][0]) * 0.0078f;                                       /* convert x */
-                    g[i][1] = (float)(raw[i][1]) * 0.0078f;                                       /* convert y */
-                    g[i][2] = (float)(raw[i][2]) * 0.0078f;                                       /* convert z */
-                }
-                else if (range == 0x02)                                                           /* if 8g */
-                {
-                    g[i][0] = (float)(raw[i][0]) * 0.0156f;                                       /* convert x */
-                    g[i][1] = (float)(raw[i][1]) * 0.0156f;                                       /* convert y */
-                    g[i][2] = (float)(raw[i][2]) * 0.0156f;                                       /* convert z */
-                }
-                else                                                                              /* if 16g */
-                {
-                    g[i][0] = (float)(raw[i][0]) * 0.0312f;                                       /* convert x */
-                    g[i][1] = (float)(raw[i][1]) * 0.0312f;                                       /* convert y */
-                    g[i][2] = (float)(raw[i][2]) * 0.0312f;                                       /* convert z */
-                }
-            }
-        }
     }
     
-    return 0;                                                                                     /* success return 0 */
+    res = a_adxl345_fifo_pop(handle, (uint8_t (*)[6])buf, 0, 33, len, 0xFF);                      /* pop fifo */
+    a_adxl345_decode(buf, raw, g, NULL, *len, handle->session.format);                            /* decode data */
+    a_adxl345_unlock(handle);                                                                     /* unlock */
+    
+    return res;                                                                                   /* return the result */
 }
 
 /**
@@ -3513,11 +6613,16 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
  *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      with a ring set the fifo is drained into it on watermark and overrun before any callback,
+ *            event_callback is called once with the source bitmask,
+ *            then receive_callback is called for each source bit,
+ *            while an async read is in flight it is deferred and run after the completion callback
  */
 uint8_t adxl345_irq_handler(adxl345_handle_t *handle)
 {
-    uint8_t res, prev;
+    uint8_t res, prev, status;
+    uint16_t drained;
+    adxl345_event_t event;
     
     if (handle == NULL)                                                                      /* check handle */
     {
@@ -3527,14 +6632,66 @@ uint8_t adxl345_irq_handler(adxl345_handle_t *handle)
     {
         return 3;                                                                            /* return error */
     }
+    a_adxl345_lock(handle);                                                                  /* lock */
+    ADXL345_TRACE_API(handle);                                                               /* tag the api */
+    if (handle->async.state != ADXL345_ASYNC_STATE_IDLE)                                     /* check async state */
+    {
+        handle->async.irq_deferred = 1;                                                      /* run it after the async read */
+        a_adxl345_unlock(handle);                                                            /* unlock */
+        
+        return 0;                                                                            /* success return 0 */
+    }
     
-    res = a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_SOURCE, (uint8_t *)&prev, 1);       /* read config */
+    status = 0xFF;                                                                           /* fifo status not read */
+    if (handle->event_callback != NULL)                                                      /* if event callback */
+    {
+        res = a_adxl345_event_read(handle, &event);                                          /* read event */
+        prev = event.source;                                                                 /* get source */
+        if (handle->irq_burst == 0)                                                          /* if the event read the fifo status */
+        {
+            status = (uint8_t)((event.trigger << 7) | event.fifo_level);                     /* reuse it for the drain */
+        }
+    }
+    else if (handle->irq_burst != 0)                                                         /* if burst mode */
+    {
+        res = a_adxl345_irq_frame_read(handle);                                              /* read irq frame */
+        prev = handle->irq_frame.source;                                                     /* get source */
+    }
+    else
+    {
+        res = a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_SOURCE, (uint8_t *)&prev, 1);   /* read config */
+    }
     if (res != 0)                                                                            /* check result */
     {
         handle->debug_print("adxl345: read failed.\n");                                      /* read failed */
+        a_adxl345_unlock(handle);                                                            /* unlock */
         
         return 1;                                                                            /* return error */
     }
+    if (handle->stats != NULL)                                                               /* if stats */
+    {
+        handle->stats->irqs++;                                                               /* count irq */
+        handle->stats->watermark_events += (prev >> ADXL345_INTERRUPT_WATERMARK) & 0x01;     /* count watermark */
+        handle->stats->overrun_events += (prev >> ADXL345_INTERRUPT_OVERRUN) & 0x01;         /* count overrun */
+    }
+    drained = 0;                                                                             /* init 0 */
+    if ((handle->ring != NULL) &&
+        ((prev & ((1 << ADXL345_INTERRUPT_WATERMARK) | (1 << ADXL345_INTERRUPT_OVERRUN))) != 0))   /* if fifo event with a ring */
+    {
+        if (a_adxl345_ring_drain(handle, status, &drained) != 0)                             /* drain fifo */
+        {
+            handle->debug_print("adxl345: drain failed.\n");                                 /* drain failed */
+            a_adxl345_unlock(handle);                                                        /* unlock */
+            
+            return 1;                                                                        /* return error */
+        }
+    }
+    a_adxl345_unlock(handle);                                                                /* unlock before the callbacks */
+    if (handle->event_callback != NULL)                                                      /* if event callback */
+    {
+        event.drained = drained;                                                             /* set drained */
+        handle->event_callback(&event);                                                      /* run callback */
+    }
     if ((prev & (1 << ADXL345_INTERRUPT_DATA_READY)) != 0)                                   /* if data ready */
     {
         if (handle->receive_callback != NULL)                                                /* if receive callback */
@@ -3595,6 +6752,348 @@ uint8_t adxl345_irq_handler(adxl345_handle_t *handle)
     return 0;                                                                                /* success return 0 */
 }
 
+/**
+ * @brief     enable or disable the irq burst mode
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      in burst mode the irq handler reads 0x30 - 0x39 in one transaction,
+ *            in fifo mode the entry popped by that read is returned first by the next data read
+ *            and later irqs skip the data registers until it is consumed
+ */
+uint8_t adxl345_set_irq_burst(adxl345_handle_t *handle, adxl345_bool_t enable)
+{
+    if (handle == NULL)                               /* check handle */
+    {
+        return 2;                                     /* return error */
+    }
+    
+    a_adxl345_lock(handle);                           /* lock */
+    handle->irq_burst = (uint8_t)enable;              /* set enable */
+    handle->irq_frame.pending = 0;                    /* flag irq frame consumed */
+    a_adxl345_unlock(handle);                         /* unlock */
+    
+    return 0;                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the irq burst mode status
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *enable points to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t adxl345_get_irq_burst(adxl345_handle_t *handle, adxl345_bool_t *enable)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    
+    *enable = (adxl345_bool_t)(handle->irq_burst);          /* get enable */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the last irq frame
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *frame points to a irq frame structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       it is filled by the irq handler in burst mode and can be used in the receive callback without bus access
+ */
+uint8_t adxl345_get_irq_frame(adxl345_handle_t *handle, adxl345_irq_frame_t *frame)
+{
+    if (handle == NULL)                   /* check handle */
+    {
+        return 2;                         /* return error */
+    }
+    
+    a_adxl345_lock(handle);               /* lock */
+    *frame = handle->irq_frame;           /* get frame */
+    a_adxl345_unlock(handle);             /* unlock */
+    
+    return 0;                             /* success return 0 */
+}
+
+/**
+ * @brief     set the fifo drain ring
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *ring points to a ring structure, NULL removes the ring
+ * @param[in] **frame points to a frame storage
+ * @param[in] size is the frame number of the storage
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 size is zero
+ * @note      the ring is reset, the irq handler drains the fifo into it on watermark and overrun,
+ *            frames of an older data format are flushed by the next drain and counted in flushed
+ */
+uint8_t adxl345_set_ring(adxl345_handle_t *handle, adxl345_ring_t *ring, uint8_t (*frame)[6], uint16_t size)
+{
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (ring == NULL)                                                  /* if remove */
+    {
+        a_adxl345_lock(handle);                                        /* lock */
+        handle->ring = NULL;                                           /* remove ring */
+        a_adxl345_unlock(handle);                                      /* unlock */
+        
+        return 0;                                                      /* success return 0 */
+    }
+    if (size == 0)                                                     /* check size */
+    {
+        handle->debug_print("adxl345: size is zero.\n");               /* size is zero */
+        
+        return 4;                                                      /* return error */
+    }
+    
+    a_adxl345_lock(handle);                                            /* lock */
+    memset(ring, 0, sizeof(adxl345_ring_t));                           /* reset ring */
+    ring->frame = frame;                                               /* set storage */
+    ring->size = size;                                                 /* set size */
+    handle->ring = ring;                                               /* set ring */
+    a_adxl345_unlock(handle);                                          /* unlock */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief         read the frames drained into the ring
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **g points to a converted data buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 4 ring is not set
+ * @note          g can be NULL for the raw output only, no bus access is made
+ */
+uint8_t adxl345_ring_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t *len)
+{
+    uint16_t cnt, part;
+    adxl345_ring_t *ring;
+    
+    if (handle == NULL)                                                                             /* check handle */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    
+    a_adxl345_lock(handle);                                                                         /* lock */
+    if (handle->ring == NULL)                                                                       /* check ring */
+    {
+        handle->debug_print("adxl345: ring is not set.\n");                                         /* ring is not set */
+        a_adxl345_unlock(handle);                                                                   /* unlock */
+        
+        return 4;                                                                                   /* return error */
+    }
+    ring = handle->ring;                                                                            /* get ring */
+    cnt = ((*len) < ring->count) ? (*len) : ring->count;                                            /* get min cnt */
+    part = ((ring->size - ring->tail) < cnt) ? (uint16_t)(ring->size - ring->tail) : cnt;           /* until the wrap */
+    a_adxl345_decode(ring->frame[ring->tail], raw, g, NULL, part, ring->format);                     /* decode first part */
+    if (cnt > part)                                                                                 /* if wrapped */
+    {
+        a_adxl345_decode(ring->frame[0], &raw[part], (g != NULL) ? &g[part] : NULL, NULL,
+                         (uint16_t)(cnt - part), ring->format);                                     /* decode second part */
+    }
+    ring->tail = (uint16_t)((ring->tail + cnt) % ring->size);                                       /* update tail */
+    ring->count = (uint16_t)(ring->count - cnt);                                                    /* update count */
+    *len = cnt;                                                                                     /* set length */
+    a_adxl345_unlock(handle);                                                                       /* unlock */
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     set the runtime statistics block
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *stats points to a stats structure, NULL removes the block
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the block is reset and updated on the bus, read and irq paths
+ */
+uint8_t adxl345_set_stats(adxl345_handle_t *handle, adxl345_stats_t *stats)
+{
+    if (handle == NULL)                                      /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    
+    a_adxl345_lock(handle);                                  /* lock */
+    if (stats != NULL)                                       /* if set */
+    {
+        memset(stats, 0, sizeof(adxl345_stats_t));           /* reset stats */
+    }
+    handle->stats = stats;                                   /* set stats */
+    a_adxl345_unlock(handle);                                /* unlock */
+    
+    return 0;                                                /* success return 0 */
+}
+
+/**
+ * @brief      get a snapshot of the runtime statistics
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *stats points to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 stats is not set
+ * @note       none
+ */
+uint8_t adxl345_get_stats(adxl345_handle_t *handle, adxl345_stats_t *stats)
+{
+    if (handle == NULL)                                      /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    
+    a_adxl345_lock(handle);                                  /* lock */
+    if (handle->stats == NULL)                               /* check stats */
+    {
+        handle->debug_print("adxl345: stats is not set.\n"); /* stats is not set */
+        a_adxl345_unlock(handle);                            /* unlock */
+        
+        return 4;                                            /* return error */
+    }
+    memcpy(stats, handle->stats, sizeof(adxl345_stats_t));   /* copy stats */
+    a_adxl345_unlock(handle);                                /* unlock */
+    
+    return 0;                                                /* success return 0 */
+}
+
+/**
+ * @brief     reset the runtime statistics
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 stats is not set
+ * @note      none
+ */
+uint8_t adxl345_reset_stats(adxl345_handle_t *handle)
+{
+    if (handle == NULL)                                      /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    
+    a_adxl345_lock(handle);                                  /* lock */
+    if (handle->stats == NULL)                               /* check stats */
+    {
+        handle->debug_print("adxl345: stats is not set.\n"); /* stats is not set */
+        a_adxl345_unlock(handle);                            /* unlock */
+        
+        return 4;                                            /* return error */
+    }
+    memset(handle->stats, 0, sizeof(adxl345_stats_t));       /* reset stats */
+    a_adxl345_unlock(handle);                                /* unlock */
+    
+    return 0;                                                /* success return 0 */
+}
+
+#ifdef ADXL345_TRACE
+/**
+ * @brief     set the bus trace buffer
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *trace points to a trace structure, NULL removes the trace
+ * @param[in] *record points to a record storage
+ * @param[in] size is the record number of the storage
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 size is zero
+ * @note      only built with ADXL345_TRACE, timestamps need the timestamp_us hook
+ */
+uint8_t adxl345_set_trace(adxl345_handle_t *handle, adxl345_trace_t *trace, adxl345_trace_record_t *record, uint32_t size)
+{
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (trace == NULL)                                                 /* if remove */
+    {
+        a_adxl345_lock(handle);                                        /* lock */
+        handle->trace = NULL;                                          /* remove trace */
+        a_adxl345_unlock(handle);                                      /* unlock */
+        
+        return 0;                                                      /* success return 0 */
+    }
+    if (size == 0)                                                     /* check size */
+    {
+        handle->debug_print("adxl345: size is zero.\n");               /* size is zero */
+        
+        return 4;                                                      /* return error */
+    }
+    
+    a_adxl345_lock(handle);                                            /* lock */
+    memset(trace, 0, sizeof(adxl345_trace_t));                         /* reset trace */
+    trace->record = record;                                            /* set storage */
+    trace->size = size;                                                /* set size */
+    handle->trace = trace;                                             /* set trace */
+    a_adxl345_unlock(handle);                                          /* unlock */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief         read and remove the oldest trace records
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    *record points to a record buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle, record or len is NULL
+ *                - 4 trace is not set
+ * @note          only built with ADXL345_TRACE, the records can be written to a file as they are
+ *                for the adxl345_trace analyzer
+ */
+uint8_t adxl345_trace_read(adxl345_handle_t *handle, adxl345_trace_record_t *record, uint32_t *len)
+{
+    uint32_t i, cnt, tail;
+    adxl345_trace_t *trace;
+    
+    if (handle == NULL)                                                               /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if ((record == NULL) || (len == NULL))                                            /* check buffer */
+    {
+        return 2;                                                                     /* return error */
+    }
+    
+    a_adxl345_lock(handle);                                                           /* lock */
+    if (handle->trace == NULL)                                                        /* check trace */
+    {
+        handle->debug_print("adxl345: trace is not set.\n");                          /* trace is not set */
+        a_adxl345_unlock(handle);                                                     /* unlock */
+        
+        return 4;                                                                     /* return error */
+    }
+    trace = handle->trace;                                                            /* get trace */
+    cnt = ((*len) < trace->count) ? (*len) : trace->count;                            /* get min cnt */
+    tail = (trace->head + trace->size - trace->count) % trace->size;                  /* oldest record */
+    for (i = 0; i < cnt; i++)                                                         /* copy oldest first */
+    {
+        record[i] = trace->record[(tail + i) % trace->size];                          /* copy record */
+    }
+    trace->count -= cnt;                                                              /* update count */
+    *len = cnt;                                                                       /* set length */
+    a_adxl345_unlock(handle);                                                         /* unlock */
+    
+    return 0;                                                                         /* success return 0 */
+}
+#endif
+
 /**
  * @brief     set the chip register
  * @param[in] *handle points to a adxl345 handle structure
@@ -3610,6 +7109,8 @@ uint8_t adxl345_irq_handler(adxl345_handle_t *handle)
  */
 uint8_t adxl345_set_reg(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+    uint8_t res;
+    
     if (handle == NULL)                                          /* check handle */
     {
         return 2;                                                /* return error */
@@ -3618,8 +7119,13 @@ uint8_t adxl345_set_reg(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uin
     {
         return 3;                                                /* return error */
     }
+    a_adxl345_lock(handle);                                      /* lock */
+    ADXL345_TRACE_API(handle);                                   /* tag the api */
     
-    return a_adxl345_iic_spi_write(handle, reg, buf, len);       /* write data */
+    res = a_adxl345_cache_write(handle, reg, buf, len);          /* write data */
+    a_adxl345_unlock(handle);                                    /* unlock */
+    
+    return res;                                                  /* return the result */
 }
 
 /**
@@ -3637,6 +7143,8 @@ uint8_t adxl345_set_reg(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uin
  */
 uint8_t adxl345_get_reg(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+    uint8_t res;
+    
     if (handle == NULL)                                         /* check handle */
     {
         return 2;                                               /* return error */
@@ -3645,8 +7153,13 @@ uint8_t adxl345_get_reg(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uin
     {
         return 3;                                               /* return error */
     }
+    a_adxl345_lock(handle);                                     /* lock */
+    ADXL345_TRACE_API(handle);                                  /* tag the api */
+    
+    res = a_adxl345_iic_spi_read(handle, reg, buf, len);        /* read data */
+    a_adxl345_unlock(handle);                                   /* unlock */
     
-    return a_adxl345_iic_spi_read(handle, reg, buf, len);       /* read data */
+    return res;                                                 /* return the result */
 }
 
 /**
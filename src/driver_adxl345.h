@@ -84,6 +84,18 @@ typedef enum
     ADXL345_BOOL_TRUE  = 0x01,        /**< true */
 } adxl345_bool_t;
 
+/**
+ * @brief adxl345 convert kernel enumeration definition
+ */
+typedef enum
+{
+    ADXL345_CONVERT_KERNEL_SCALAR = 0x00,        /**< portable scalar kernel */
+    ADXL345_CONVERT_KERNEL_SSE2   = 0x01,        /**< x86 sse2 kernel */
+    ADXL345_CONVERT_KERNEL_AVX2   = 0x02,        /**< x86 avx2 kernel */
+    ADXL345_CONVERT_KERNEL_NEON   = 0x03,        /**< arm neon kernel */
+    ADXL345_CONVERT_KERNEL_AUTO   = 0xFF,        /**< fastest kernel of the cpu */
+} adxl345_convert_kernel_t;
+
 /**
  * @brief adxl345 coupled enumeration definition
  */
@@ -270,6 +282,270 @@ typedef enum
  * @{
  */
 
+/**
+ * @brief adxl345 transfer direction enumeration definition
+ */
+typedef enum
+{
+    ADXL345_TRANSFER_WRITE = 0x00,        /**< write the registers */
+    ADXL345_TRANSFER_READ  = 0x01,        /**< read the registers */
+} adxl345_transfer_direction_t;
+
+/**
+ * @brief adxl345 transfer segment structure definition
+ */
+typedef struct adxl345_transfer_s
+{
+    uint8_t reg;              /**< register address, spi read and multiple byte bits are already set */
+    uint8_t rw;               /**< transfer direction */
+    uint16_t len;             /**< data length */
+    uint8_t *buf;             /**< data buffer */
+    uint16_t delay_us;        /**< minimum delay after this segment in us */
+} adxl345_transfer_t;
+
+/**
+ * @brief adxl345 read session structure definition
+ */
+typedef struct adxl345_session_s
+{
+    uint8_t prepared;             /**< prepared flag */
+    uint8_t mode;                 /**< fifo mode */
+    uint8_t full_res;             /**< full resolution bit */
+    uint8_t justify;              /**< justify bit */
+    uint8_t range;                /**< range bits */
+    uint8_t format;               /**< full_res, justify and range bits */
+    uint16_t transactions;        /**< bus transactions of the last read */
+    uint16_t bytes;               /**< bus bytes of the last read */
+} adxl345_session_t;
+
+/**
+ * @brief adxl345 irq frame structure definition
+ */
+typedef struct adxl345_irq_frame_s
+{
+    uint8_t source;            /**< interrupt source bitmask */
+    uint8_t format;            /**< full_res, justify and range bits */
+    uint8_t mode;              /**< fifo mode */
+    uint8_t trigger;           /**< fifo trigger status */
+    uint8_t fifo_level;        /**< fifo entries reported with the frame, including a pending sample */
+    uint8_t sample[6];         /**< first sample bytes */
+    uint8_t pending;           /**< fifo mode sample is not consumed by a read yet */
+    uint64_t timestamp_us;     /**< time the frame was read */
+} adxl345_irq_frame_t;
+
+/**
+ * @brief adxl345 sample timing structure definition
+ */
+typedef struct adxl345_timing_s
+{
+    uint64_t anchor_us;             /**< time of the last fifo level observation */
+    uint32_t anchor_consumed;       /**< samples read before the last observation */
+    uint32_t consumed;              /**< samples popped so far */
+    uint8_t level;                  /**< fifo level at the last observation, 0xFF if unknown */
+    uint8_t rate;                   /**< rate code the estimate belongs to */
+    uint8_t valid;                  /**< estimate valid flag */
+    uint8_t base_valid;             /**< estimator base valid flag */
+    uint64_t base_us;               /**< time of the estimator base */
+    uint32_t base_generated;        /**< samples generated up to the estimator base */
+    float period_us;                /**< estimated sample period */
+} adxl345_timing_t;
+
+/**
+ * @brief adxl345 async state enumeration definition
+ */
+typedef enum
+{
+    ADXL345_ASYNC_STATE_IDLE   = 0x00,        /**< no read in flight */
+    ADXL345_ASYNC_STATE_STATUS = 0x01,        /**< fifo status read in flight */
+    ADXL345_ASYNC_STATE_DATA   = 0x02,        /**< data read in flight */
+} adxl345_async_state_t;
+
+struct adxl345_handle_s;
+
+/**
+ * @brief adxl345 async read structure definition
+ */
+typedef struct adxl345_async_s
+{
+    volatile uint8_t state;                                                    /**< async state */
+    uint8_t mode;                                                              /**< fifo mode */
+    uint8_t format;                                                            /**< full_res, justify and range bits */
+    uint8_t status;                                                            /**< fifo status buffer */
+    uint16_t len;                                                              /**< requested sample number */
+    uint16_t cnt;                                                              /**< sample number to read */
+    uint16_t done;                                                             /**< read sample number */
+    uint8_t irq_deferred;                                                      /**< irq handler deferred until the read is done */
+    uint8_t *buf;                                                              /**< caller frame buffer */
+    int16_t (*raw)[3];                                                         /**< caller raw data buffer */
+    float (*g)[3];                                                             /**< caller converted data buffer, can be NULL */
+    void (*callback)(struct adxl345_handle_s *handle, uint8_t res,
+                     int16_t (*raw)[3], float (*g)[3], uint16_t len);          /**< completion callback */
+} adxl345_async_t;
+
+/**
+ * @brief adxl345 event structure definition
+ */
+typedef struct adxl345_event_s
+{
+    struct adxl345_handle_s *handle;        /**< handle raising the event */
+    uint8_t source;                         /**< interrupt source bitmask */
+    uint8_t action_tap_status;              /**< action tap status bitmask */
+    uint8_t fifo_level;                     /**< fifo entries */
+    uint8_t trigger;                        /**< fifo trigger status */
+    uint16_t drained;                       /**< frames drained into the ring by this interrupt */
+} adxl345_event_t;
+
+/**
+ * @brief adxl345 frame ring structure definition
+ * @note  the ring is not thread safe, read it in the irq context or with the irq masked
+ */
+typedef struct adxl345_ring_s
+{
+    uint8_t (*frame)[6];        /**< frame storage */
+    uint16_t size;              /**< frame number of the storage */
+    uint16_t head;              /**< write index */
+    uint16_t tail;              /**< read index */
+    uint16_t count;             /**< stored frame number */
+    uint8_t format;             /**< data format of the stored frames */
+    uint32_t overwritten;       /**< oldest frames overwritten when the ring is full */
+    uint32_t flushed;           /**< frames flushed by a data format change */
+} adxl345_ring_t;
+
+/**
+ * @brief adxl345 runtime statistics structure definition
+ * @note  the counters are plain increments without locking, take a snapshot from the handle owner
+ */
+typedef struct adxl345_stats_s
+{
+    uint32_t read_transactions;         /**< bus read transactions */
+    uint32_t write_transactions;        /**< bus write transactions */
+    uint32_t read_bytes;                /**< bus bytes read */
+    uint32_t write_bytes;               /**< bus bytes written */
+    uint32_t bus_errors;                /**< failed bus calls */
+    uint32_t samples;                   /**< samples delivered */
+    uint32_t irqs;                      /**< serviced interrupts */
+    uint32_t watermark_events;          /**< watermark interrupts */
+    uint32_t overrun_events;            /**< overrun interrupts */
+    uint32_t full_drains;               /**< drains that found a full fifo */
+    uint32_t full_drain_run;            /**< current run of consecutive full drains */
+    uint32_t full_drain_run_max;        /**< longest run of consecutive full drains */
+    uint8_t fifo_high_water;            /**< highest observed fifo level */
+} adxl345_stats_t;
+
+#ifdef ADXL345_TRACE
+/**
+ * @brief adxl345 trace flag enumeration definition
+ */
+typedef enum
+{
+    ADXL345_TRACE_FLAG_READ   = 0x01,        /**< read transaction */
+    ADXL345_TRACE_FLAG_BATCH  = 0x02,        /**< segment of a transfer hook call */
+    ADXL345_TRACE_FLAG_FAILED = 0x80,        /**< bus call failed */
+} adxl345_trace_flag_t;
+
+/**
+ * @brief adxl345 trace record structure definition
+ * @note  16 bytes in host byte order, api is the 32 bits fnv-1a hash of the public api name
+ */
+typedef struct adxl345_trace_record_s
+{
+    uint32_t start_us;        /**< transaction start time, low 32 bits */
+    uint32_t end_us;          /**< transaction end time, low 32 bits */
+    uint32_t api;             /**< api tag */
+    uint16_t len;             /**< payload length */
+    uint8_t reg;              /**< register address */
+    uint8_t flag;             /**< trace flags */
+} adxl345_trace_record_t;
+
+/**
+ * @brief adxl345 trace structure definition
+ * @note  the oldest records are overwritten when the buffer is full
+ */
+typedef struct adxl345_trace_s
+{
+    adxl345_trace_record_t *record;        /**< record storage */
+    uint32_t size;                         /**< record number of the storage */
+    uint32_t head;                         /**< write index */
+    uint32_t count;                        /**< stored record number */
+    uint32_t dropped;                      /**< overwritten record number */
+    const char *api_name;                  /**< current api name */
+    const char *api_hashed;                /**< api name of the cached tag */
+    uint32_t api;                          /**< cached api tag */
+} adxl345_trace_t;
+#endif
+
+/**
+ * @brief adxl345 configuration structure definition
+ * @note  thresholds, offsets and times are register values, use the *_convert_to_register functions
+ */
+typedef struct adxl345_config_s
+{
+    uint8_t tap_threshold;                                     /**< tap threshold register value */
+    int8_t offset_x;                                           /**< x offset register value */
+    int8_t offset_y;                                           /**< y offset register value */
+    int8_t offset_z;                                           /**< z offset register value */
+    uint8_t duration;                                          /**< duration register value */
+    uint8_t latent;                                            /**< latent register value */
+    uint8_t window;                                            /**< window register value */
+    uint8_t action_threshold;                                  /**< action threshold register value */
+    uint8_t inaction_threshold;                                /**< inaction threshold register value */
+    uint8_t inaction_time;                                     /**< inaction time register value */
+    adxl345_coupled_t action_coupled;                          /**< action coupled */
+    adxl345_bool_t action_x;                                   /**< x axis action enable */
+    adxl345_bool_t action_y;                                   /**< y axis action enable */
+    adxl345_bool_t action_z;                                   /**< z axis action enable */
+    adxl345_coupled_t inaction_coupled;                        /**< inaction coupled */
+    adxl345_bool_t inaction_x;                                 /**< x axis inaction enable */
+    adxl345_bool_t inaction_y;                                 /**< y axis inaction enable */
+    adxl345_bool_t inaction_z;                                 /**< z axis inaction enable */
+    uint8_t free_fall_threshold;                               /**< free fall threshold register value */
+    uint8_t free_fall_time;                                    /**< free fall time register value */
+    adxl345_bool_t tap_suppress;                               /**< tap suppress */
+    adxl345_bool_t tap_axis_x;                                 /**< x axis tap enable */
+    adxl345_bool_t tap_axis_y;                                 /**< y axis tap enable */
+    adxl345_bool_t tap_axis_z;                                 /**< z axis tap enable */
+    adxl345_rate_t rate;                                       /**< data rate */
+    adxl345_bool_t link_activity_inactivity;                   /**< link activity and inactivity */
+    adxl345_bool_t auto_sleep;                                 /**< auto sleep */
+    adxl345_bool_t measure;                                    /**< measure */
+    adxl345_bool_t sleep;                                      /**< sleep */
+    adxl345_sleep_frequency_t sleep_frequency;                 /**< sleep frequency */
+    adxl345_bool_t interrupt[8];                               /**< interrupt enable indexed by adxl345_interrupt_t */
+    adxl345_interrupt_pin_t interrupt_map[8];                  /**< interrupt pin indexed by adxl345_interrupt_t */
+    adxl345_bool_t self_test;                                  /**< self test */
+    adxl345_spi_wire_t spi_wire;                               /**< spi wire */
+    adxl345_interrupt_active_level_t interrupt_active_level;   /**< interrupt active level */
+    adxl345_bool_t full_resolution;                            /**< full resolution */
+    adxl345_justify_t justify;                                 /**< justify */
+    adxl345_range_t range;                                     /**< range */
+    adxl345_mode_t mode;                                       /**< fifo mode */
+    adxl345_interrupt_pin_t trigger_pin;                       /**< trigger pin */
+    uint8_t watermark;                                         /**< watermark level */
+} adxl345_config_t;
+
+/**
+ * @brief adxl345 configuration snapshot structure definition
+ */
+typedef struct adxl345_config_snapshot_s
+{
+    adxl345_config_t config;                     /**< register level configuration */
+    float tap_threshold_g;                       /**< tap threshold in g */
+    float offset_x_g;                            /**< x offset in g */
+    float offset_y_g;                            /**< y offset in g */
+    float offset_z_g;                            /**< z offset in g */
+    uint32_t duration_us;                        /**< duration in us */
+    float latent_ms;                             /**< latent in ms */
+    float window_ms;                             /**< window in ms */
+    float action_threshold_g;                    /**< action threshold in g */
+    float inaction_threshold_g;                  /**< inaction threshold in g */
+    uint8_t inaction_time_s;                     /**< inaction time in s */
+    float free_fall_threshold_g;                 /**< free fall threshold in g */
+    uint16_t free_fall_time_ms;                  /**< free fall time in ms */
+    uint8_t action_tap_status;                   /**< action tap status register */
+    adxl345_trigger_status_t trigger_status;     /**< fifo trigger status */
+    uint8_t fifo_level;                          /**< fifo entries */
+} adxl345_config_snapshot_t;
+
 /**
  * @brief adxl345 handle structure definition
  */
@@ -284,11 +560,35 @@ typedef struct adxl345_handle_s
     uint8_t (*spi_deinit)(void);                                                        /**< point to a spi_deinit function address */
     uint8_t (*spi_read)(uint8_t reg, uint8_t *buf, uint16_t len);                       /**< point to a spi_read function address */
     uint8_t (*spi_write)(uint8_t reg, uint8_t *buf, uint16_t len);                      /**< point to a spi_write function address */
+    uint8_t (*iic_transfer)(uint8_t addr, adxl345_transfer_t *xfer, uint16_t num);     /**< point to a iic_transfer function address */
+    uint8_t (*spi_transfer)(adxl345_transfer_t *xfer, uint16_t num);                    /**< point to a spi_transfer function address */
+    uint8_t (*iic_read_async)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len,
+                              struct adxl345_handle_s *handle);                         /**< point to a iic_read_async function address */
+    uint8_t (*spi_read_async)(uint8_t reg, uint8_t *buf, uint16_t len,
+                              struct adxl345_handle_s *handle);                         /**< point to a spi_read_async function address */
     void (*receive_callback)(uint8_t type);                                             /**< point to a receive_callback function address */
+    void (*event_callback)(adxl345_event_t *event);                                     /**< point to a event_callback function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                                      /**< point to a delay_us function address */
+    uint64_t (*timestamp_us)(void);                                                     /**< point to a timestamp_us function address */
+    void (*lock)(struct adxl345_handle_s *handle);                                      /**< point to a lock function address */
+    void (*unlock)(struct adxl345_handle_s *handle);                                    /**< point to a unlock function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
     uint8_t inited;                                                                     /**< inited flag */
     uint8_t iic_spi;                                                                    /**< iic spi interface type */
+    uint8_t reg_cache[28];                                                              /**< register cache of 0x1D - 0x38 */
+    uint8_t reg_cache_enable;                                                           /**< register cache enable flag */
+    uint8_t reg_cache_valid;                                                            /**< register cache valid flag */
+    adxl345_session_t session;                                                          /**< read session */
+    uint8_t irq_burst;                                                                  /**< irq burst mode flag */
+    adxl345_irq_frame_t irq_frame;                                                      /**< last irq frame */
+    adxl345_ring_t *ring;                                                               /**< drain ring */
+    adxl345_timing_t timing;                                                            /**< sample timing */
+    adxl345_stats_t *stats;                                                             /**< runtime statistics, NULL if off */
+    adxl345_async_t async;                                                              /**< async read */
+#ifdef ADXL345_TRACE
+    adxl345_trace_t *trace;                                                             /**< bus trace, NULL if off */
+#endif
 } adxl345_handle_t;
 
 /**
@@ -390,6 +690,43 @@ typedef struct adxl345_info_s
  */
 #define DRIVER_ADXL345_LINK_SPI_WRITE(HANDLE, FUC)         (HANDLE)->spi_write = FUC
 
+/**
+ * @brief     link iic_transfer function
+ * @param[in] HANDLE points to a adxl345 handle structure
+ * @param[in] FUC points to a iic_transfer function address
+ * @note      optional, runs several register transactions in one platform call
+ */
+#define DRIVER_ADXL345_LINK_IIC_TRANSFER(HANDLE, FUC)      (HANDLE)->iic_transfer = FUC
+
+/**
+ * @brief     link spi_transfer function
+ * @param[in] HANDLE points to a adxl345 handle structure
+ * @param[in] FUC points to a spi_transfer function address
+ * @note      optional, runs several register transactions in one platform call,
+ *            chip select must be released between the segments
+ */
+#define DRIVER_ADXL345_LINK_SPI_TRANSFER(HANDLE, FUC)      (HANDLE)->spi_transfer = FUC
+
+/**
+ * @brief     link iic_read_async function
+ * @param[in] HANDLE points to a adxl345 handle structure
+ * @param[in] FUC points to a iic_read_async function address
+ * @note      optional, starts a read and returns at once,
+ *            the platform calls adxl345_async_complete with the handle when the read is done,
+ *            until then every blocking bus access of the driver fails and adxl345_deinit returns busy
+ */
+#define DRIVER_ADXL345_LINK_IIC_READ_ASYNC(HANDLE, FUC)    (HANDLE)->iic_read_async = FUC
+
+/**
+ * @brief     link spi_read_async function
+ * @param[in] HANDLE points to a adxl345 handle structure
+ * @param[in] FUC points to a spi_read_async function address
+ * @note      optional, starts a read and returns at once,
+ *            the platform calls adxl345_async_complete with the handle when the read is done,
+ *            until then every blocking bus access of the driver fails and adxl345_deinit returns busy
+ */
+#define DRIVER_ADXL345_LINK_SPI_READ_ASYNC(HANDLE, FUC)    (HANDLE)->spi_read_async = FUC
+
 /**
  * @brief     link delay_ms function
  * @param[in] HANDLE points to a adxl345 handle structure
@@ -398,6 +735,40 @@ typedef struct adxl345_info_s
  */
 #define DRIVER_ADXL345_LINK_DELAY_MS(HANDLE, FUC)          (HANDLE)->delay_ms = FUC
 
+/**
+ * @brief     link delay_us function
+ * @param[in] HANDLE points to a adxl345 handle structure
+ * @param[in] FUC points to a delay_us function address
+ * @note      optional, used to keep the fifo read spacing
+ */
+#define DRIVER_ADXL345_LINK_DELAY_US(HANDLE, FUC)          (HANDLE)->delay_us = FUC
+
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE points to a adxl345 handle structure
+ * @param[in] FUC points to a timestamp_us function address
+ * @note      optional, used to timestamp the samples
+ */
+#define DRIVER_ADXL345_LINK_TIMESTAMP_US(HANDLE, FUC)      (HANDLE)->timestamp_us = FUC
+
+/**
+ * @brief     link lock function
+ * @param[in] HANDLE points to a adxl345 handle structure
+ * @param[in] FUC points to a lock function address
+ * @note      optional, held once around every multi-transaction operation and never taken recursively,
+ *            the irq callbacks run with it released, the handle is passed so each sensor can use its own
+ *            mutex, e.g. by embedding the handle in a struct with the mutex and recovering it from the pointer
+ */
+#define DRIVER_ADXL345_LINK_LOCK(HANDLE, FUC)              (HANDLE)->lock = FUC
+
+/**
+ * @brief     link unlock function
+ * @param[in] HANDLE points to a adxl345 handle structure
+ * @param[in] FUC points to a unlock function address
+ * @note      optional, it must be linked together with the lock function
+ */
+#define DRIVER_ADXL345_LINK_UNLOCK(HANDLE, FUC)            (HANDLE)->unlock = FUC
+
 /**
  * @brief     link debug_print function
  * @param[in] HANDLE points to a adxl345 handle structure
@@ -414,6 +785,14 @@ typedef struct adxl345_info_s
  */
 #define DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(HANDLE, FUC)  (HANDLE)->receive_callback = FUC
 
+/**
+ * @brief     link event_callback function
+ * @param[in] HANDLE points to a adxl345 handle structure
+ * @param[in] FUC points to a event_callback function address
+ * @note      it is called once per interrupt with the whole source bitmask
+ */
+#define DRIVER_ADXL345_LINK_EVENT_CALLBACK(HANDLE, FUC)    (HANDLE)->event_callback = FUC
+
 /**
  * @}
  */
@@ -444,7 +823,8 @@ uint8_t adxl345_info(adxl345_info_t *info);
  *            - 2 handle is NULL
  *            - 3 linked functions is NULL
  *            - 4 id is invalid
- * @note      none
+ *            - 5 load register cache failed
+ * @note      one of receive_callback and event_callback must be linked
  */
 uint8_t adxl345_init(adxl345_handle_t *handle);
 
@@ -457,7 +837,8 @@ uint8_t adxl345_init(adxl345_handle_t *handle);
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 power down failed
- * @note      none
+ *            - 5 async read is busy
+ * @note      wait for the async read callback before closing the chip
  */
 uint8_t adxl345_deinit(adxl345_handle_t *handle);
 
@@ -483,6 +864,85 @@ uint8_t adxl345_set_interface(adxl345_handle_t *handle, adxl345_interface_t inte
  */
 uint8_t adxl345_get_interface(adxl345_handle_t *handle, adxl345_interface_t *interface);
 
+/**
+ * @brief     enable or disable the register cache
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 load register cache failed
+ *            - 2 handle is NULL
+ * @note      it can be called before or after the init function,
+ *            if the chip is initialized the cache is loaded immediately
+ */
+uint8_t adxl345_set_register_cache(adxl345_handle_t *handle, adxl345_bool_t enable);
+
+/**
+ * @brief      get the register cache status
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *enable points to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t adxl345_get_register_cache(adxl345_handle_t *handle, adxl345_bool_t *enable);
+
+/**
+ * @brief     reload the register cache from the chip
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 load register cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 register cache is disabled
+ * @note      call it after the chip has been changed behind the driver,
+ *            e.g. after a power cycle or an external write
+ */
+uint8_t adxl345_register_cache_sync(adxl345_handle_t *handle);
+
+/**
+ * @brief     apply a whole configuration
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *config points to a configuration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 apply config failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the registers are written as contiguous bursts and the power control register is written last,
+ *            with the register cache enabled the registers already holding the value are skipped
+ */
+uint8_t adxl345_apply_config(adxl345_handle_t *handle, const adxl345_config_t *config);
+
+/**
+ * @brief      read the whole configuration
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *snapshot points to a configuration snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 config snapshot failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       0x1D - 0x2F, 0x31 and 0x38 - 0x39 are read as three segments of one transfer call,
+ *             the interrupt source and data registers are skipped so no interrupt is cleared and no fifo entry is popped
+ */
+uint8_t adxl345_config_snapshot(adxl345_handle_t *handle, adxl345_config_snapshot_t *snapshot);
+
+/**
+ * @brief     write a configuration snapshot back
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *snapshot points to a configuration snapshot structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 config restore failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      all registers are written whatever the register cache holds, so it can be used after a chip reset
+ */
+uint8_t adxl345_config_restore(adxl345_handle_t *handle, const adxl345_config_snapshot_t *snapshot);
+
 /**
  * @brief     set the iic address pin
  * @param[in] *handle points to a adxl345 handle structure
@@ -516,10 +976,229 @@ uint8_t adxl345_get_addr_pin(adxl345_handle_t *handle, adxl345_address_t *addr_p
  *                - 1 read failed
  *                - 2 handle is NULL
  *                - 3 handle is not initialized
- * @note          none
+ *                - 4 async read is busy
+ * @note          g can be NULL for the raw output only
  */
 uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t *len);
 
+/**
+ * @brief     prepare the read session
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the fifo mode and the data format are captured once and tracked
+ *            by the driver setters, so adxl345_read_session only accesses the data registers
+ */
+uint8_t adxl345_read_prepare(adxl345_handle_t *handle);
+
+/**
+ * @brief         read the data with the prepared session
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **g points to a converted data buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 async read is busy
+ * @note          the session is prepared automatically if needed,
+ *                g can be NULL for the raw output only
+ */
+uint8_t adxl345_read_session(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t *len);
+
+/**
+ * @brief         read the data in mg
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **mg points to a mg data buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 async read is busy
+ * @note          uses the prepared session and integer arithmetic only,
+ *                mg is the float result of adxl345_read multiplied by 1000 and rounded half away from zero
+ */
+uint8_t adxl345_read_mg(adxl345_handle_t *handle, int16_t (*raw)[3], int32_t (*mg)[3], uint16_t *len);
+
+/**
+ * @brief      decode the data register frames
+ * @param[in]  data_format is the data format register value
+ * @param[in]  *buf points to a frame buffer of 6 bytes per sample
+ * @param[out] **raw points to a raw data buffer
+ * @param[out] **g points to a converted data buffer
+ * @param[out] **mg points to a mg data buffer
+ * @param[in]  len is the sample number
+ * @return     status code
+ *             - 0 success
+ *             - 2 buf or raw is NULL
+ * @note       g and mg can be NULL
+ */
+uint8_t adxl345_decode(uint8_t data_format, uint8_t *buf, int16_t (*raw)[3], float (*g)[3], int32_t (*mg)[3], uint16_t len);
+
+/**
+ * @brief      decode the data register frames into per axis arrays
+ * @param[in]  data_format is the data format register value
+ * @param[in]  *buf points to a frame buffer of 6 bytes per sample
+ * @param[out] *x points to a x axis g buffer
+ * @param[out] *y points to a y axis g buffer
+ * @param[out] *z points to a z axis g buffer
+ * @param[in]  stride is the element distance between two samples in each axis buffer
+ * @param[in]  len is the sample number
+ * @return     status code
+ *             - 0 success
+ *             - 2 buf or axis buffer is NULL
+ * @note       stride 0 is the same as stride 1
+ */
+uint8_t adxl345_decode_soa(uint8_t data_format, uint8_t *buf, float *x, float *y, float *z, uint16_t stride, uint16_t len);
+
+/**
+ * @brief         read the data into per axis arrays
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    *x points to a x axis g buffer
+ * @param[out]    *y points to a y axis g buffer
+ * @param[out]    *z points to a z axis g buffer
+ * @param[in]     stride is the element distance between two samples in each axis buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 async read is busy
+ * @note          uses the prepared session, stride 0 is the same as stride 1
+ */
+uint8_t adxl345_read_soa(adxl345_handle_t *handle, float *x, float *y, float *z, uint16_t stride, uint16_t *len);
+
+/**
+ * @brief      convert the data register frames in a batch
+ * @param[in]  kernel is the convert kernel
+ * @param[in]  data_format is the data format register value
+ * @param[in]  *buf points to a frame buffer of 6 bytes per sample
+ * @param[out] **g points to a converted data buffer
+ * @param[out] **mg points to a mg data buffer
+ * @param[in]  len is the sample number
+ * @return     status code
+ *             - 0 success
+ *             - 1 no output is requested
+ *             - 2 buf is NULL
+ *             - 3 kernel is not supported
+ * @note       g or mg can be NULL, ADXL345_CONVERT_KERNEL_AUTO picks the fastest kernel of the cpu,
+ *             all kernels give bit exact results
+ */
+uint8_t adxl345_convert_batch(adxl345_convert_kernel_t kernel, uint8_t data_format, uint8_t *buf,
+                              float (*g)[3], int32_t (*mg)[3], uint32_t len);
+
+/**
+ * @brief     check whether a batch convert kernel runs on this cpu
+ * @param[in] kernel is the convert kernel
+ * @return    status code
+ *            - 0 supported
+ *            - 1 kernel is not supported
+ * @note      none
+ */
+uint8_t adxl345_check_convert_kernel(adxl345_convert_kernel_t kernel);
+
+/**
+ * @brief      get the batch convert kernel picked by ADXL345_CONVERT_KERNEL_AUTO
+ * @param[out] *kernel points to a convert kernel buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the cpu is probed once and the result is shared by all handles and threads
+ */
+uint8_t adxl345_get_convert_kernel(adxl345_convert_kernel_t *kernel);
+
+/**
+ * @brief      get the bus cost of the last read
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *transactions points to a bus transactions buffer
+ * @param[out] *bytes points to a bus bytes buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       the cost of the last read or fifo drain call,
+ *             bytes include the register address byte of each transaction
+ */
+uint8_t adxl345_get_read_cost(adxl345_handle_t *handle, uint16_t *transactions, uint16_t *bytes);
+
+/**
+ * @brief         read the data with a timestamp for every sample
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **g points to a converted data buffer
+ * @param[out]    *timestamp_us points to a timestamp buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 timestamp_us is NULL
+ *                - 5 async read is busy
+ * @note          the newest sample is anchored at the fifo level observation time
+ *                and the older ones are back-filled with the estimated sample period
+ */
+uint8_t adxl345_read_timestamp(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
+                               uint64_t *timestamp_us, uint16_t *len);
+
+/**
+ * @brief      get the estimated output data rate
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *hz points to a rate buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 no estimate yet
+ * @note       the estimate tracks the real rate from the timestamped reads
+ */
+uint8_t adxl345_get_estimated_rate(adxl345_handle_t *handle, float *hz);
+
+/**
+ * @brief      start an async read
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *buf points to a frame buffer of 6 bytes per sample
+ * @param[out] **raw points to a raw data buffer
+ * @param[out] **g points to a converted data buffer
+ * @param[in]  len is the max sample number
+ * @param[in]  *callback points to a completion callback
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 read async is NULL
+ *             - 5 async read is busy
+ * @note       the buffers must stay valid until the callback runs, g can be NULL for the raw output only,
+ *             buf holds at least min(len, 33) frames, the handle keeps no frame storage of its own,
+ *             in fifo mode the fifo status and every entry are chained reads, one in flight at a time,
+ *             until the callback the other data reads and adxl345_deinit return busy, the irq handler is deferred
+ *             and every other api touching the bus fails
+ */
+uint8_t adxl345_read_async(adxl345_handle_t *handle, uint8_t *buf, int16_t (*raw)[3], float (*g)[3], uint16_t len,
+                           void (*callback)(adxl345_handle_t *handle, uint8_t res,
+                                            int16_t (*raw)[3], float (*g)[3], uint16_t len));
+
+/**
+ * @brief     complete the async read in flight
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] res is the result of the finished read, 0 means success
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 no async read in flight
+ * @note      called by the platform when a read started by the async hook is done,
+ *            it starts the next chained read or decodes the frames and runs the callback,
+ *            it must not be called from inside the async hook
+ */
+uint8_t adxl345_async_complete(adxl345_handle_t *handle, uint8_t res);
+
 /**
  * @brief     irq handler
  * @param[in] *handle points to a adxl345 handle structure
@@ -528,10 +1207,141 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
  *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      with a ring set the fifo is drained into it on watermark and overrun before any callback,
+ *            event_callback is called once with the source bitmask,
+ *            then receive_callback is called for each source bit,
+ *            while an async read is in flight it is deferred and run after the completion callback
  */
 uint8_t adxl345_irq_handler(adxl345_handle_t *handle);
 
+/**
+ * @brief     enable or disable the irq burst mode
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      in burst mode the irq handler reads 0x30 - 0x39 in one transaction,
+ *            in fifo mode the entry popped by that read is returned first by the next data read
+ *            and later irqs skip the data registers until it is consumed
+ */
+uint8_t adxl345_set_irq_burst(adxl345_handle_t *handle, adxl345_bool_t enable);
+
+/**
+ * @brief      get the irq burst mode status
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *enable points to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t adxl345_get_irq_burst(adxl345_handle_t *handle, adxl345_bool_t *enable);
+
+/**
+ * @brief      get the last irq frame
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *frame points to a irq frame structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       it is filled by the irq handler in burst mode and can be used in the receive callback without bus access
+ */
+uint8_t adxl345_get_irq_frame(adxl345_handle_t *handle, adxl345_irq_frame_t *frame);
+
+/**
+ * @brief     set the fifo drain ring
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *ring points to a ring structure, NULL removes the ring
+ * @param[in] **frame points to a frame storage
+ * @param[in] size is the frame number of the storage
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 size is zero
+ * @note      the ring is reset, the irq handler drains the fifo into it on watermark and overrun,
+ *            frames of an older data format are flushed by the next drain and counted in flushed
+ */
+uint8_t adxl345_set_ring(adxl345_handle_t *handle, adxl345_ring_t *ring, uint8_t (*frame)[6], uint16_t size);
+
+/**
+ * @brief         read the frames drained into the ring
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **g points to a converted data buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 4 ring is not set
+ * @note          g can be NULL for the raw output only, no bus access is made
+ */
+uint8_t adxl345_ring_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t *len);
+
+/**
+ * @brief     set the runtime statistics block
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *stats points to a stats structure, NULL removes the block
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the block is reset and updated on the bus, read and irq paths
+ */
+uint8_t adxl345_set_stats(adxl345_handle_t *handle, adxl345_stats_t *stats);
+
+/**
+ * @brief      get a snapshot of the runtime statistics
+ * @param[in]  *handle points to a adxl345 handle structure
+ * @param[out] *stats points to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 stats is not set
+ * @note       none
+ */
+uint8_t adxl345_get_stats(adxl345_handle_t *handle, adxl345_stats_t *stats);
+
+/**
+ * @brief     reset the runtime statistics
+ * @param[in] *handle points to a adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 stats is not set
+ * @note      none
+ */
+uint8_t adxl345_reset_stats(adxl345_handle_t *handle);
+
+#ifdef ADXL345_TRACE
+/**
+ * @brief     set the bus trace buffer
+ * @param[in] *handle points to a adxl345 handle structure
+ * @param[in] *trace points to a trace structure, NULL removes the trace
+ * @param[in] *record points to a record storage
+ * @param[in] size is the record number of the storage
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 size is zero
+ * @note      only built with ADXL345_TRACE, timestamps need the timestamp_us hook
+ */
+uint8_t adxl345_set_trace(adxl345_handle_t *handle, adxl345_trace_t *trace, adxl345_trace_record_t *record, uint32_t size);
+
+/**
+ * @brief         read and remove the oldest trace records
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    *record points to a record buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle, record or len is NULL
+ *                - 4 trace is not set
+ * @note          only built with ADXL345_TRACE, the records can be written to a file as they are
+ *                for the adxl345_trace analyzer
+ */
+uint8_t adxl345_trace_read(adxl345_handle_t *handle, adxl345_trace_record_t *record, uint32_t *len);
+#endif
+
 /**
  * @brief     set the tap threshold
  * @param[in] *handle points to a adxl345 handle structure
@@ -1723,6 +2533,23 @@ uint8_t adxl345_get_watermark(adxl345_handle_t *handle, uint8_t *level);
  */
 uint8_t adxl345_get_watermark_level(adxl345_handle_t *handle, uint8_t *level);
 
+/**
+ * @brief         drain the fifo
+ * @param[in]     *handle points to a adxl345 handle structure
+ * @param[out]    **raw points to a raw data buffer
+ * @param[out]    **g points to a converted data buffer
+ * @param[in,out] *len points to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 async read is busy
+ * @note          pops up to len entries with individual 6 bytes reads and decodes them into the caller buffers,
+ *                g can be NULL for the raw output only, 3200Hz needs a spi clock of at least 2MHz
+ */
+uint8_t adxl345_fifo_drain(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t *len);
+
 /**
  * @}
  */
@@ -0,0 +1,319 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_decode_test.c
+ * @brief     driver adxl345 decode test source file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>2.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_decode_test.h"
+#include <time.h>
+
+static uint8_t gs_frame_test[32 * 6];        /**< frame test buffer */
+static int16_t gs_raw_test[32][3];           /**< raw test buffer */
+static float gs_test[32][3];                 /**< test buffer */
+static int32_t gs_mg_test[32][3];            /**< mg test buffer */
+static float gs_check[32][3];                /**< check buffer */
+static int32_t gs_mg_check[32][3];           /**< mg check buffer */
+static float gs_axis_test[3][32 * 2];       /**< per axis test buffer */
+
+/**
+ * @brief      legacy per sample decode loop
+ * @param[in]  *buf points to a frame buffer
+ * @param[out] **raw points to a raw data buffer
+ * @param[out] **g points to a converted data buffer
+ * @param[in]  len is the sample number
+ * @param[in]  format is the full_res, justify and range bits
+ * @note       the previous adxl345_read conversion, kept as the benchmark baseline
+ */
+static void a_adxl345_decode_legacy(uint8_t *buf, int16_t (*raw)[3], float (*g)[3], uint16_t len, uint8_t format)
+{
+    uint16_t i;
+    uint8_t full_res, justify, range;
+    
+    full_res = (format >> 3) & 0x01;
+    justify = (format >> 2) & 0x01;
+    range = format & 0x03;
+    for (i = 0; i < len; i++)
+    {
+        raw[i][0] = (int16_t)(buf[1 + i * 6] << 8) | buf[0 + i * 6];
+        raw[i][1] = (int16_t)(buf[3 + i * 6] << 8) | buf[2 + i * 6];
+        raw[i][2] = (int16_t)(buf[5 + i * 6] << 8) | buf[4 + i * 6];
+        if (full_res == 1)
+        {
+            if (justify == 1)
+            {
+                raw[i][0] = (raw[i][0] & 0x80) | (raw[i][0] & (~0x80)) >> (16 -10 - range);
+                raw[i][1] = (raw[i][1] & 0x80) | (raw[i][1] & (~0x80)) >> (16 -10 - range);
+                raw[i][2] = (raw[i][2] & 0x80) | (raw[i][2] & (~0x80)) >> (16 -10 - range);
+            }
+            g[i][0] = (float)(raw[i][0])*0.004f;
+            g[i][1] = (float)(raw[i][1])*0.004f;
+            g[i][2] = (float)(raw[i][2])*0.004f;
+        }
+        else
+        {
+            if (justify == 1)
+            {
+                raw[i][0] = (raw[i][0] & 0x80) | (raw[i][0] & (~0x80)) >> (16 - 10);
+                raw[i][1] = (raw[i][1] & 0x80) | (raw[i][1] & (~0x80)) >> (16 - 10);
+                raw[i][2] = (raw[i][2] & 0x80) | (raw[i][2] & (~0x80)) >> (16 - 10);
+            }
+            if (range == 0x00)
+            {
+                g[i][0] = (float)(raw[i][0]) * 0.0039f;
+                g[i][1] = (float)(raw[i][1]) * 0.0039f;
+                g[i][2] = (float)(raw[i][2]) * 0.0039f;
+            }
+            else if (range == 0x01)
+            {
+                g[i][0] = (float)(raw[i][0]) * 0.0078f;
+                g[i][1] = (float)(raw[i][1]) * 0.0078f;
+                g[i][2] = (float)(raw[i][2]) * 0.0078f;
+            }
+            else if (range == 0x02)
+            {
+                g[i][0] = (float)(raw[i][0]) * 0.0156f;
+                g[i][1] = (float)(raw[i][1]) * 0.0156f;
+                g[i][2] = (float)(raw[i][2]) * 0.0156f;
+            }
+            else
+            {
+                g[i][0] = (float)(raw[i][0]) * 0.0312f;
+                g[i][1] = (float)(raw[i][1]) * 0.0312f;
+                g[i][2] = (float)(raw[i][2]) * 0.0312f;
+            }
+        }
+    }
+}
+
+/**
+ * @brief     reference decode of one axis
+ * @param[in] lsb is the low byte
+ * @param[in] msb is the high byte
+ * @param[in] format is the full_res, justify and range bits
+ * @return    raw data
+ * @note      plain arithmetic, floor division for the left justify shift
+ */
+static int32_t a_adxl345_decode_reference(uint8_t lsb, uint8_t msb, uint8_t format)
+{
+    int32_t v;
+    int32_t div;
+    
+    v = (int32_t)(((uint32_t)msb << 8) | lsb);
+    if (v >= 32768)
+    {
+        v -= 65536;
+    }
+    if (((format >> 2) & 0x01) == 0)
+    {
+        return v;
+    }
+    if (((format >> 3) & 0x01) == 0)
+    {
+        div = 64;
+    }
+    else
+    {
+        div = 64 >> (format & 0x03);
+    }
+    if (v >= 0)
+    {
+        return v / div;
+    }
+    else
+    {
+        return -((-v + div - 1) / div);
+    }
+}
+
+/**
+ * @brief     decode test
+ * @param[in] times is the benchmark times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      runs on the host without the chip
+ */
+uint8_t adxl345_decode_test(uint32_t times)
+{
+    uint8_t format, kernel;
+    uint16_t i, j;
+    adxl345_convert_kernel_t selected;
+    uint32_t k;
+    uint32_t seed;
+    uint32_t legacy_error;
+    clock_t start;
+    double legacy_ns, kernel_ns;
+    
+    /* start decode test */
+    adxl345_interface_debug_print("adxl345: start decode test.\n");
+    
+    /* fill the frames */
+    seed = 0x12345678;
+    for (i = 0; i < 32 * 6; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        gs_frame_test[i] = (uint8_t)(seed >> 24);
+    }
+    
+    /* check all formats */
+    legacy_error = 0;
+    for (format = 0; format < 16; format++)
+    {
+        if (adxl345_decode(format, gs_frame_test, gs_raw_test, gs_test, NULL, 32) != 0)
+        {
+            adxl345_interface_debug_print("adxl345: decode failed.\n");
+            
+            return 1;
+        }
+        for (i = 0; i < 32; i++)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                if (gs_raw_test[i][j] != a_adxl345_decode_reference(gs_frame_test[i * 6 + j * 2],
+                                                                    gs_frame_test[i * 6 + j * 2 + 1], format))
+                {
+                    adxl345_interface_debug_print("adxl345: format 0x%02X sample %d check failed.\n", format, i);
+                    
+                    return 1;
+                }
+            }
+        }
+        a_adxl345_decode_legacy(gs_frame_test, gs_raw_test, gs_test, 32, format);
+        for (i = 0; i < 32; i++)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                if (gs_raw_test[i][j] != a_adxl345_decode_reference(gs_frame_test[i * 6 + j * 2],
+                                                                    gs_frame_test[i * 6 + j * 2 + 1], format))
+                {
+                    legacy_error++;
+                }
+            }
+        }
+    }
+    
+    /* check the per axis layout */
+    for (format = 0; format < 16; format++)
+    {
+        (void)adxl345_decode(format, gs_frame_test, gs_raw_test, gs_test, NULL, 32);
+        if (adxl345_decode_soa(format, gs_frame_test, gs_axis_test[0], gs_axis_test[1], gs_axis_test[2], 2, 32) != 0)
+        {
+            adxl345_interface_debug_print("adxl345: decode soa failed.\n");
+            
+            return 1;
+        }
+        for (i = 0; i < 32; i++)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                if (memcmp(&gs_axis_test[j][i * 2], &gs_test[i][j], sizeof(float)) != 0)
+                {
+                    adxl345_interface_debug_print("adxl345: format 0x%02X sample %d soa check failed.\n", format, i);
+                    
+                    return 1;
+                }
+            }
+        }
+    }
+    adxl345_interface_debug_print("adxl345: decode check passed.\n");
+    adxl345_interface_debug_print("adxl345: legacy loop has %d wrong values.\n", legacy_error);
+    
+    /* benchmark the legacy loop */
+    start = clock();
+    for (k = 0; k < times; k++)
+    {
+        for (format = 0; format < 16; format++)
+        {
+            a_adxl345_decode_legacy(gs_frame_test, gs_raw_test, gs_test, 32, format);
+        }
+    }
+    legacy_ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)times * 16 * 32 + 1);
+    
+    /* benchmark the kernels */
+    start = clock();
+    for (k = 0; k < times; k++)
+    {
+        for (format = 0; format < 16; format++)
+        {
+            (void)adxl345_decode(format, gs_frame_test, gs_raw_test, gs_test, NULL, 32);
+        }
+    }
+    kernel_ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)times * 16 * 32 + 1);
+    adxl345_interface_debug_print("adxl345: legacy loop %0.2f ns/sample.\n", legacy_ns);
+    adxl345_interface_debug_print("adxl345: decode kernel %0.2f ns/sample.\n", kernel_ns);
+    
+    /* check and benchmark the batch convert kernels */
+    (void)adxl345_get_convert_kernel(&selected);
+    adxl345_interface_debug_print("adxl345: auto convert kernel is %d.\n", selected);
+    for (kernel = ADXL345_CONVERT_KERNEL_SSE2; kernel <= ADXL345_CONVERT_KERNEL_NEON; kernel++)
+    {
+        if (adxl345_check_convert_kernel((adxl345_convert_kernel_t)kernel) != 0)
+        {
+            continue;
+        }
+        for (format = 0; format < 16; format++)
+        {
+            (void)adxl345_convert_batch(ADXL345_CONVERT_KERNEL_SCALAR, format, gs_frame_test, gs_check, gs_mg_check, 32);
+            (void)adxl345_convert_batch((adxl345_convert_kernel_t)kernel, format, gs_frame_test, gs_test, gs_mg_test, 32);
+            if ((memcmp(gs_test, gs_check, sizeof(gs_test)) != 0) ||
+                (memcmp(gs_mg_test, gs_mg_check, sizeof(gs_mg_test)) != 0))
+            {
+                adxl345_interface_debug_print("adxl345: kernel %d format 0x%02X check failed.\n", kernel, format);
+                
+                return 1;
+            }
+        }
+    }
+    for (kernel = ADXL345_CONVERT_KERNEL_SCALAR; kernel <= ADXL345_CONVERT_KERNEL_NEON; kernel++)
+    {
+        if (adxl345_check_convert_kernel((adxl345_convert_kernel_t)kernel) != 0)
+        {
+            continue;
+        }
+        start = clock();
+        for (k = 0; k < times; k++)
+        {
+            for (format = 0; format < 16; format++)
+            {
+                (void)adxl345_convert_batch((adxl345_convert_kernel_t)kernel, format, gs_frame_test, gs_test, NULL, 32);
+            }
+        }
+        kernel_ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)times * 16 * 32 + 1);
+        adxl345_interface_debug_print("adxl345: convert kernel %d %0.2f ns/sample.\n", kernel, kernel_ns);
+    }
+    
+    /* finish decode test */
+    adxl345_interface_debug_print("adxl345: finish decode test.\n");
+    
+    return 0;
+}
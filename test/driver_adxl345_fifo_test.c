@@ -140,6 +140,7 @@ uint8_t adxl345_fifo_test(adxl345_interface_t interface, adxl345_address_t addr_
     DRIVER_ADXL345_LINK_SPI_READ(&gs_handle, adxl345_interface_spi_read);
     DRIVER_ADXL345_LINK_SPI_WRITE(&gs_handle, adxl345_interface_spi_write);
     DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, adxl345_interface_delay_ms);
+    DRIVER_ADXL345_LINK_DELAY_US(&gs_handle, adxl345_interface_delay_us);
     DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, adxl345_interface_debug_print);
     DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, a_adxl345_interface_test_receive_callback);
     
@@ -37,30 +37,22 @@
 
 #include "driver_adxl345_register_test.h"
 #include <stdlib.h>
+#include <string.h>
 
 static adxl345_handle_t gs_handle;        /**< adxl345 handle */
 
 /**
- * @brief     register test
- * @param[in] interface is the chip interface
- * @param[in] addr_pin is the iic device address
- * @return    status code
- *            - 0 success
- *            - 1 test failed
- * @note      none
+ * @brief  run the setter and getter round trips
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the handle is closed on failure
  */
-uint8_t adxl345_register_test(adxl345_interface_t interface, adxl345_address_t addr_pin)
+static uint8_t a_adxl345_register_round_trip(void)
 {
     uint8_t res, reg, check;
     int8_t x, y, z;
     int8_t x_check, y_check, z_check;
-    float f, f_check;
-    int8_t i_reg;
-    uint32_t us, us_check;
-    uint16_t ms, ms_check;
-    adxl345_info_t info;
-    adxl345_interface_t interface_test;
-    adxl345_address_t addr;
     adxl345_bool_t bool_test;
     adxl345_coupled_t coupled;
     adxl345_rate_t rate;
@@ -72,150 +64,6 @@ uint8_t adxl345_register_test(adxl345_interface_t interface, adxl345_address_t a
     adxl345_sleep_frequency_t sleep_frequency;
     adxl345_trigger_status_t trigger;
     
-    /* link interface function */
-    DRIVER_ADXL345_LINK_INIT(&gs_handle, adxl345_handle_t);
-    DRIVER_ADXL345_LINK_IIC_INIT(&gs_handle, adxl345_interface_iic_init);
-    DRIVER_ADXL345_LINK_IIC_DEINIT(&gs_handle, adxl345_interface_iic_deinit);
-    DRIVER_ADXL345_LINK_IIC_READ(&gs_handle, adxl345_interface_iic_read);
-    DRIVER_ADXL345_LINK_IIC_WRITE(&gs_handle, adxl345_interface_iic_write);
-    DRIVER_ADXL345_LINK_SPI_INIT(&gs_handle, adxl345_interface_spi_init);
-    DRIVER_ADXL345_LINK_SPI_DEINIT(&gs_handle, adxl345_interface_spi_deinit);
-    DRIVER_ADXL345_LINK_SPI_READ(&gs_handle, adxl345_interface_spi_read);
-    DRIVER_ADXL345_LINK_SPI_WRITE(&gs_handle, adxl345_interface_spi_write);
-    DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, adxl345_interface_delay_ms);
-    DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, adxl345_interface_debug_print);
-    DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, adxl345_interface_receive_callback);
-    
-    /* get information */
-    res = adxl345_info(&info);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: get info failed.\n");
-       
-        return 1;
-    }
-    else
-    {
-        /* print chip info */
-        adxl345_interface_debug_print("adxl345: chip is %s.\n", info.chip_name);
-        adxl345_interface_debug_print("adxl345: manufacturer is %s.\n", info.manufacturer_name);
-        adxl345_interface_debug_print("adxl345: interface is %s.\n", info.interface);
-        adxl345_interface_debug_print("adxl345: driver version is %d.%d.\n", info.driver_version/1000, (info.driver_version%1000)/100);
-        adxl345_interface_debug_print("adxl345: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
-        adxl345_interface_debug_print("adxl345: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
-        adxl345_interface_debug_print("adxl345: max current is %0.2fmA.\n", info.max_current_ma);
-        adxl345_interface_debug_print("adxl345: max temperature is %0.1fC.\n", info.temperature_max);
-        adxl345_interface_debug_print("adxl345: min temperature is %0.1fC.\n", info.temperature_min);
-    }
-    
-    /* start register test */
-    adxl345_interface_debug_print("adxl345: start register test.\n");
-    
-    /* adxl345_set_interface/adxl345_get_interface test */
-    adxl345_interface_debug_print("adxl345: adxl345_set_interface/adxl345_get_interface test.\n");
-    
-    /* set IIC interface */
-    res = adxl345_set_interface(&gs_handle, ADXL345_INTERFACE_IIC);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interface failed.\n");
-       
-        return 1;
-    }
-    adxl345_interface_debug_print("adxl345: set interface iic.\n");
-    res = adxl345_get_interface(&gs_handle, &interface_test);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: get interface failed.\n");
-       
-        return 1;
-    }
-    adxl345_interface_debug_print("adxl345: check interface %s.\n", interface_test==ADXL345_INTERFACE_IIC?"ok":"error");
-    
-    /* set SPI interface */
-    res = adxl345_set_interface(&gs_handle, ADXL345_INTERFACE_SPI);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interface failed.\n");
-       
-        return 1;
-    }
-    adxl345_interface_debug_print("adxl345: set interface spi.\n");
-    res = adxl345_get_interface(&gs_handle, &interface_test);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: get interface failed.\n");
-       
-        return 1;
-    }
-    adxl345_interface_debug_print("adxl345: check interface %s.\n", interface_test==ADXL345_INTERFACE_SPI?"ok":"error");
-    
-    /* adxl345_set_addr_pin/adxl345_get_addr_pin test */
-    adxl345_interface_debug_print("adxl345: adxl345_set_addr_pin/adxl345_get_addr_pin test.\n");
-    
-    /* ALT0 */
-    res = adxl345_set_addr_pin(&gs_handle, ADXL345_ADDRESS_ALT_0);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set addr pin failed.\n");
-       
-        return 1;
-    }
-    adxl345_interface_debug_print("adxl345: set addr pin alt0.\n");
-    res = adxl345_get_addr_pin(&gs_handle, &addr);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: get addr pin failed.\n");
-       
-        return 1;
-    }
-    adxl345_interface_debug_print("adxl345: check addr pin %s.\n", addr==ADXL345_ADDRESS_ALT_0?"ok":"error");
-    
-    /* ALT1 */
-    res = adxl345_set_addr_pin(&gs_handle, ADXL345_ADDRESS_ALT_1);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set addr pin failed.\n");
-       
-        return 1;
-    }
-    adxl345_interface_debug_print("adxl345: set addr pin alt1.\n");
-    res = adxl345_get_addr_pin(&gs_handle, &addr);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: get addr pin failed.\n");
-       
-        return 1;
-    }
-    adxl345_interface_debug_print("adxl345: check addr pin %s.\n", addr==ADXL345_ADDRESS_ALT_1?"ok":"error");
-    
-    /* set the interface */
-    res = adxl345_set_interface(&gs_handle, interface);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set interface failed.\n");
-       
-        return 1;
-    }
-    
-    /* set the address pin */
-    res = adxl345_set_addr_pin(&gs_handle, addr_pin);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: set addr pin failed.\n");
-       
-        return 1;
-    }
-    
-    /* init the adxl345 */
-    res = adxl345_init(&gs_handle);
-    if (res != 0)
-    {
-        adxl345_interface_debug_print("adxl345: init failed.\n");
-       
-        return 1;
-    }
-    
     /* adxl345_set_tap_threshold/adxl345_get_tap_threshold test */
     adxl345_interface_debug_print("adxl345: adxl345_set_tap_threshold/adxl345_get_tap_threshold test.\n");
     reg = rand()%256;
@@ -2776,6 +2624,653 @@ uint8_t adxl345_register_test(adxl345_interface_t interface, adxl345_address_t a
     }
     adxl345_interface_debug_print("adxl345: check sleep frequency %s.\n", sleep_frequency==ADXL345_SLEEP_FREQUENCY_1HZ?"ok":"error");
     
+    return 0;
+}
+
+/**
+ * @brief      read every config field through the public getters
+ * @param[out] *config points to a config structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 test failed
+ * @note       the handle is closed on failure
+ */
+static uint8_t a_adxl345_register_getter_config(adxl345_config_t *config)
+{
+    uint8_t res;
+    uint8_t i;
+    
+    memset(config, 0, sizeof(adxl345_config_t));
+    res = adxl345_get_tap_threshold(&gs_handle, &config->tap_threshold);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get tap threshold failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_offset(&gs_handle, &config->offset_x, &config->offset_y, &config->offset_z);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get offset failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_duration(&gs_handle, &config->duration);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get duration failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_latent(&gs_handle, &config->latent);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get latent failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_window(&gs_handle, &config->window);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get window failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_action_threshold(&gs_handle, &config->action_threshold);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get action threshold failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_inaction_threshold(&gs_handle, &config->inaction_threshold);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get inaction threshold failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_inaction_time(&gs_handle, &config->inaction_time);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get inaction time failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_action_coupled(&gs_handle, &config->action_coupled);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get action coupled failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_action_inaction(&gs_handle, ADXL345_ACTION_X, &config->action_x);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get action inaction failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_action_inaction(&gs_handle, ADXL345_ACTION_Y, &config->action_y);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get action inaction failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_action_inaction(&gs_handle, ADXL345_ACTION_Z, &config->action_z);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get action inaction failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_inaction_coupled(&gs_handle, &config->inaction_coupled);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get inaction coupled failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_action_inaction(&gs_handle, ADXL345_INACTION_X, &config->inaction_x);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get action inaction failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_action_inaction(&gs_handle, ADXL345_INACTION_Y, &config->inaction_y);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get action inaction failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_action_inaction(&gs_handle, ADXL345_INACTION_Z, &config->inaction_z);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get action inaction failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_free_fall_threshold(&gs_handle, &config->free_fall_threshold);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get free fall threshold failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_free_fall_time(&gs_handle, &config->free_fall_time);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get free fall time failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_tap_suppress(&gs_handle, &config->tap_suppress);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get tap suppress failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_tap_axis(&gs_handle, ADXL345_TAP_AXIS_X, &config->tap_axis_x);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get tap axis failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_tap_axis(&gs_handle, ADXL345_TAP_AXIS_Y, &config->tap_axis_y);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get tap axis failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_tap_axis(&gs_handle, ADXL345_TAP_AXIS_Z, &config->tap_axis_z);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get tap axis failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_rate(&gs_handle, &config->rate);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get rate failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_link_activity_inactivity(&gs_handle, &config->link_activity_inactivity);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get link activity inactivity failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_auto_sleep(&gs_handle, &config->auto_sleep);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get auto sleep failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_measure(&gs_handle, &config->measure);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get measure failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_sleep(&gs_handle, &config->sleep);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get sleep failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_sleep_frequency(&gs_handle, &config->sleep_frequency);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get sleep frequency failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < 8; i++)
+    {
+        res = adxl345_get_interrupt(&gs_handle, (adxl345_interrupt_t)i, &config->interrupt[i]);
+        if (res != 0)
+        {
+            adxl345_interface_debug_print("adxl345: get interrupt failed.\n");
+            (void)adxl345_deinit(&gs_handle);
+            
+            return 1;
+        }
+        res = adxl345_get_interrupt_map(&gs_handle, (adxl345_interrupt_t)i, &config->interrupt_map[i]);
+        if (res != 0)
+        {
+            adxl345_interface_debug_print("adxl345: get interrupt map failed.\n");
+            (void)adxl345_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    res = adxl345_get_self_test(&gs_handle, &config->self_test);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get self test failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_spi_wire(&gs_handle, &config->spi_wire);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get spi wire failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_interrupt_active_level(&gs_handle, &config->interrupt_active_level);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get interrupt active level failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_full_resolution(&gs_handle, &config->full_resolution);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get full resolution failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_justify(&gs_handle, &config->justify);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get justify failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_range(&gs_handle, &config->range);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get range failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_mode(&gs_handle, &config->mode);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get mode failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_trigger_pin(&gs_handle, &config->trigger_pin);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get trigger pin failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_watermark(&gs_handle, &config->watermark);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get watermark failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     register test
+ * @param[in] interface is the chip interface
+ * @param[in] addr_pin is the iic device address
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+uint8_t adxl345_register_test(adxl345_interface_t interface, adxl345_address_t addr_pin)
+{
+    uint8_t res, reg, check;
+    float f, f_check;
+    int8_t i_reg;
+    uint32_t us, us_check;
+    uint16_t ms, ms_check;
+    adxl345_info_t info;
+    adxl345_interface_t interface_test;
+    adxl345_address_t addr;
+    adxl345_bool_t bool_test;
+    adxl345_rate_t rate;
+    adxl345_range_t range;
+    adxl345_config_t config;
+    adxl345_config_snapshot_t snapshot;
+    adxl345_config_snapshot_t snapshot_check;
+    
+    /* link interface function */
+    DRIVER_ADXL345_LINK_INIT(&gs_handle, adxl345_handle_t);
+    DRIVER_ADXL345_LINK_IIC_INIT(&gs_handle, adxl345_interface_iic_init);
+    DRIVER_ADXL345_LINK_IIC_DEINIT(&gs_handle, adxl345_interface_iic_deinit);
+    DRIVER_ADXL345_LINK_IIC_READ(&gs_handle, adxl345_interface_iic_read);
+    DRIVER_ADXL345_LINK_IIC_WRITE(&gs_handle, adxl345_interface_iic_write);
+    DRIVER_ADXL345_LINK_SPI_INIT(&gs_handle, adxl345_interface_spi_init);
+    DRIVER_ADXL345_LINK_SPI_DEINIT(&gs_handle, adxl345_interface_spi_deinit);
+    DRIVER_ADXL345_LINK_SPI_READ(&gs_handle, adxl345_interface_spi_read);
+    DRIVER_ADXL345_LINK_SPI_WRITE(&gs_handle, adxl345_interface_spi_write);
+    DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, adxl345_interface_delay_ms);
+    DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, adxl345_interface_debug_print);
+    DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, adxl345_interface_receive_callback);
+    
+    /* get information */
+    res = adxl345_info(&info);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get info failed.\n");
+       
+        return 1;
+    }
+    else
+    {
+        /* print chip info */
+        adxl345_interface_debug_print("adxl345: chip is %s.\n", info.chip_name);
+        adxl345_interface_debug_print("adxl345: manufacturer is %s.\n", info.manufacturer_name);
+        adxl345_interface_debug_print("adxl345: interface is %s.\n", info.interface);
+        adxl345_interface_debug_print("adxl345: driver version is %d.%d.\n", info.driver_version/1000, (info.driver_version%1000)/100);
+        adxl345_interface_debug_print("adxl345: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        adxl345_interface_debug_print("adxl345: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        adxl345_interface_debug_print("adxl345: max current is %0.2fmA.\n", info.max_current_ma);
+        adxl345_interface_debug_print("adxl345: max temperature is %0.1fC.\n", info.temperature_max);
+        adxl345_interface_debug_print("adxl345: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start register test */
+    adxl345_interface_debug_print("adxl345: start register test.\n");
+    
+    /* adxl345_set_interface/adxl345_get_interface test */
+    adxl345_interface_debug_print("adxl345: adxl345_set_interface/adxl345_get_interface test.\n");
+    
+    /* set IIC interface */
+    res = adxl345_set_interface(&gs_handle, ADXL345_INTERFACE_IIC);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set interface failed.\n");
+       
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: set interface iic.\n");
+    res = adxl345_get_interface(&gs_handle, &interface_test);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get interface failed.\n");
+       
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: check interface %s.\n", interface_test==ADXL345_INTERFACE_IIC?"ok":"error");
+    
+    /* set SPI interface */
+    res = adxl345_set_interface(&gs_handle, ADXL345_INTERFACE_SPI);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set interface failed.\n");
+       
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: set interface spi.\n");
+    res = adxl345_get_interface(&gs_handle, &interface_test);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get interface failed.\n");
+       
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: check interface %s.\n", interface_test==ADXL345_INTERFACE_SPI?"ok":"error");
+    
+    /* adxl345_set_addr_pin/adxl345_get_addr_pin test */
+    adxl345_interface_debug_print("adxl345: adxl345_set_addr_pin/adxl345_get_addr_pin test.\n");
+    
+    /* ALT0 */
+    res = adxl345_set_addr_pin(&gs_handle, ADXL345_ADDRESS_ALT_0);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set addr pin failed.\n");
+       
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: set addr pin alt0.\n");
+    res = adxl345_get_addr_pin(&gs_handle, &addr);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get addr pin failed.\n");
+       
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: check addr pin %s.\n", addr==ADXL345_ADDRESS_ALT_0?"ok":"error");
+    
+    /* ALT1 */
+    res = adxl345_set_addr_pin(&gs_handle, ADXL345_ADDRESS_ALT_1);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set addr pin failed.\n");
+       
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: set addr pin alt1.\n");
+    res = adxl345_get_addr_pin(&gs_handle, &addr);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get addr pin failed.\n");
+       
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: check addr pin %s.\n", addr==ADXL345_ADDRESS_ALT_1?"ok":"error");
+    
+    /* set the interface */
+    res = adxl345_set_interface(&gs_handle, interface);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set interface failed.\n");
+       
+        return 1;
+    }
+    
+    /* set the address pin */
+    res = adxl345_set_addr_pin(&gs_handle, addr_pin);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set addr pin failed.\n");
+       
+        return 1;
+    }
+    
+    /* init the adxl345 */
+    res = adxl345_init(&gs_handle);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* run the setter and getter round trips without the register cache */
+    res = a_adxl345_register_round_trip();
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* adxl345_set_register_cache/adxl345_get_register_cache test */
+    adxl345_interface_debug_print("adxl345: adxl345_set_register_cache/adxl345_get_register_cache test.\n");
+    res = adxl345_set_register_cache(&gs_handle, ADXL345_BOOL_TRUE);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set register cache failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: enable register cache.\n");
+    res = adxl345_get_register_cache(&gs_handle, &bool_test);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get register cache failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: check register cache %s.\n", bool_test==ADXL345_BOOL_TRUE?"ok":"error");
+    
+    /* run the setter and getter round trips again through the register cache */
+    res = a_adxl345_register_round_trip();
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* check the cached getters against a read back with the cache disabled */
+    memset(&snapshot, 0, sizeof(adxl345_config_snapshot_t));
+    memset(&snapshot_check, 0, sizeof(adxl345_config_snapshot_t));
+    res = a_adxl345_register_getter_config(&snapshot.config);
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = adxl345_set_register_cache(&gs_handle, ADXL345_BOOL_FALSE);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set register cache failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: disable register cache.\n");
+    res = a_adxl345_register_getter_config(&snapshot_check.config);
+    if (res != 0)
+    {
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: check register cache read back %s.\n",
+                                  memcmp(&snapshot.config, &snapshot_check.config, sizeof(adxl345_config_t))==0?"ok":"error");
+    
+    /* adxl345_config_snapshot/adxl345_apply_config/adxl345_config_restore test */
+    adxl345_interface_debug_print("adxl345: adxl345_config_snapshot/adxl345_apply_config/adxl345_config_restore test.\n");
+    memset(&snapshot, 0, sizeof(adxl345_config_snapshot_t));
+    memset(&snapshot_check, 0, sizeof(adxl345_config_snapshot_t));
+    res = adxl345_config_snapshot(&gs_handle, &snapshot);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: config snapshot failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: config snapshot.\n");
+    config = snapshot.config;
+    config.tap_threshold = (uint8_t)(snapshot.config.tap_threshold ^ 0x5A);
+    config.rate = (snapshot.config.rate == ADXL345_RATE_100) ? ADXL345_RATE_200 : ADXL345_RATE_100;
+    config.range = (snapshot.config.range == ADXL345_RANGE_2G) ? ADXL345_RANGE_16G : ADXL345_RANGE_2G;
+    config.watermark = (uint8_t)((snapshot.config.watermark + 7) % 32);
+    res = adxl345_apply_config(&gs_handle, &config);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: apply config failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: apply config.\n");
+    res = adxl345_get_tap_threshold(&gs_handle, (uint8_t *)&check);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get tap threshold failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_rate(&gs_handle, &rate);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get rate failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_range(&gs_handle, &range);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get range failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = adxl345_get_watermark(&gs_handle, (uint8_t *)&reg);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get watermark failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: check apply config %s.\n", ((check == config.tap_threshold) && (rate == config.rate) &&
+                                  (range == config.range) && (reg == config.watermark))?"ok":"error");
+    res = adxl345_config_restore(&gs_handle, &snapshot);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: config restore failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: config restore.\n");
+    res = adxl345_config_snapshot(&gs_handle, &snapshot_check);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: config snapshot failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    adxl345_interface_debug_print("adxl345: check config restore %s.\n",
+                                  memcmp(&snapshot.config, &snapshot_check.config, sizeof(adxl345_config_t))==0?"ok":"error");
+    
     /* adxl345_tap_threshold_convert_to_register/adxl345_tap_threshold_convert_to_data test */
     adxl345_interface_debug_print("adxl345: adxl345_tap_threshold_convert_to_register/adxl345_tap_threshold_convert_to_data test.\n");
     f = (rand()%800)/100.0f;